@@ -11,39 +11,20 @@ namespace Aux
  */
 int countEqClasses(int n, set<int>& st, set<pair<int, int>>& rel)
 {
-  vector<int> cl(n);
-  set<pair<int, int>> relprime;
-  for(unsigned i = 0; i < cl.size(); i++)
-  {
-    cl[i] = i;
-  }
+  return countEqClasses(BitRelation(rel, n), st);
+}
 
-  for(auto& t : rel)
-  {
-    if(st.find(t.first) != st.end() && st.find(t.second) != st.end())
-      relprime.insert(t);
-  }
 
-  for(const auto& t : relprime)
-  {
-    if(relprime.find({t.second, t.first}) != relprime.end())
-    {
-      int fnd = cl[t.second];
-      int rpl = cl[t.first];
-      for(unsigned i = 0; i < cl.size(); i++)
-      {
-        if(cl[i] == fnd)
-          cl[i] = rpl;
-      }
-    }
-  }
-
-  set<int> ret;
-  for(auto s : st)
-  {
-    ret.insert(cl[s]);
-  }
-  return ret.size();
+/*
+ * Count equivalence classes in the maximal equivalence fragment of a given
+ * relation restricted to a set of states.
+ * @param rel Relation (bit matrix)
+ * @param st Set of states
+ * @return Number of classes
+ */
+int countEqClasses(const BitRelation& rel, const set<int>& st)
+{
+  return rel.getEqClasses(DenseSet(st)).size();
 }
 
 
@@ -9,11 +9,14 @@
 #include <algorithm>
 #include <cassert>
 
+#include "BitRelation.h"
+
 using namespace std;
 
 namespace Aux
 {
   int countEqClasses(int n, set<int>& st, set<pair<int, int>>& rel);
+  int countEqClasses(const BitRelation& rel, const set<int>& st);
   vector< vector<int> > getAllSubsets(vector<int> set);
   vector< vector<int> > getAllSubsets(vector<int> set, unsigned max);
   string printVector(vector<int> st);
@@ -110,7 +113,7 @@ namespace Aux
 
 
   template<typename K>
-  int maxValue(map<K, int>& mp)
+  int maxValue(const map<K, int>& mp)
   {
     assert(mp.size() > 0);
 
@@ -137,40 +140,41 @@ namespace Aux
   }
 
 
+  /*
+   * Equivalence classes of the maximal equivalence fragment of a relation
+   * (the relation is restricted to univ and stored as a bit matrix over
+   * positions of the states in univ)
+   * @param rel Relation
+   * @param univ Set of states
+   * @return Set of equivalence classes
+   */
   template<typename State>
   set<set<State>> getEqClasses(set<pair<State,State>>& rel, set<State>& univ)
   {
-    map<State, int> clId;
-    map<State, int*> cl;
-    int i = 0;
-    for(const State& st : univ)
+    vector<State> sts(univ.begin(), univ.end());
+    map<State, int> pos;
+    for(unsigned i = 0; i < sts.size(); i++)
+      pos[sts[i]] = i;
+    BitRelation brel(sts.size());
+    for(const auto& pr : rel)
     {
-      clId[st] = i++;
-      cl[st] = &(clId[st]);
+      auto it1 = pos.find(pr.first);
+      auto it2 = pos.find(pr.second);
+      if(it1 != pos.end() && it2 != pos.end())
+        brel.add(it1->second, it2->second);
     }
 
-    set<pair<State,State>> inv = Aux::inverseRelation(rel);
-    set<pair<State,State>> intersect;
-    set_intersection(inv.begin(), inv.end(), rel.begin(), rel.end(),
-      std::inserter(intersect, intersect.begin()));
-    for(const auto& pr : intersect)
-    {
-      cl[pr.first] = cl[pr.second];
-      clId[pr.second] = clId[pr.first];
-    }
-
-    vector<set<State>> vc(univ.size());
+    DenseSet all;
+    for(unsigned i = 0; i < sts.size(); i++)
+      all.insert(i);
     set<set<State>> ret;
-    for(const auto& c : cl)
-    {
-      vc[*(c.second)].insert(c.first);
-    }
-    for(const set<State>& sts : vc)
+    for(const DenseSet& cls : brel.getEqClasses(all))
     {
-      if(sts.size() > 0)
-        ret.insert(sts);
+      set<State> stcl;
+      for(int i : cls)
+        stcl.insert(sts[i]);
+      ret.insert(stcl);
     }
-
     return ret;
   }
 
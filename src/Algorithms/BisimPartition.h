@@ -0,0 +1,250 @@
+#ifndef _BISIM_PARTITION_H_
+#define _BISIM_PARTITION_H_
+
+#include <vector>
+#include <map>
+#include <tuple>
+#include <algorithm>
+
+/*
+ * Coarsest bisimulation of a labelled transition system with vertices
+ * 0..n-1 refining an initial partition (the Paige-Tarjan algorithm). Blocks
+ * of the partition are grouped into compound blocks and the partition is kept
+ * stable with respect to each compound block (for each label, a block either
+ * has all or none of its vertices with a transition into the compound
+ * block). A compound block C with several blocks is split by its block B
+ * (the smaller of the first two), and blocks are split by transitions into B
+ * and into C without B. The latter are told apart by counters of transitions
+ * of each vertex and label into each compound block, hence only
+ * predecessors of B are visited. A vertex is in such B at most log(n) times,
+ * so the refinement takes O(m log n) steps (and sorting of the predecessors
+ * by labels).
+ */
+class BisimPartition
+{
+public:
+  struct Edge
+  {
+    int from;
+    int label;
+    int to;
+  };
+
+private:
+  std::vector<Edge> edges;
+  std::vector<std::vector<int>> inEdges;
+
+  // blocks; vertices marked for a split are moved to the end of the block
+  std::vector<int> block;
+  std::vector<int> pos;
+  std::vector<std::vector<int>> members;
+  std::vector<unsigned> marked;
+
+  // compound blocks and the worklist of those with more than one block
+  std::vector<int> compound;
+  std::vector<int> cpos;
+  std::vector<std::vector<int>> cblocks;
+  std::vector<bool> cqueued;
+  std::vector<int> cqueue;
+
+  // number of transitions of a vertex and label into a compound block,
+  // each edge points to its counter; newCnt maps counters to the counters
+  // replacing them in a refinement step (-1 if none)
+  std::vector<unsigned> cnt;
+  std::vector<int> edgeCnt;
+  std::vector<int> newCnt;
+
+  int newBlock(int c)
+  {
+    int b = this->members.size();
+    this->members.push_back({});
+    this->marked.push_back(0);
+    this->compound.push_back(c);
+    this->cpos.push_back(this->cblocks[c].size());
+    this->cblocks[c].push_back(b);
+    if(this->cblocks[c].size() > 1 && !this->cqueued[c])
+    {
+      this->cqueued[c] = true;
+      this->cqueue.push_back(c);
+    }
+    return b;
+  }
+
+  void moveToCompound(int b, int c)
+  {
+    std::vector<int>& old = this->cblocks[this->compound[b]];
+    int last = old.back();
+    old[this->cpos[b]] = last;
+    this->cpos[last] = this->cpos[b];
+    old.pop_back();
+    this->compound[b] = c;
+    this->cpos[b] = this->cblocks[c].size();
+    this->cblocks[c].push_back(b);
+  }
+
+  /*
+   * Split blocks into vertices in M and the rest
+   * @param M Distinct vertices
+   */
+  void split(const std::vector<int>& M)
+  {
+    std::vector<int> touched;
+    for(int v : M)
+    {
+      int b = this->block[v];
+      std::vector<int>& mem = this->members[b];
+      if(this->marked[b] == 0)
+        touched.push_back(b);
+      int last = mem.size() - 1 - this->marked[b];
+      int w = mem[last];
+      mem[last] = v;
+      mem[this->pos[v]] = w;
+      this->pos[w] = this->pos[v];
+      this->pos[v] = last;
+      this->marked[b]++;
+    }
+
+    for(int b : touched)
+    {
+      unsigned k = this->marked[b];
+      this->marked[b] = 0;
+      if(k == this->members[b].size())
+        continue;
+      int nb = newBlock(this->compound[b]);
+      std::vector<int>& mem = this->members[b];
+      for(unsigned i = mem.size() - k; i < mem.size(); i++)
+      {
+        int v = mem[i];
+        this->block[v] = nb;
+        this->pos[v] = this->members[nb].size();
+        this->members[nb].push_back(v);
+      }
+      mem.resize(mem.size() - k);
+    }
+  }
+
+  /*
+   * Split the compound block c by one of its blocks
+   */
+  void refine(int c)
+  {
+    int b1 = this->cblocks[c][0];
+    int b2 = this->cblocks[c][1];
+    int B = this->members[b1].size() <= this->members[b2].size() ? b1 : b2;
+    int nc = this->cblocks.size();
+    this->cblocks.push_back({});
+    this->cqueued.push_back(false);
+    moveToCompound(B, nc);
+
+    // counters of transitions into B; each old counter (a vertex, a label
+    // and the compound block c) gets a new one
+    std::vector<std::tuple<int, int, int, int>> recs;
+    std::vector<int> touchedEdges;
+    for(int v : this->members[B])
+    {
+      for(int e : this->inEdges[v])
+      {
+        int old = this->edgeCnt[e];
+        if(this->newCnt[old] == -1)
+        {
+          this->newCnt[old] = this->cnt.size();
+          this->cnt.push_back(0);
+          this->newCnt.push_back(-1);
+          recs.push_back({this->edges[e].label, this->edges[e].from, old, this->newCnt[old]});
+        }
+        this->cnt[this->newCnt[old]]++;
+        touchedEdges.push_back(e);
+      }
+    }
+
+    // for each label, split by transitions into B and then by transitions
+    // into B but not into the rest of c
+    std::sort(recs.begin(), recs.end());
+    for(unsigned i = 0; i < recs.size(); )
+    {
+      unsigned j = i;
+      std::vector<int> toB, onlyB;
+      for(; j < recs.size() && std::get<0>(recs[j]) == std::get<0>(recs[i]); j++)
+      {
+        int v = std::get<1>(recs[j]);
+        toB.push_back(v);
+        if(this->cnt[std::get<2>(recs[j])] == this->cnt[std::get<3>(recs[j])])
+          onlyB.push_back(v);
+      }
+      split(toB);
+      split(onlyB);
+      i = j;
+    }
+
+    for(int e : touchedEdges)
+      this->edgeCnt[e] = this->newCnt[this->edgeCnt[e]];
+    for(const auto& r : recs)
+    {
+      this->cnt[std::get<2>(r)] -= this->cnt[std::get<3>(r)];
+      this->newCnt[std::get<2>(r)] = -1;
+    }
+  }
+
+public:
+  /*
+   * @param n Number of vertices
+   * @param edges Labelled transitions (without duplicates)
+   * @param initial Initial classes of vertices
+   */
+  BisimPartition(unsigned n, const std::vector<Edge>& edges, const std::vector<int>& initial) :
+    edges(edges), inEdges(n), block(n), pos(n), members(), marked(), compound(), cpos(),
+    cblocks(), cqueued(), cqueue(), cnt(), edgeCnt(edges.size()), newCnt()
+  {
+    std::vector<std::vector<int>> labels(n);
+    std::map<std::pair<int, int>, int> counters;
+    for(unsigned e = 0; e < edges.size(); e++)
+    {
+      const Edge& ed = edges[e];
+      this->inEdges[ed.to].push_back(e);
+      auto ins = counters.insert({{ed.from, ed.label}, (int)this->cnt.size()});
+      if(ins.second)
+      {
+        this->cnt.push_back(0);
+        labels[ed.from].push_back(ed.label);
+      }
+      this->cnt[ins.first->second]++;
+      this->edgeCnt[e] = ins.first->second;
+    }
+    this->newCnt.assign(this->cnt.size(), -1);
+
+    // the initial partition is refined by the labels of outgoing transitions
+    // to be stable with respect to the compound block of all vertices
+    this->cblocks.push_back({});
+    this->cqueued.push_back(false);
+    std::map<std::pair<int, std::vector<int>>, int> initBlocks;
+    for(unsigned v = 0; v < n; v++)
+    {
+      std::sort(labels[v].begin(), labels[v].end());
+      auto it = initBlocks.find({initial[v], labels[v]});
+      if(it == initBlocks.end())
+        it = initBlocks.insert({{initial[v], labels[v]}, newBlock(0)}).first;
+      this->block[v] = it->second;
+      this->pos[v] = this->members[it->second].size();
+      this->members[it->second].push_back(v);
+    }
+
+    while(!this->cqueue.empty())
+    {
+      int c = this->cqueue.back();
+      if(this->cblocks[c].size() < 2)
+      {
+        this->cqueue.pop_back();
+        this->cqueued[c] = false;
+        continue;
+      }
+      refine(c);
+    }
+  }
+
+  /*
+   * Blocks of vertices (bisimilar vertices have the same block)
+   */
+  const std::vector<int>& getBlocks() const { return this->block; }
+};
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef BIT_RELATION_H_
+#define BIT_RELATION_H_
+
+#include <set>
+#include <vector>
+#include <utility>
+#include <cassert>
+
+#include "DenseSet.h"
+
+/*
+ * Binary relation over (small, nonnegative) integers 0..n-1 stored as a
+ * dense bit matrix. Both the rows (the i-th row contains all q s.t. (i, q)
+ * is in the relation) and the columns (the i-th column contains all p s.t.
+ * (p, i) is in the relation) are kept, hence the operations on the relation
+ * (inverse, intersection, transitive closure, closures of sets) are
+ * performed on whole words. For simulations, (p, q) means that p is
+ * simulated by q.
+ */
+class BitRelation
+{
+private:
+  int n;
+  std::vector<DenseSet> rows;
+  std::vector<DenseSet> cols;
+
+public:
+  BitRelation() : n(0), rows(), cols() { }
+  BitRelation(int n) : n(n), rows(n), cols(n) { }
+
+  /*
+   * Relation from a set of pairs
+   * @param rel Set of pairs (all items have to be less than n)
+   * @param n Size of the domain
+   */
+  BitRelation(const std::set<std::pair<int, int>>& rel, int n) : n(n), rows(n), cols(n)
+  {
+    for(const auto& pr : rel)
+      add(pr.first, pr.second);
+  }
+
+  int size() const { return this->n; }
+
+  void add(int p, int q)
+  {
+    assert(p >= 0 && p < this->n && q >= 0 && q < this->n);
+    this->rows[p].insert(q);
+    this->cols[q].insert(p);
+  }
+
+  bool contains(int p, int q) const
+  {
+    return p < this->n && this->rows[p].contains(q);
+  }
+
+  /*
+   * Get all q s.t. (p, q) is in the relation
+   */
+  const DenseSet& row(int p) const { return this->rows[p]; }
+
+  /*
+   * Get all p s.t. (p, q) is in the relation
+   */
+  const DenseSet& col(int q) const { return this->cols[q]; }
+
+  BitRelation inverse() const
+  {
+    BitRelation ret(*this);
+    ret.rows.swap(ret.cols);
+    return ret;
+  }
+
+  BitRelation& operator&=(const BitRelation& other)
+  {
+    assert(this->n == other.n);
+    for(int i = 0; i < this->n; i++)
+    {
+      this->rows[i] &= other.rows[i];
+      this->cols[i] &= other.cols[i];
+    }
+    return *this;
+  }
+
+  friend BitRelation operator&(BitRelation a, const BitRelation& b) { return a &= b; }
+
+  bool operator==(const BitRelation& other) const
+  {
+    return this->n == other.n && this->rows == other.rows;
+  }
+
+  /*
+   * Transitive closure of the relation (Warshall's algorithm, for each
+   * intermediate element the rows of its predecessors are joined with its
+   * row)
+   */
+  void transitiveClosure()
+  {
+    for(int k = 0; k < this->n; k++)
+    {
+      DenseSet pred = this->cols[k];
+      DenseSet succ = this->rows[k];
+      for(int i : pred)
+        this->rows[i] |= succ;
+      for(int j : succ)
+        this->cols[j] |= pred;
+    }
+  }
+
+  /*
+   * Upward closure of a set
+   * @param st Set of elements
+   * @return All q s.t. (p, q) is in the relation for some p from st
+   */
+  DenseSet upwardClosure(const DenseSet& st) const
+  {
+    DenseSet ret;
+    for(int p : st)
+    {
+      if(p < this->n)
+        ret |= this->rows[p];
+    }
+    return ret;
+  }
+
+  /*
+   * Downward closure of a set
+   * @param st Set of elements
+   * @return All p s.t. (p, q) is in the relation for some q from st
+   */
+  DenseSet downwardClosure(const DenseSet& st) const
+  {
+    DenseSet ret;
+    for(int q : st)
+    {
+      if(q < this->n)
+        ret |= this->cols[q];
+    }
+    return ret;
+  }
+
+  /*
+   * Remove elements related to another element of the set
+   * @param st Set of elements
+   * @return All p from st s.t. there is no q != p from st with (p, q) in
+   *         the relation
+   */
+  DenseSet removeSmaller(const DenseSet& st) const
+  {
+    DenseSet ret;
+    for(int p : st)
+    {
+      if(p >= this->n || !this->rows[p].intersects(st))
+      {
+        ret.insert(p);
+      }
+      else if(this->rows[p].contains(p))
+      {
+        DenseSet other = this->rows[p] & st;
+        other.erase(p);
+        if(other.empty())
+          ret.insert(p);
+      }
+    }
+    return ret;
+  }
+
+  /*
+   * Classes of the equivalence generated by the symmetric fragment of the
+   * relation restricted to a set (for preorders these are the classes of
+   * p <= q <= p)
+   * @param univ Set of elements
+   * @return Vector of classes (ordered by the least elements)
+   */
+  std::vector<DenseSet> getEqClasses(const DenseSet& univ) const
+  {
+    std::vector<DenseSet> ret;
+    DenseSet done;
+    for(int p : univ)
+    {
+      if(done.contains(p))
+        continue;
+      DenseSet cls = {p};
+      std::vector<int> stack = {p};
+      while(!stack.empty())
+      {
+        int act = stack.back();
+        stack.pop_back();
+        if(act >= this->n)
+          continue;
+        DenseSet nw = ((this->rows[act] & this->cols[act]) & univ) - cls;
+        for(int q : nw)
+          stack.push_back(q);
+        cls |= nw;
+      }
+      done |= cls;
+      ret.push_back(cls);
+    }
+    return ret;
+  }
+
+  std::set<std::pair<int, int>> toSet() const
+  {
+    std::set<std::pair<int, int>> ret;
+    for(int p = 0; p < this->n; p++)
+    {
+      for(int q : this->rows[p])
+        ret.insert({p, q});
+    }
+    return ret;
+  }
+};
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef _DATA_FLOW_H_
+#define _DATA_FLOW_H_
+
+#include <vector>
+#include <functional>
+
+#include "../Automata/AutGraph.h"
+
+/*
+ * Scheduler of a monotone data flow analysis over a graph with vertices
+ * 0..n-1. In the backward direction the label of a vertex depends on the
+ * labels of its successors, in the forward direction on the labels of its
+ * predecessors. The labels themselves are kept by the client, the scheduler
+ * only decides which vertex is updated next. SCCs are processed in a
+ * topological order of the dependencies (an SCC is processed after all SCCs
+ * it depends on are stable), inside an SCC a worklist keeps the vertices
+ * whose dependencies changed (the label of a vertex itself is its
+ * dependency as well). Each vertex is hence updated once plus once per
+ * change of a label it depends on. The updates have to be monotone and
+ * move all labels in one direction: if they never increase labels (e.g.,
+ * taking a minimum), the result is the greatest fixpoint below the initial
+ * labels, if they never decrease labels (e.g., taking a maximum as in
+ * getMaxReachSizeInd), the result is the least fixpoint above the initial
+ * labels. In both cases it does not depend on the order of updates.
+ */
+class DataFlow
+{
+public:
+  enum Direction { FORWARD, BACKWARD };
+
+private:
+  Direction dir;
+  Condensation cond;
+  // labels of deps[v] are used to update v, users[v] have to be updated
+  // after a change of v
+  AdjList deps;
+  AdjList users;
+
+public:
+  /*
+   * @param succ Successors of vertices
+   * @param dir Direction of the analysis
+   */
+  DataFlow(const AdjList& succ, Direction dir) : dir(dir), cond(succ), deps(), users()
+  {
+    AdjList pred(succ.size());
+    for(unsigned v = 0; v < succ.size(); v++)
+    {
+      for(int s : succ[v])
+        pred[s].push_back(v);
+    }
+    if(dir == BACKWARD)
+    {
+      this->deps = succ;
+      this->users = pred;
+    }
+    else
+    {
+      this->deps = pred;
+      this->users = succ;
+    }
+  }
+
+  /*
+   * Vertices whose labels are used to update the label of v
+   */
+  const vector<int>& getDependencies(int v) const { return this->deps[v]; }
+
+  /*
+   * Compute the fixpoint
+   * @param upd Function updating the label of a vertex (returns true iff
+   *        the label changed)
+   */
+  void solve(const std::function<bool(int)>& upd) const
+  {
+    // successors of a component have smaller ids
+    int size = this->cond.size();
+    vector<bool> queued(this->deps.size(), false);
+    vector<int> worklist;
+    for(int i = 0; i < size; i++)
+    {
+      int c = (this->dir == BACKWARD) ? i : size - i - 1;
+      const vector<int>& vert = this->cond.getVertices(c);
+      // vertices are taken in the ascending order first
+      for(auto it = vert.rbegin(); it != vert.rend(); it++)
+      {
+        worklist.push_back(*it);
+        queued[*it] = true;
+      }
+      while(!worklist.empty())
+      {
+        int v = worklist.back();
+        worklist.pop_back();
+        queued[v] = false;
+        if(!upd(v))
+          continue;
+        // the update of v depends also on the label of v
+        queued[v] = true;
+        worklist.push_back(v);
+        for(int u : this->users[v])
+        {
+          if(!queued[u] && this->cond.getComponent(u) == c)
+          {
+            queued[u] = true;
+            worklist.push_back(u);
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef DENSE_SET_H_
+#define DENSE_SET_H_
+
+#include <set>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <functional>
+#include <initializer_list>
+
+/*
+ * Set of (small, nonnegative) integers stored as a dense bitset. It is used
+ * as a macrostate in complement constructions working on renamed automata
+ * (states numbered from 0 with no gaps). The interface mimics std::set<int>
+ * (ordered iteration, find, insert, lexicographic comparison), so a
+ * DenseSet can replace a set of states without changing the behaviour
+ * (including the order of generated states). Invariant: the vector of words
+ * does not contain trailing zero words.
+ */
+class DenseSet
+{
+public:
+  typedef uint64_t Word;
+  static const int WordBits = 64;
+
+private:
+  std::vector<Word> words;
+
+  static int wordIndex(int i) { return i / WordBits; }
+  static Word bitMask(int i) { return Word(1) << (i % WordBits); }
+
+  void shrink()
+  {
+    while(!words.empty() && words.back() == 0)
+      words.pop_back();
+  }
+
+public:
+  typedef int value_type;
+  typedef int key_type;
+  typedef std::size_t size_type;
+
+  /*
+   * Forward iterator over the elements (in ascending order)
+   */
+  class const_iterator
+  {
+  private:
+    const std::vector<Word>* words;
+    int pos;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef const int& reference;
+
+    const_iterator() : words(nullptr), pos(-1) {}
+    const_iterator(const std::vector<Word>* w, int p) : words(w), pos(p) {}
+
+    int operator*() const { return pos; }
+    bool operator==(const const_iterator& other) const { return pos == other.pos; }
+    bool operator!=(const const_iterator& other) const { return pos != other.pos; }
+
+    const_iterator& operator++()
+    {
+      pos = DenseSet::nextBit(*words, pos + 1);
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+  };
+  typedef const_iterator iterator;
+
+  /*
+   * Get the first element greater or equal to from (-1 if there is none)
+   * @param w Words of the bitset
+   * @param from Starting position
+   * @return Position of the next set bit
+   */
+  static int nextBit(const std::vector<Word>& w, int from)
+  {
+    int wi = wordIndex(from);
+    if(wi >= (int)w.size())
+      return -1;
+    Word act = w[wi] & (~Word(0) << (from % WordBits));
+    while(act == 0)
+    {
+      if(++wi >= (int)w.size())
+        return -1;
+      act = w[wi];
+    }
+    return wi * WordBits + __builtin_ctzll(act);
+  }
+
+  DenseSet() : words() {}
+  DenseSet(const std::set<int>& st) : words()
+  {
+    insert(st.begin(), st.end());
+  }
+  DenseSet(std::initializer_list<int> lst) : words()
+  {
+    insert(lst.begin(), lst.end());
+  }
+  template <typename InputIt>
+  DenseSet(InputIt first, InputIt last) : words()
+  {
+    insert(first, last);
+  }
+
+  /*
+   * Conversion to std::set (for the code working with sets of states)
+   */
+  operator std::set<int>() const
+  {
+    return toSet();
+  }
+
+  std::set<int> toSet() const
+  {
+    std::set<int> ret;
+    for(int i : *this)
+      ret.insert(ret.end(), i);
+    return ret;
+  }
+
+  const_iterator begin() const { return const_iterator(&words, nextBit(words, 0)); }
+  const_iterator end() const { return const_iterator(&words, -1); }
+
+  bool empty() const { return words.empty(); }
+  void clear() { words.clear(); }
+
+  size_type size() const
+  {
+    size_type ret = 0;
+    for(Word w : words)
+      ret += __builtin_popcountll(w);
+    return ret;
+  }
+
+  bool contains(int i) const
+  {
+    int wi = wordIndex(i);
+    return i >= 0 && wi < (int)words.size() && (words[wi] & bitMask(i)) != 0;
+  }
+
+  size_type count(int i) const { return contains(i) ? 1 : 0; }
+
+  const_iterator find(int i) const
+  {
+    return contains(i) ? const_iterator(&words, i) : end();
+  }
+
+  std::pair<const_iterator, bool> insert(int i)
+  {
+    assert(i >= 0);
+    int wi = wordIndex(i);
+    if(wi >= (int)words.size())
+      words.resize(wi + 1, 0);
+    bool nw = (words[wi] & bitMask(i)) == 0;
+    words[wi] |= bitMask(i);
+    return {const_iterator(&words, i), nw};
+  }
+
+  /*
+   * Insert with a hint (for std::inserter compatibility, hint is ignored)
+   */
+  const_iterator insert(const_iterator, int i)
+  {
+    return insert(i).first;
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+  {
+    for(; first != last; ++first)
+      insert(*first);
+  }
+
+  size_type erase(int i)
+  {
+    if(!contains(i))
+      return 0;
+    words[wordIndex(i)] &= ~bitMask(i);
+    shrink();
+    return 1;
+  }
+
+  /*
+   * Union (in place)
+   */
+  DenseSet& operator|=(const DenseSet& other)
+  {
+    if(other.words.size() > words.size())
+      words.resize(other.words.size(), 0);
+    for(unsigned i = 0; i < other.words.size(); i++)
+      words[i] |= other.words[i];
+    return *this;
+  }
+
+  /*
+   * Intersection (in place)
+   */
+  DenseSet& operator&=(const DenseSet& other)
+  {
+    if(words.size() > other.words.size())
+      words.resize(other.words.size());
+    for(unsigned i = 0; i < words.size(); i++)
+      words[i] &= other.words[i];
+    shrink();
+    return *this;
+  }
+
+  /*
+   * Set difference (in place)
+   */
+  DenseSet& operator-=(const DenseSet& other)
+  {
+    unsigned m = std::min(words.size(), other.words.size());
+    for(unsigned i = 0; i < m; i++)
+      words[i] &= ~other.words[i];
+    shrink();
+    return *this;
+  }
+
+  friend DenseSet operator|(DenseSet a, const DenseSet& b) { return a |= b; }
+  friend DenseSet operator&(DenseSet a, const DenseSet& b) { return a &= b; }
+  friend DenseSet operator-(DenseSet a, const DenseSet& b) { return a -= b; }
+
+  /*
+   * Do the sets have a common element?
+   */
+  bool intersects(const DenseSet& other) const
+  {
+    unsigned m = std::min(words.size(), other.words.size());
+    for(unsigned i = 0; i < m; i++)
+    {
+      if(words[i] & other.words[i])
+        return true;
+    }
+    return false;
+  }
+
+  /*
+   * Is this set a subset of other?
+   */
+  bool isSubsetOf(const DenseSet& other) const
+  {
+    if(words.size() > other.words.size())
+      return false;
+    for(unsigned i = 0; i < words.size(); i++)
+    {
+      if(words[i] & ~other.words[i])
+        return false;
+    }
+    return true;
+  }
+
+  bool operator==(const DenseSet& other) const { return words == other.words; }
+  bool operator!=(const DenseSet& other) const { return words != other.words; }
+
+  /*
+   * Lexicographic comparison of the (ascending) sequences of elements, i.e.,
+   * the same order as for std::set<int>. Let x be the least element of the
+   * symmetric difference. If x is in this set, this set is smaller iff other
+   * contains an element greater than x. Otherwise, this set is smaller iff
+   * it contains no element greater than x.
+   */
+  bool operator<(const DenseSet& other) const
+  {
+    unsigned m = std::min(words.size(), other.words.size());
+    unsigned i = 0;
+    while(i < m && words[i] == other.words[i])
+      i++;
+    if(i == words.size() && i == other.words.size())
+      return false;
+
+    Word a = i < words.size() ? words[i] : 0;
+    Word b = i < other.words.size() ? other.words[i] : 0;
+    Word diff = a ^ b;
+    int bit = __builtin_ctzll(diff);
+    Word above = bit + 1 < WordBits ? (~Word(0) << (bit + 1)) : 0;
+    if(a & (Word(1) << bit))
+      return (b & above) != 0 || other.words.size() > i + 1;
+    else
+      return (a & above) == 0 && words.size() <= i + 1;
+  }
+
+  bool operator>(const DenseSet& other) const { return other < *this; }
+  bool operator<=(const DenseSet& other) const { return !(other < *this); }
+  bool operator>=(const DenseSet& other) const { return !(*this < other); }
+
+  /*
+   * Hash of the set
+   */
+  std::size_t hash() const
+  {
+    std::size_t h = 0xcbf29ce484222325ULL;
+    for(Word w : words)
+    {
+      h ^= w + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+
+  /*
+   * Number of bytes allocated by the set (approximately)
+   */
+  std::size_t memoryUsage() const
+  {
+    return sizeof(DenseSet) + words.capacity() * sizeof(Word);
+  }
+
+  std::string toString() const
+  {
+    std::string ret;
+    for (int s : *this)
+      ret += std::to_string(s) + " ";
+    if(ret.size() > 0 && ret.back() == ' ')
+      ret.pop_back();
+    return "{" + ret + "}";
+  }
+};
+
+namespace std
+{
+  template <>
+  struct hash<DenseSet>
+  {
+    std::size_t operator()(const DenseSet& st) const
+    {
+      return st.hash();
+    }
+  };
+}
+
+#endif
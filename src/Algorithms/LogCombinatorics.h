@@ -0,0 +1,107 @@
+#ifndef _LOG_COMBINATORICS_H_
+#define _LOG_COMBINATORICS_H_
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/*
+ * Natural logarithms of factorials, binomial coefficients and Stirling
+ * numbers of the second kind. The values are kept in tables extended on
+ * demand; Stirling numbers are computed by the recurrence
+ * S(n,k) = k*S(n-1,k) + S(n-1,k-1) in the log space, hence the results do
+ * not overflow for large arguments. The logarithm of zero is -infinity.
+ */
+class LogCombinatorics
+{
+private:
+  std::vector<double> logFact;
+  // logStirling[n][k] for k = 0..n
+  std::vector<std::vector<double>> logStirling;
+
+  void extendFactorials(unsigned n)
+  {
+    if(this->logFact.empty())
+      this->logFact.push_back(0.0);
+    while(this->logFact.size() <= n)
+      this->logFact.push_back(this->logFact.back() + std::log((double)this->logFact.size()));
+  }
+
+  void extendStirling(unsigned n)
+  {
+    const double zero = -std::numeric_limits<double>::infinity();
+    if(this->logStirling.empty())
+      this->logStirling.push_back({0.0});
+    while(this->logStirling.size() <= n)
+    {
+      unsigned m = this->logStirling.size();
+      const std::vector<double>& prev = this->logStirling.back();
+      std::vector<double> row(m + 1, zero);
+      for(unsigned k = 1; k <= m; k++)
+      {
+        double a = (k < m) ? std::log((double)k) + prev[k] : zero;
+        row[k] = logSum(a, prev[k-1]);
+      }
+      this->logStirling.push_back(row);
+    }
+  }
+
+public:
+  LogCombinatorics() : logFact(), logStirling() { }
+
+  /*
+   * log(exp(a) + exp(b))
+   */
+  static double logSum(double a, double b)
+  {
+    if(a < b)
+      std::swap(a, b);
+    if(std::isinf(b))
+      return a;
+    return a + std::log1p(std::exp(b - a));
+  }
+
+  /*
+   * log(n!)
+   */
+  double factorial(unsigned n)
+  {
+    extendFactorials(n);
+    return this->logFact[n];
+  }
+
+  /*
+   * log(n choose k)
+   */
+  double binomial(unsigned n, unsigned k)
+  {
+    if(k > n)
+      return -std::numeric_limits<double>::infinity();
+    extendFactorials(n);
+    return this->logFact[n] - this->logFact[k] - this->logFact[n-k];
+  }
+
+  /*
+   * log S(n,k) (the number of partitions of an n-element set into k
+   * nonempty blocks)
+   */
+  double stirling2(unsigned n, unsigned k)
+  {
+    if(k > n)
+      return -std::numeric_limits<double>::infinity();
+    extendStirling(n);
+    return this->logStirling[n][k];
+  }
+
+  /*
+   * log of the number of surjections from an n-element set onto a
+   * k-element set (k! * S(n,k))
+   */
+  double surjections(unsigned n, unsigned k)
+  {
+    return factorial(k) + stirling2(n, k);
+  }
+};
+
+#endif
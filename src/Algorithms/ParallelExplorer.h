@@ -0,0 +1,193 @@
+#ifndef _PARALLEL_EXPLORER_H_
+#define _PARALLEL_EXPLORER_H_
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <memory>
+#include <optional>
+#include <exception>
+#include <algorithm>
+
+/*
+ * Parallel exploration of a state space. Each worker thread owns a deque of
+ * items: it takes items from the back of its own deque and, if it is empty,
+ * steals items from the front of deques of other workers. Items discovered
+ * during processing of an item are collected in a thread-local buffer and
+ * pushed to the deque of the worker. Workers without items wait on a
+ * condition variable until new items are pushed or the exploration ends.
+ * Deduplication of items (the visited set) is up to the processing
+ * function.
+ */
+template <typename Item>
+class ParallelExplorer
+{
+private:
+  struct Worker
+  {
+    std::deque<Item> items;
+    std::mutex lock;
+
+    Worker() : items(), lock() { }
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  // number of items stored in the deques or being processed
+  std::atomic<size_t> pending;
+  // number of items stored in the deques
+  std::atomic<size_t> queued;
+  std::atomic<bool> failed;
+  std::exception_ptr error;
+  std::mutex errorLock;
+  // idle workers wait for new items or for the end of the exploration
+  std::atomic<unsigned> sleeping;
+  std::mutex idleLock;
+  std::condition_variable idle;
+
+  /*
+   * Wake up idle workers (after new items are pushed or the exploration
+   * ends)
+   */
+  void wake()
+  {
+    if(this->sleeping == 0)
+      return;
+    std::lock_guard<std::mutex> guard(this->idleLock);
+    this->idle.notify_all();
+  }
+
+  /*
+   * Wait until there are items in the deques or the exploration ends
+   */
+  void wait()
+  {
+    std::unique_lock<std::mutex> guard(this->idleLock);
+    this->sleeping++;
+    this->idle.wait(guard, [this]() {
+      return this->queued > 0 || this->pending == 0 || this->failed;
+    });
+    this->sleeping--;
+  }
+
+  bool pop(unsigned id, std::optional<Item>& item)
+  {
+    Worker& own = *this->workers[id];
+    {
+      std::lock_guard<std::mutex> guard(own.lock);
+      if(!own.items.empty())
+      {
+        item.emplace(std::move(own.items.back()));
+        own.items.pop_back();
+        this->queued--;
+        return true;
+      }
+    }
+    for(unsigned i = 1; i < this->workers.size(); i++)
+    {
+      Worker& victim = *this->workers[(id + i) % this->workers.size()];
+      std::lock_guard<std::mutex> guard(victim.lock);
+      if(!victim.items.empty())
+      {
+        item.emplace(std::move(victim.items.front()));
+        victim.items.pop_front();
+        this->queued--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Process>
+  void work(unsigned id, Process& proc)
+  {
+    std::vector<Item> buffer;
+    // items need not be default constructible
+    std::optional<Item> item;
+    while(!this->failed)
+    {
+      if(!pop(id, item))
+      {
+        if(this->pending == 0)
+          return;
+        wait();
+        continue;
+      }
+
+      buffer.clear();
+      try
+      {
+        proc(id, *item, buffer);
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> guard(this->errorLock);
+        if(!this->error)
+          this->error = std::current_exception();
+        this->failed = true;
+        wake();
+        return;
+      }
+
+      if(!buffer.empty())
+      {
+        this->pending += buffer.size();
+        {
+          Worker& own = *this->workers[id];
+          std::lock_guard<std::mutex> guard(own.lock);
+          for(Item& it : buffer)
+            own.items.push_back(std::move(it));
+          this->queued += buffer.size();
+        }
+        wake();
+      }
+      if(--this->pending == 0)
+        wake();
+    }
+  }
+
+public:
+  ParallelExplorer(unsigned threads) : workers(), pending(0), queued(0),
+    failed(false), error(), errorLock(), sleeping(0), idleLock(), idle()
+  {
+    for(unsigned i = 0; i < std::max(threads, 1U); i++)
+      this->workers.push_back(std::unique_ptr<Worker>(new Worker()));
+  }
+
+  unsigned getThreadCount() const { return this->workers.size(); }
+
+  /*
+   * Add an initial item (items are distributed among workers round-robin)
+   * @param item Item to be explored
+   */
+  void push(const Item& item)
+  {
+    Worker& w = *this->workers[this->pending % this->workers.size()];
+    w.items.push_back(item);
+    this->pending++;
+    this->queued++;
+  }
+
+  /*
+   * Explore all items reachable from the initial ones. Exceptions thrown
+   * by the processing function are rethrown in the calling thread.
+   * @param proc Function proc(worker id, item, buffer of new items)
+   */
+  template <typename Process>
+  void run(Process proc)
+  {
+    std::vector<std::thread> threads;
+    for(unsigned i = 1; i < this->workers.size(); i++)
+      threads.emplace_back([this, i, &proc]() { this->work(i, proc); });
+    this->work(0, proc);
+    for(std::thread& t : threads)
+      t.join();
+
+    if(this->error)
+      std::rethrow_exception(this->error);
+  }
+};
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef RANK_SIMULATION_H_
+#define RANK_SIMULATION_H_
+
+#include <vector>
+#include <utility>
+
+#include "DenseSet.h"
+#include "BitRelation.h"
+
+/*
+ * Odd rank simulation over states 0..n-1 and symbols 0..m-1. The odd rank
+ * simulation wrt a closure cl is the least relation containing the direct
+ * simulation s.t. (p, q) is in the relation for nonaccepting p, q if for
+ * each symbol all nonaccepting successors of p are related with all
+ * nonaccepting successors of q, and which is transitive on cl. It is
+ * computed by a worklist algorithm on a bit matrix: a newly derived pair
+ * (a, b) causes only rechecks of pairs of predecessors of a and b over the
+ * same symbol, and the transitivity on cl is kept incrementally. The
+ * relation for the empty closure is computed once (by init), relations for
+ * other closures are derived from it.
+ */
+class RankSimulation
+{
+private:
+  typedef std::vector<std::pair<int, int>> Worklist;
+
+  int n;
+  DenseSet nonacc;
+  // nonaccepting successors and nonaccepting predecessors of nonaccepting
+  // states over each symbol
+  std::vector<std::vector<DenseSet>> succ;
+  std::vector<std::vector<DenseSet>> pred;
+  BitRelation base;
+
+  /*
+   * Add a pair to the relation and keep the relation restricted to cl
+   * transitive (new pairs are added to the worklist)
+   */
+  static void addPair(BitRelation& rel, const DenseSet& cl, int p, int q, Worklist& worklist)
+  {
+    if(rel.contains(p, q))
+      return;
+    if(!cl.contains(p) || !cl.contains(q))
+    {
+      rel.add(p, q);
+      worklist.push_back({p, q});
+      return;
+    }
+    DenseSet from = (rel.col(p) & cl) | DenseSet({p});
+    DenseSet to = (rel.row(q) & cl) | DenseSet({q});
+    for(int x : from)
+    {
+      for(int y : to - rel.row(x))
+      {
+        rel.add(x, y);
+        worklist.push_back({x, y});
+      }
+    }
+  }
+
+  /*
+   * Are all nonaccepting successors of p related with all nonaccepting
+   * successors of q (over each symbol)?
+   */
+  bool isRankLeq(const BitRelation& rel, int p, int q) const
+  {
+    for(unsigned s = 0; s < this->succ.size(); s++)
+    {
+      for(int a : this->succ[s][p])
+      {
+        if(!this->succ[s][q].isSubsetOf(rel.row(a)))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /*
+   * Derive pairs affected by the pairs from the worklist
+   */
+  void propagate(BitRelation& rel, const DenseSet& cl, Worklist& worklist) const
+  {
+    while(!worklist.empty())
+    {
+      std::pair<int, int> act = worklist.back();
+      worklist.pop_back();
+      for(unsigned s = 0; s < this->pred.size(); s++)
+      {
+        for(int p : this->pred[s][act.first])
+        {
+          for(int q : this->pred[s][act.second])
+          {
+            if(!rel.contains(p, q) && isRankLeq(rel, p, q))
+              addPair(rel, cl, p, q, worklist);
+          }
+        }
+      }
+    }
+  }
+
+public:
+  /*
+   * @param n Number of states
+   * @param symbols Number of symbols
+   * @param nonacc Nonaccepting states
+   */
+  RankSimulation(int n, int symbols, const DenseSet& nonacc) : n(n), nonacc(nonacc),
+    succ(symbols, std::vector<DenseSet>(n)), pred(symbols, std::vector<DenseSet>(n)),
+    base(n) { }
+
+  void addTransition(int src, int symbol, int dst)
+  {
+    if(!this->nonacc.contains(src) || !this->nonacc.contains(dst))
+      return;
+    this->succ[symbol][src].insert(dst);
+    this->pred[symbol][dst].insert(src);
+  }
+
+  void addDirectSim(int p, int q)
+  {
+    this->base.add(p, q);
+  }
+
+  /*
+   * Compute the odd rank simulation for the empty closure (has to be called
+   * after all transitions and pairs of the direct simulation are added)
+   */
+  void init()
+  {
+    BitRelation rel(this->n);
+    DenseSet cl;
+    Worklist worklist;
+    for(int p = 0; p < this->n; p++)
+    {
+      for(int q : this->base.row(p))
+        addPair(rel, cl, p, q, worklist);
+    }
+    for(int p : this->nonacc)
+    {
+      for(int q : this->nonacc)
+      {
+        if(!rel.contains(p, q) && isRankLeq(rel, p, q))
+          addPair(rel, cl, p, q, worklist);
+      }
+    }
+    propagate(rel, cl, worklist);
+    this->base = rel;
+  }
+
+  /*
+   * Compute the odd rank simulation wrt a closure (starting from the
+   * relation for the empty closure, which is contained in the result)
+   * @param cl Closure of states
+   * @return Odd rank simulation
+   */
+  BitRelation compute(const DenseSet& cl) const
+  {
+    if(cl.empty())
+      return this->base;
+
+    // pairs within cl are added again to make the relation on cl transitive
+    BitRelation rel(this->n);
+    for(int p = 0; p < this->n; p++)
+    {
+      for(int q : (cl.contains(p) ? this->base.row(p) - cl : this->base.row(p)))
+        rel.add(p, q);
+    }
+    Worklist worklist;
+    for(int p : cl)
+    {
+      if(p >= this->n)
+        continue;
+      for(int q : this->base.row(p) & cl)
+        addPair(rel, cl, p, q, worklist);
+    }
+    propagate(rel, cl, worklist);
+    return rel;
+  }
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef _REACHABILITY_H_
+#define _REACHABILITY_H_
+
+#include <set>
+#include <vector>
+
+#include "DenseSet.h"
+#include "../Automata/AutGraph.h"
+
+/*
+ * Reflexive and transitive reachability over a graph with vertices 0..n-1.
+ * The closure is computed over the condensation of the graph: all vertices
+ * of an SCC reach the same vertices, hence a single bit row is stored per
+ * SCC (the row of an SCC is the union of its vertices and the rows of its
+ * successors in the DAG). Queries on reachability of vertices and on
+ * disjointness of reachable sets are performed on whole words.
+ */
+class Reachability
+{
+private:
+  vector<int> compOf;
+  vector<DenseSet> rows;
+
+public:
+  Reachability() : compOf(), rows() { }
+
+  /*
+   * @param succ Successors of vertices
+   */
+  Reachability(const AdjList& succ) : compOf(succ.size()), rows()
+  {
+    Condensation cond(succ);
+    this->rows.resize(cond.size());
+    // successors of a component have smaller ids
+    for(unsigned c = 0; c < cond.size(); c++)
+    {
+      DenseSet& row = this->rows[c];
+      for(int v : cond.getVertices(c))
+      {
+        row.insert(v);
+        this->compOf[v] = c;
+      }
+      for(int d : cond.getSuccessors(c))
+        row |= this->rows[d];
+    }
+  }
+
+  /*
+   * Get all vertices reachable from p (including p)
+   */
+  const DenseSet& reachable(int p) const { return this->rows[this->compOf[p]]; }
+
+  /*
+   * Is q reachable from p?
+   */
+  bool isReachable(int p, int q) const { return reachable(p).contains(q); }
+
+  /*
+   * Is there a vertex reachable from both p and q?
+   */
+  bool reachCommon(int p, int q) const
+  {
+    return this->compOf[p] == this->compOf[q] || reachable(p).intersects(reachable(q));
+  }
+
+  /*
+   * Reachable vertices of all vertices as sets
+   */
+  vector<std::set<int>> toVector() const
+  {
+    vector<std::set<int>> ret;
+    for(int c : this->compOf)
+      ret.push_back(this->rows[c].toSet());
+    return ret;
+  }
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef _SCC_EXPLORER_H_
+#define _SCC_EXPLORER_H_
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+/*
+ * Depth-first exploration of a graph generated on the fly with the detection
+ * of SCCs as they are completed (an iterative version of the Tarjan's
+ * algorithm). Vertices are ids 0,1,... given by the client, successors of a
+ * vertex are requested once, when the vertex is visited, and they are kept
+ * only while the vertex is on the DFS stack. A completed SCC is dead if no
+ * accepting cycle is reachable from it (it is trivial or has no accepting
+ * vertex, and all SCCs reachable from it are dead). Dead SCCs are reported
+ * as soon as they are completed, hence the client may release them before
+ * the exploration ends. Several explorations (from different roots) may
+ * share the object, vertices visited before are not explored again.
+ */
+class SccExplorer
+{
+public:
+  typedef std::function<std::vector<int>(int)> SuccFunc;
+  typedef std::function<bool(int)> AccFunc;
+  typedef std::function<void(const std::vector<int>&)> DeadFunc;
+
+private:
+  // DFS stack item: vertex, its successors and the position of the next one
+  struct Frame
+  {
+    int v;
+    std::vector<int> succ;
+    unsigned next;
+    bool selfLoop;
+  };
+
+  int index;
+  std::vector<int> indices;
+  std::vector<int> lowLink;
+  std::vector<bool> onStack;
+  // completed vertices reaching an accepting cycle (for vertices on the
+  // stack: reaching a completed SCC with an accepting cycle)
+  std::vector<bool> live;
+  std::vector<bool> dead;
+
+  void visit(int v, const SuccFunc& succ, std::vector<int>& stack, std::vector<Frame>& dfs)
+  {
+    if((unsigned)v >= this->indices.size())
+    {
+      this->indices.resize(v + 1, -1);
+      this->lowLink.resize(v + 1, -1);
+      this->onStack.resize(v + 1, false);
+      this->live.resize(v + 1, false);
+      this->dead.resize(v + 1, false);
+    }
+    this->indices[v] = this->lowLink[v] = this->index++;
+    stack.push_back(v);
+    this->onStack[v] = true;
+    dfs.push_back({v, succ(v), 0, false});
+  }
+
+public:
+  SccExplorer() : index(0), indices(), lowLink(), onStack(), live(), dead() { }
+
+  bool isVisited(int v) const
+  {
+    return (unsigned)v < this->indices.size() && this->indices[v] != -1;
+  }
+
+  /*
+   * Is the vertex in a completed dead SCC
+   */
+  bool isDead(int v) const
+  {
+    return (unsigned)v < this->dead.size() && this->dead[v];
+  }
+
+  /*
+   * Explore vertices reachable from a root
+   * @param root Root vertex (nothing is done if it was visited before)
+   * @param succ Successors of a vertex (called once for each vertex)
+   * @param acc Is a vertex accepting (called when its SCC is completed)
+   * @param onDead Called with the vertices of each dead SCC
+   */
+  void explore(int root, const SuccFunc& succ, const AccFunc& acc, const DeadFunc& onDead)
+  {
+    if(isVisited(root))
+      return;
+
+    std::vector<int> stack;
+    std::vector<Frame> dfs;
+    visit(root, succ, stack, dfs);
+    while(!dfs.empty())
+    {
+      Frame& fr = dfs.back();
+      int v = fr.v;
+      if(fr.next < fr.succ.size())
+      {
+        int w = fr.succ[fr.next++];
+        if(w == v)
+          fr.selfLoop = true;
+        if(!isVisited(w))
+          visit(w, succ, stack, dfs);
+        else if(this->onStack[w])
+          this->lowLink[v] = std::min(this->lowLink[v], this->indices[w]);
+        else if(this->live[w])
+          this->live[v] = true;
+        continue;
+      }
+
+      if(this->lowLink[v] == this->indices[v])
+      {
+        std::vector<int> comp;
+        int w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          this->onStack[w] = false;
+          comp.push_back(w);
+        } while(v != w);
+
+        bool isLive = false;
+        bool trivial = comp.size() == 1 && !fr.selfLoop;
+        for(int u : comp)
+        {
+          if(this->live[u] || (!trivial && acc(u)))
+          {
+            isLive = true;
+            break;
+          }
+        }
+        for(int u : comp)
+        {
+          this->live[u] = isLive;
+          this->dead[u] = !isLive;
+        }
+        if(!isLive)
+          onDead(comp);
+      }
+      dfs.pop_back();
+      if(!dfs.empty())
+      {
+        int u = dfs.back().v;
+        this->lowLink[u] = std::min(this->lowLink[u], this->lowLink[v]);
+        if(!this->onStack[v] && this->live[v])
+          this->live[u] = true;
+      }
+    }
+  }
+};
+
+#endif
@@ -13,10 +13,13 @@
 #include <map>
 #include <set>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include "../Automata/BuchiAutomaton.h"
 #include "../Automata/GenBuchiAutomaton.h"
+#include "BisimPartition.h"
 
 using namespace std;
 
@@ -56,31 +59,97 @@ public:
   static string execCmdTO(string& cmd, int timeout = 1000);
   static string execCmd(string& cmd);
 
+  // default memory budget of the direct simulation (in bytes)
+  static const size_t DirSimMemory = size_t(1) << 30;
+
   /*
    * Compute direct simulation
    * @param ba Buchi automaton
    * @param sink Sink state
+   * @param memory Memory budget (the identity is returned if exceeded)
    * @return Direct simulation
    */
   template<typename State, typename Symbol>
-  Relation<State> directSimulation(BuchiAutomaton<State, Symbol>& ba, State sink)
+  Relation<State> directSimulation(BuchiAutomaton<State, Symbol>& ba, State sink, size_t memory = DirSimMemory)
   {
     BuchiAutomaton<State, Symbol> baTmp(ba);
     baTmp.complete(sink);
 
+    vector<State> states;
+    vector<bool> comp = computeDirectComplDense(baTmp, states, memory);
+    size_t n = states.size();
+    // too large for the budget, the identity is a (trivial) simulation
+    if(comp.size() < n*n)
+      return identity(ba);
+
     Relation<State> dir;
-    Relation<State> comp = computeDirectCompl(baTmp);
-    for(const State& s1 : baTmp.getStates())
+    for(size_t i = 0; i < n; i++)
     {
-      for(const State& s2 : baTmp.getStates())
+      if(states[i] == sink)
+        continue;
+      for(size_t j = 0; j < n; j++)
       {
-        if(comp.find({s1, s2}) == comp.end() && s1 != sink && s2 != sink)
-          dir.insert({s1, s2});
+        if(!comp[i*n + j] && states[j] != sink)
+          dir.insert(dir.end(), {states[i], states[j]});
       }
     }
     return dir;
   };
 
+  /*
+   * Compute classes of the coarsest forward bisimulation respecting accepting
+   * states and accepting transitions (bisimilar states simulate each other,
+   * the quotient hence preserves the language). Transitions are labelled by
+   * their symbols and acceptance, the partition is refined by BisimPartition.
+   * @param ba Buchi automaton
+   * @return Map assigning states their classes (numbered from 0 by the least
+   *         states)
+   */
+  template<typename State, typename Symbol>
+  map<State, int> bisimulationClasses(BuchiAutomaton<State, Symbol>& ba)
+  {
+    vector<State> states(ba.getStates().begin(), ba.getStates().end());
+    unsigned n = states.size();
+    map<State, int> pos;
+    for(unsigned i = 0; i < n; i++)
+      pos[states[i]] = i;
+    map<Symbol, int> symId;
+    for(const Symbol& sym : ba.getAlphabet())
+      symId.insert({sym, symId.size()});
+
+    set<tuple<int, int, int>> acc;
+    for(const auto& tr : ba.getFinTrans())
+      acc.insert({pos.at(tr.from), symId.at(tr.symbol), pos.at(tr.to)});
+
+    vector<BisimPartition::Edge> edges;
+    for(const auto& tr : ba.getTransitions())
+    {
+      int from = pos.at(tr.first.first);
+      int sym = symId.at(tr.first.second);
+      for(const State& dst : tr.second)
+      {
+        int to = pos.at(dst);
+        edges.push_back({from, 2*sym + (acc.count({from, sym, to}) > 0 ? 1 : 0), to});
+      }
+    }
+
+    // initial partition: nonaccepting and accepting states
+    vector<int> initial(n);
+    for(unsigned i = 0; i < n; i++)
+      initial[i] = ba.getFinals().count(states[i]) > 0 ? 1 : 0;
+
+    BisimPartition part(n, edges, initial);
+    const vector<int>& block = part.getBlocks();
+    map<State, int> ret;
+    map<int, int> clsId;
+    for(unsigned i = 0; i < n; i++)
+    {
+      auto it = clsId.insert({block[i], clsId.size()}).first;
+      ret[states[i]] = it->second;
+    }
+    return ret;
+  }
+
   template<typename State, typename Symbol>
   Relation<State> identity(BuchiAutomaton<State, Symbol>& ba)
   {
@@ -97,114 +166,196 @@ protected:
   /*
    * Compute complement of direct simulation
    * @param ba Buchi automaton
+   * @param memory Memory budget (the complement of the identity is returned
+   *        if exceeded)
    * @return Complement of direct simulation
    */
   template<typename State, typename Symbol>
-  Relation<State> computeDirectCompl(BuchiAutomaton<State, Symbol>& ba)
+  Relation<State> computeDirectCompl(BuchiAutomaton<State, Symbol>& ba, size_t memory = DirSimMemory)
   {
-    Delta<State, Symbol> revTr = ba.getReverseTransitions();
-    map<tuple<Symbol, State, State>, unsigned> counter;
-    map<tuple<Symbol, State, State>, unsigned> cntAccTrans;
-    VecTrans<State, Symbol> accTrans = ba.getFinTrans();
+    vector<State> states;
+    vector<bool> comp = computeDirectComplDense(ba, states, memory);
+    size_t n = states.size();
+    bool full = comp.size() == n*n;
 
-    for(const Symbol& sym : ba.getAlphabet())
+    Relation<State> ret;
+    for(size_t i = 0; i < n; i++)
     {
-      for(const State& s1 : ba.getStates())
+      for(size_t j = 0; j < n; j++)
       {
-        for(const State& s2 : ba.getStates())
-        {
-          counter[{sym, s1, s2}] = 0;
-          cntAccTrans[{sym, s1, s2}] = 0;
-        }
+        if(full ? comp[i*n + j] : i != j)
+          ret.insert(ret.end(), {states[i], states[j]});
       }
     }
+    return ret;
+  };
 
-    queue<pair<State, State>> proc;
-    Relation<State> ret;
+  /*
+   * Compute complement of direct simulation (Henzinger-Henzinger-Kopke
+   * style refinement). States and symbols are numbered, for each triple
+   * (a, p, k) where p has an a-predecessor and k an a-successor, a counter
+   * keeps the number of a-successors q of k such that q does not simulate p
+   * (and the same for accepting transitions). Once all a-successors of k are
+   * counted, k does not simulate a-predecessors of p.
+   * @param ba Buchi automaton
+   * @param states Out parameter: states in the order of numbering
+   * @param memory Memory budget of the counters and the matrix (in bytes)
+   * @return Bit matrix (row-major), (i,j) is set iff states[j] does not
+   *         simulate states[i]; empty if the budget is exceeded
+   */
+  template<typename State, typename Symbol>
+  vector<bool> computeDirectComplDense(BuchiAutomaton<State, Symbol>& ba, vector<State>& states, size_t memory)
+  {
+    // predecessor of a state over a symbol (is the transition accepting?)
+    struct Pred
+    {
+      unsigned state;
+      bool acc;
+    };
 
-    set<State> nofin;
-    set<State> fin = ba.getFinals();
-    auto trans = ba.getTransitions();
-    Delta<State, Symbol> accTransMap;
+    states.assign(ba.getStates().begin(), ba.getStates().end());
+    vector<Symbol> symbols(ba.getAlphabet().begin(), ba.getAlphabet().end());
+    size_t n = states.size();
+    size_t s = symbols.size();
+    map<State, unsigned> stateInd;
+    for(unsigned i = 0; i < n; i++)
+      stateInd[states[i]] = i;
+    map<Symbol, unsigned> symbolInd;
+    for(unsigned i = 0; i < s; i++)
+      symbolInd[symbols[i]] = i;
+
+    // accepting transitions (a, from, to); accCnt[a*n + k] is the number of
+    // accepting a-successors of k
+    set<tuple<unsigned, unsigned, State>> accSet;
+    vector<unsigned> accCnt(s*n, 0);
+    for(const auto& tr : ba.getFinTrans())
+    {
+      auto from = stateInd.find(tr.from);
+      auto sym = symbolInd.find(tr.symbol);
+      if(from == stateInd.end() || sym == symbolInd.end())
+        continue;
+      if(accSet.insert({sym->second, from->second, tr.to}).second)
+        accCnt[sym->second*n + from->second]++;
+    }
+    bool hasAcc = !accSet.empty();
 
-    for(const auto& tr : accTrans)
+    // succCnt[a*n + k] is the number of a-successors of k; pred[a*n + q]
+    // are a-predecessors of q; predSyms[q] are symbols with a-predecessors
+    // of q
+    vector<unsigned> succCnt(s*n, 0);
+    vector<vector<Pred>> pred(s*n);
+    vector<vector<unsigned>> predSyms(n);
+    for(const auto& tr : ba.getTransitions())
     {
-      if(accTransMap.find({tr.from, tr.symbol}) == accTransMap.end())
+      auto from = stateInd.find(tr.first.first);
+      auto sym = symbolInd.find(tr.first.second);
+      if(from == stateInd.end() || sym == symbolInd.end())
+        continue;
+      unsigned a = sym->second;
+      succCnt[a*n + from->second] = tr.second.size();
+      for(const State& d : tr.second)
       {
-        accTransMap[{tr.from, tr.symbol}] = set<State>();
+        auto to = stateInd.find(d);
+        if(to == stateInd.end())
+          continue;
+        bool acc = hasAcc && accSet.count({a, from->second, d}) > 0;
+        if(pred[a*n + to->second].empty())
+          predSyms[to->second].push_back(a);
+        pred[a*n + to->second].push_back({from->second, acc});
       }
-      accTransMap[{tr.from, tr.symbol}].insert(tr.to);
     }
 
-    std::set_difference(ba.getStates().begin(), ba.getStates().end(), fin.begin(),
-      fin.end(), std::inserter(nofin, nofin.begin()));
-    for(const State& f : fin)
+    // counters of (a, p, k) are stored in rows of (a, p) with an
+    // a-predecessor, a row has a column for each k with an a-successor
+    vector<size_t> row(s*n, 0);
+    vector<unsigned> column(s*n, 0);
+    size_t counters = 0;
+    for(size_t a = 0; a < s; a++)
     {
-      for(const State& nf : nofin)
+      unsigned cols = 0;
+      for(size_t k = 0; k < n; k++)
+      {
+        if(succCnt[a*n + k] > 0)
+          column[a*n + k] = cols++;
+      }
+      for(size_t p = 0; p < n; p++)
       {
-        ret.insert({f, nf});
-        proc.push({f, nf});
+        if(!pred[a*n + p].empty())
+        {
+          row[a*n + p] = counters;
+          counters += cols;
+        }
       }
     }
+    // the matrix, the counters and the worklist (a pair is added at most
+    // once)
+    size_t required = n*n/8 + n*n*sizeof(pair<unsigned, unsigned>) +
+      counters*sizeof(unsigned)*(hasAcc ? 2 : 1);
+    if(required > memory)
+      return vector<bool>();
+
+    vector<bool> ret(n*n, false);
+    vector<pair<unsigned, unsigned>> proc;
+    auto add = [&ret, &proc, n](size_t p, size_t q)
+    {
+      if(!ret[p*n + q])
+      {
+        ret[p*n + q] = true;
+        proc.push_back({(unsigned)p, (unsigned)q});
+      }
+    };
 
-    for(const Symbol& a : ba.getAlphabet())
+    set<State> fin = ba.getFinals();
+    vector<bool> isFin(n, false);
+    for(size_t i = 0; i < n; i++)
+      isFin[i] = fin.find(states[i]) != fin.end();
+    for(size_t f = 0; f < n; f++)
     {
-      for(const State& p : ba.getStates())
+      for(size_t nf = 0; nf < n && isFin[f]; nf++)
       {
-        for(const State& q : ba.getStates())
+        if(!isFin[nf])
+          add(f, nf);
+      }
+    }
+    for(size_t a = 0; a < s && hasAcc; a++)
+    {
+      for(size_t p = 0; p < n; p++)
+      {
+        for(size_t q = 0; q < n && accCnt[a*n + p] > 0; q++)
         {
-          if(accTransMap[{p, a}].size() > 0 && accTransMap[{q, a}].size() == 0)
-          {
-            if(ret.find({p,q}) == ret.end())
-            {
-              ret.insert({p,q});
-              proc.push({p,q});
-            }
-          }
+          if(accCnt[a*n + q] == 0)
+            add(p, q);
         }
       }
     }
 
+    vector<unsigned> counter(counters, 0);
+    vector<unsigned> cntAccTrans(hasAcc ? counters : 0, 0);
     while(proc.size() > 0)
     {
-      auto item = proc.front();
-      proc.pop();
-      for(const Symbol& a : ba.getAlphabet())
+      auto item = proc.back();
+      proc.pop_back();
+      for(unsigned a : predSyms[item.second])
       {
-        for(const State& k : revTr[{item.second, a}])
+        const vector<Pred>& predFirst = pred[a*n + item.first];
+        if(predFirst.empty())
+          continue;
+        size_t base = row[a*n + item.first];
+        for(const Pred& k : pred[a*n + item.second])
         {
-          counter[{a, item.first, k}] += 1;
-
-          Transition<State,Symbol> tr = {.from = k, .to = item.second, .symbol = a};
-          if(std::find(accTrans.begin(), accTrans.end(), tr) != accTrans.end())
+          size_t ind = base + column[a*n + k.state];
+          if(k.acc && ++cntAccTrans[ind] == accCnt[a*n + k.state])
           {
-            cntAccTrans[{a, item.first, k}] += 1;
-          }
-
-          if(cntAccTrans[{a, item.first, k}] == accTransMap[{k, a}].size())
-          {
-
-            for(const State& m : revTr[{item.first, a}])
+            for(const Pred& m : predFirst)
             {
-              Transition<State,Symbol> tr = {.from = m, .to = item.first, .symbol = a};
-              if(ret.find({m,k}) == ret.end() && std::find(accTrans.begin(), accTrans.end(), tr) != accTrans.end())
-              {
-                ret.insert({m,k});
-                proc.push({m,k});
-              }
+              if(m.acc)
+                add(m.state, k.state);
             }
           }
-
-          if(counter[{a, item.first, k}] == trans[{k, a}].size())
+          if(++counter[ind] == succCnt[a*n + k.state])
           {
-            for(const State& m : revTr[{item.first, a}])
-            {
-              if(ret.find({m,k}) == ret.end())
-              {
-                ret.insert({m,k});
-                proc.push({m,k});
-              }
-            }
+            for(const Pred& m : predFirst)
+              add(m.state, k.state);
           }
         }
       }
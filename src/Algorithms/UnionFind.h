@@ -0,0 +1,57 @@
+#ifndef _UNION_FIND_H_
+#define _UNION_FIND_H_
+
+#include <vector>
+#include <utility>
+
+/*
+ * Disjoint sets over elements 0..n-1 (union by size, path halving)
+ */
+class UnionFind
+{
+private:
+  std::vector<int> parent;
+  std::vector<int> size;
+
+public:
+  /*
+   * @param n Number of elements (each element forms a singleton set)
+   */
+  UnionFind(unsigned n) : parent(n), size(n, 1)
+  {
+    for(unsigned i = 0; i < n; i++)
+      this->parent[i] = i;
+  }
+
+  /*
+   * Get the representative of the set containing p
+   */
+  int find(int p)
+  {
+    while(this->parent[p] != p)
+    {
+      this->parent[p] = this->parent[this->parent[p]];
+      p = this->parent[p];
+    }
+    return p;
+  }
+
+  /*
+   * Merge the sets containing p and q
+   * @return True iff the sets were different
+   */
+  bool unite(int p, int q)
+  {
+    p = find(p);
+    q = find(q);
+    if(p == q)
+      return false;
+    if(this->size[p] < this->size[q])
+      std::swap(p, q);
+    this->parent[q] = p;
+    this->size[p] += this->size[q];
+    return true;
+  }
+};
+
+#endif
@@ -2,192 +2,232 @@
 #include "AutGraph.h"
 
 /*
- * Strongly connected components from a given vertex number (implementing
- * the Tarjan's algorithm)
+ * Compute the condensation of a graph (the iterative version of the
+ * Tarjan's algorithm; vertices and their successors are processed in the
+ * same order as by the recursive one, hence the components are found in the
+ * same order)
+ * @param adj Adjacency list (vertices 0..n-1)
  */
-void AutGraph::strongConnect(int v)
+Condensation::Condensation(const AdjList& adj) : compOf(adj.size(), -1), components(),
+  succ(), trivial(), accepting(), deterministic()
 {
-  this->vertices[v].index = this->index;
-  this->vertices[v].lowLink = this->index;
-  this->index++;
-  this->S.push(v);
-  this->vertices[v].onStack = true;
+  int n = adj.size();
+  int index = 0;
+  vector<int> indices(n, -1);
+  vector<int> lowLink(n, -1);
+  vector<bool> onStack(n, false);
+  vector<int> stack;
+  // DFS stack: vertex and the position of the next successor
+  vector<pair<int, unsigned>> dfs;
 
-  for(int w : this->adjList[v])
+  for(int root = 0; root < n; root++)
   {
-    if(this->vertices[w].index == -1)
-    {
-      strongConnect(w);
-      this->vertices[v].lowLink = std::min(this->vertices[v].lowLink,
-          this->vertices[w].lowLink);
-    }
-    else if(this->vertices[w].onStack)
+    if(indices[root] != -1)
+      continue;
+
+    indices[root] = lowLink[root] = index++;
+    stack.push_back(root);
+    onStack[root] = true;
+    dfs.push_back({root, 0});
+    while(!dfs.empty())
     {
-      this->vertices[v].lowLink = std::min(this->vertices[v].lowLink, this->vertices[w].index);
-    }
-  }
+      int v = dfs.back().first;
+      if(dfs.back().second < adj[v].size())
+      {
+        int w = adj[v][dfs.back().second++];
+        if(indices[w] == -1)
+        {
+          indices[w] = lowLink[w] = index++;
+          stack.push_back(w);
+          onStack[w] = true;
+          dfs.push_back({w, 0});
+        }
+        else if(onStack[w])
+        {
+          lowLink[v] = std::min(lowLink[v], indices[w]);
+        }
+        continue;
+      }
 
-  if(this->vertices[v].lowLink == this->vertices[v].index)
-  {
-    set<int> scc;
-    bool final = false;
-    int w;
-    do {
-      w = this->S.top();
-      this->S.pop();
-      this->vertices[w].onStack = false;
-      scc.insert(this->vertices[w].label);
-      if(!final && this->finals.find(this->vertices[w].label) != this->finals.end())
+      if(lowLink[v] == indices[v])
       {
-        final = true;
+        int c = this->components.size();
+        vector<int> comp;
+        int w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          onStack[w] = false;
+          this->compOf[w] = c;
+          comp.push_back(w);
+        } while(v != w);
+        std::sort(comp.begin(), comp.end());
+        this->components.push_back(comp);
       }
-    } while(v != w);
-    if(final && scc.size() >= 1)
-    {
-      auto item = scc.begin();
-      if(scc.size() == 1)
+      dfs.pop_back();
+      if(!dfs.empty())
       {
-        auto it = std::find(this->adjList[*item].begin(), this->adjList[*item].end(), *item);
-        if(it != this->adjList[*item].end())
-          this->finalComponents.push_back(scc);
+        int u = dfs.back().first;
+        lowLink[u] = std::min(lowLink[u], lowLink[v]);
       }
-      else
+    }
+  }
+
+  int cnt = this->components.size();
+  this->succ.resize(cnt);
+  this->trivial.assign(cnt, false);
+  this->accepting.assign(cnt, false);
+  this->deterministic.assign(cnt, false);
+  for(int c = 0; c < cnt; c++)
+  {
+    bool selfLoop = false;
+    for(int v : this->components[c])
+    {
+      for(int w : adj[v])
       {
-        this->finalComponents.push_back(scc);
+        if(this->compOf[w] != c)
+          this->succ[c].push_back(this->compOf[w]);
+        else if(v == w)
+          selfLoop = true;
       }
     }
-    this->allComponents.push_back(scc);
+    std::sort(this->succ[c].begin(), this->succ[c].end());
+    this->succ[c].erase(std::unique(this->succ[c].begin(), this->succ[c].end()), this->succ[c].end());
+    this->trivial[c] = this->components[c].size() == 1 && !selfLoop;
   }
 }
 
-void AutGraph::strongConnect(int v, std::map<int, std::set<int>> finals, bool coBuchi, std::vector<std::vector<int>> allCycles)
-{
-  this->vertices[v].index = this->index;
-  this->vertices[v].lowLink = this->index;
-  this->index++;
-  this->S.push(v);
-  this->vertices[v].onStack = true;
 
-  for(int w : this->adjList[v])
+/*
+ * Set accepting flags wrt the Buchi condition: a component is accepting if
+ * it is not trivial and contains a final vertex or an accepting edge
+ * @param finals Final vertices
+ * @param accTrans Accepting edges
+ */
+void Condensation::markAccepting(const set<int>& finals, const set<pair<int, int>>& accTrans)
+{
+  for(unsigned c = 0; c < this->components.size(); c++)
   {
-    if(this->vertices[w].index == -1)
-    {
-      strongConnect(w);
-      this->vertices[v].lowLink = std::min(this->vertices[v].lowLink,
-          this->vertices[w].lowLink);
-    }
-    else if(this->vertices[w].onStack)
+    this->accepting[c] = false;
+    if(this->trivial[c])
+      continue;
+    for(int v : this->components[c])
     {
-      this->vertices[v].lowLink = std::min(this->vertices[v].lowLink, this->vertices[w].index);
+      if(finals.find(v) != finals.end())
+        this->accepting[c] = true;
     }
   }
+  for(const auto& tr : accTrans)
+  {
+    int c = this->compOf[tr.first];
+    if(c == this->compOf[tr.second])
+      this->accepting[c] = true;
+  }
+}
+
 
-  if(this->vertices[v].lowLink == this->vertices[v].index)
+/*
+ * Topological order of components (a component precedes its successors).
+ * The order is given by the depth-first search starting from components in
+ * the order of their ids, successors are visited in the order of ids.
+ * @return Vector of component ids
+ */
+vector<int> Condensation::topologicalOrder() const
+{
+  int cnt = this->components.size();
+  vector<bool> visited(cnt, false);
+  vector<int> post;
+  vector<pair<int, unsigned>> dfs;
+  for(int root = 0; root < cnt; root++)
   {
-    set<int> scc;
-    bool final = false;
-    int w;
-    do {
-      w = this->S.top();
-      this->S.pop();
-      this->vertices[w].onStack = false;
-      scc.insert(this->vertices[w].label);
-      //if(!final && this->finals.find(this->vertices[w].label) != this->finals.end())
-      //{
-        final = true;
-      //}
-    } while(v != w);
-    std::cerr << "SCC" << std::endl;
-    if(final && scc.size() >= 1)
+    if(visited[root])
+      continue;
+    visited[root] = true;
+    dfs.push_back({root, 0});
+    while(!dfs.empty())
     {
-      auto item = scc.begin();
-      if(scc.size() == 1)
+      int c = dfs.back().first;
+      if(dfs.back().second < this->succ[c].size())
       {
-        auto it = std::find(this->adjList[*item].begin(), this->adjList[*item].end(), *item);
-        if(it != this->adjList[*item].end()){
-          // GBA
-          if (not coBuchi){
-            bool skip = false;
-            for (auto it = finals.begin(); it != finals.end(); it++){
-              bool contains = false;
-              for (auto state : it->second){
-                if (scc.find(state) != scc.end())
-                  contains = true;
-              if (not contains)
-                skip = true;
-              }
-            }
-            if (not skip)
-              this->finalComponents.push_back(scc);
-          }
-
-          // GcoBA
-          // add to final components if there is some cycle with missing final state from some fin
-          else {
-            for (auto v : allCycles){
-              std::vector<int> sccIntersection;
-              std::set_intersection(v.begin(), v.end(), scc.begin(), scc.end(), std::back_inserter(sccIntersection));
-              if (sccIntersection.empty())
-                continue;
-              bool missing = false;
-              std::vector<int> intersection;
-              for (auto it = finals.begin(); it != finals.end(); it++){
-                std::set_intersection(v.begin(), v.end(), it->second.begin(), it->second.end(), std::back_inserter(intersection));
-                if (intersection.empty()){
-                  missing = true;
-                  this->finalComponents.push_back(scc);
-                  break;
-                }
-              }
-              if (missing)
-                break;
-            }
-          }
+        int d = this->succ[c][dfs.back().second++];
+        if(!visited[d])
+        {
+          visited[d] = true;
+          dfs.push_back({d, 0});
         }
+        continue;
       }
-      else
-      {
-        // GBA
-        if (not coBuchi){
-          bool skip = false;
-          for (auto it = finals.begin(); it != finals.end(); it++){
-            bool contains = false;
-            for (auto state : it->second){
-              if (scc.find(state) != scc.end())
-                contains = true;
-            if (not contains)
-              skip = true;
-            }
-          }
-          if (not skip)
-            this->finalComponents.push_back(scc);
-        }
+      post.push_back(c);
+      dfs.pop_back();
+    }
+  }
+  return vector<int>(post.rbegin(), post.rend());
+}
+
 
-        // GcoBA
-        else {
-            for (auto v : allCycles){
-              std::vector<int> sccIntersection;
-              std::set_intersection(v.begin(), v.end(), scc.begin(), scc.end(), std::back_inserter(sccIntersection));
-              if (sccIntersection.empty())
-                continue;
-              bool missing = false;
-              std::vector<int> intersection;
-              for (auto it = finals.begin(); it != finals.end(); it++){
-                std::set_intersection(v.begin(), v.end(), it->second.begin(), it->second.end(), std::back_inserter(intersection));
-                if (intersection.empty()){
-                  missing = true;
-                  this->finalComponents.push_back(scc);
-                  break;
-                }
-              }
-              if (missing)
-                break;
-            }
-         }
+/*
+ * Close a property of components forward
+ * @param prop Property of components
+ * @return For each component: does the property hold for the component and
+ *         all components reachable from it?
+ */
+vector<bool> Condensation::closeForward(const vector<bool>& prop) const
+{
+  vector<bool> ret(prop);
+  // successors have smaller ids
+  for(unsigned c = 0; c < this->components.size(); c++)
+  {
+    for(int d : this->succ[c])
+    {
+      if(!ret[d])
+        ret[c] = false;
+    }
+  }
+  return ret;
+}
+
+
+/*
+ * Is a nontrivial SCC final wrt generalized (co-)Buchi acceptance
+ * @param scc SCC
+ * @param finals Sets of final states
+ * @param coBuchi Co-Buchi acceptance
+ * @param allCycles All cycles of the automaton (for co-Buchi acceptance)
+ * @return Final SCC
+ */
+bool AutGraph::isFinalGen(const set<int>& scc, const map<int, set<int>>& finals, bool coBuchi,
+  const std::vector<std::vector<int>>& allCycles) const
+{
+  // GBA
+  if (not coBuchi){
+    bool skip = false;
+    for (auto it = finals.begin(); it != finals.end(); it++){
+      bool contains = false;
+      for (auto state : it->second){
+        if (scc.find(state) != scc.end())
+          contains = true;
+      if (not contains)
+        skip = true;
       }
     }
-    this->allComponents.push_back(scc);
+    return not skip;
+  }
+
+  // GcoBA
+  // final if there is some cycle with missing final state from some fin
+  for (const auto& v : allCycles){
+    std::vector<int> sccIntersection;
+    std::set_intersection(v.begin(), v.end(), scc.begin(), scc.end(), std::back_inserter(sccIntersection));
+    if (sccIntersection.empty())
+      continue;
+    std::vector<int> intersection;
+    for (auto it = finals.begin(); it != finals.end(); it++){
+      std::set_intersection(v.begin(), v.end(), it->second.begin(), it->second.end(), std::back_inserter(intersection));
+      if (intersection.empty())
+        return true;
+    }
   }
+  return false;
 }
 
 
@@ -196,16 +236,20 @@ void AutGraph::strongConnect(int v, std::map<int, std::set<int>> finals, bool co
  */
 void AutGraph::computeSCCs()
 {
-  this->index = 0;
-  this->S = stack<int>();
+  Condensation cond(this->adjList);
+  set<pair<int, int>> noAccTrans;
+  cond.markAccepting(this->finals, noAccTrans);
+
   this->finalComponents.clear();
   this->allComponents.clear();
-  for(VertItem v : this->vertices)
+  for(unsigned c = 0; c < cond.size(); c++)
   {
-    if(v.index == -1)
-    {
-      this->strongConnect(v.label);
-    }
+    set<int> scc;
+    for(int v : cond.getVertices(c))
+      scc.insert(this->vertices[v].label);
+    if(cond.isAccepting(c))
+      this->finalComponents.push_back(scc);
+    this->allComponents.push_back(scc);
   }
 }
 
@@ -215,17 +259,7 @@ void AutGraph::computeSCCs()
  */
 void AutGraph::computeSCCs(set<pair<int, int> >& accTrans)
 {
-  this->index = 0;
-  this->S = stack<int>();
-  this->finalComponents.clear();
-  this->allComponents.clear();
-  for(VertItem v : this->vertices)
-  {
-    if(v.index == -1)
-    {
-      this->strongConnect(v.label);
-    }
-  }
+  this->computeSCCs();
 
   set<set<int> > accComp(this->finalComponents.begin(), this->finalComponents.end());
   for(const auto& scc : this->allComponents)
@@ -240,18 +274,27 @@ void AutGraph::computeSCCs(set<pair<int, int> >& accTrans)
 }
 
 
-void AutGraph::computeSCCs(std::map<int, std::set<int>> finals, bool coBuchi, std::vector<std::vector<int>> allCycles)
+/*
+ * Compute all strongly connected components (SCCs) wrt generalized
+ * (co-)Buchi acceptance
+ * @param finals Sets of final states
+ * @param coBuchi Co-Buchi acceptance
+ * @param allCycles All cycles of the automaton (for co-Buchi acceptance)
+ */
+void AutGraph::computeSCCs(const std::map<int, std::set<int>>& finals, bool coBuchi, const std::vector<std::vector<int>>& allCycles)
 {
-  this->index = 0;
-  this->S = stack<int>();
+  Condensation cond(this->adjList);
+
   this->finalComponents.clear();
   this->allComponents.clear();
-  for(VertItem v : this->vertices)
+  for(unsigned c = 0; c < cond.size(); c++)
   {
-    if(v.index == -1)
-    {
-      this->strongConnect(v.label, finals, coBuchi, allCycles);
-    }
+    set<int> scc;
+    for(int v : cond.getVertices(c))
+      scc.insert(this->vertices[v].label);
+    if(!cond.isTrivial(c) && isFinalGen(scc, finals, coBuchi, allCycles))
+      this->finalComponents.push_back(scc);
+    this->allComponents.push_back(scc);
   }
 }
 
@@ -32,6 +32,56 @@ typedef vector<SCC> SCCs;
 typedef vector<vector<int> > AdjList;
 typedef vector<VertItem> Vertices;
 
+/*
+ * Condensation of a graph over vertices 0..n-1: strongly connected
+ * components (computed by an iterative version of the Tarjan's algorithm,
+ * hence deep graphs do not overflow the stack) and the DAG of components.
+ * Components are numbered in the order they are completed by the Tarjan's
+ * algorithm, hence all successors of a component have smaller ids. Each
+ * component carries flags: trivial (a single vertex without a self-loop),
+ * accepting and deterministic (the meaning of the last two is given by the
+ * client).
+ */
+class Condensation
+{
+private:
+  vector<int> compOf;
+  vector<vector<int>> components;
+  vector<vector<int>> succ;
+  vector<bool> trivial;
+  vector<bool> accepting;
+  vector<bool> deterministic;
+
+public:
+  Condensation(const AdjList& adj);
+
+  size_t size() const { return this->components.size(); }
+  int getComponent(int v) const { return this->compOf[v]; }
+
+  /*
+   * Get vertices of a component
+   * @return Ascending vector of vertices
+   */
+  const vector<int>& getVertices(int c) const { return this->components[c]; }
+
+  /*
+   * Get successor components of a component (in the DAG)
+   * @return Ascending vector of component ids
+   */
+  const vector<int>& getSuccessors(int c) const { return this->succ[c]; }
+
+  bool isTrivial(int c) const { return this->trivial[c]; }
+  bool isAccepting(int c) const { return this->accepting[c]; }
+  bool isDeterministic(int c) const { return this->deterministic[c]; }
+  void setAccepting(int c, bool val) { this->accepting[c] = val; }
+  void setDeterministic(int c, bool val) { this->deterministic[c] = val; }
+
+  void markAccepting(const set<int>& finals, const set<pair<int, int>>& accTrans);
+  vector<int> topologicalOrder() const;
+  vector<bool> closeForward(const vector<bool>& prop) const;
+};
+
+
 class AutGraph
 {
 
@@ -43,12 +93,9 @@ private:
   SCCs finalComponents;
   SCCs allComponents;
 
-  int index;
-  stack<int> S;
-
 protected:
-  void strongConnect(int v);
-  void strongConnect(int v, map<int, set<int>> finals, bool coBuchi, std::vector<std::vector<int>> allCycles);
+  bool isFinalGen(const set<int>& scc, const map<int, set<int>>& finals, bool coBuchi,
+    const std::vector<std::vector<int>>& allCycles) const;
 
 public:
   AutGraph(AdjList& adj, Vertices& vert, set<int>& finals)
@@ -67,7 +114,7 @@ public:
 
   void computeSCCs();
   void computeSCCs(set<pair<int, int> >& accTrans);
-  void computeSCCs(map<int, set<int>> finals, bool coBuchi, std::vector<std::vector<int>> alCycles);
+  void computeSCCs(const map<int, set<int>>& finals, bool coBuchi, const std::vector<std::vector<int>>& allCycles);
   set<int> reachableVertices(set<int>& from);
   static set<int> reachableVertices(AdjList &lst, set<int>& from);
 
@@ -42,35 +42,70 @@ void AutomatonStruct<int, int>::getAutGraphComponents(AdjList& adjList, Vertices
 
 
 /*
- * For each state compute a set of reachable states (assumes numbered states
- * from 0 with no gaps).
- * @return Vector of sets of reachable states
+ * Get the condensation of the automaton graph (assumes numbered states from 0
+ * with no gaps). A component is marked as deterministic if each of its
+ * states has at most one successor over each symbol.
+ * @return Condensation
  */
 template <>
-vector<set<int> > AutomatonStruct<int, int>::reachableVector()
+Condensation AutomatonStruct<int, int>::getCondensation()
 {
-  vector<set<int> > adjListSet(this->states.size());
-  vector<vector<int> > adjList(this->states.size());
-  vector<set<int> > ret(this->states.size());
-  for(auto st : this->states)
+  AdjList adjList(this->states.size());
+  Vertices vrt;
+  getAutGraphComponents(adjList, vrt);
+
+  Condensation cond(adjList);
+  for(unsigned c = 0; c < cond.size(); c++)
+    cond.setDeterministic(c, true);
+  for(const auto& tr : this->trans)
   {
-    adjListSet[st] = set<int>();
-  }
-  for(auto tr : this->trans)
-  {
-    adjListSet[tr.first.first].insert(tr.second.begin(), tr.second.end());
-  }
-  for(auto st : this->states)
-  {
-    adjList[st] = vector<int>(adjListSet[st].begin(), adjListSet[st].end());
+    if(tr.second.size() > 1 && this->alph.find(tr.first.second) != this->alph.end())
+      cond.setDeterministic(cond.getComponent(tr.first.first), false);
   }
+  return cond;
+}
 
-  for(auto st : this->states)
+
+/*
+ * Get the reachability index of the automaton graph (assumes numbered states
+ * from 0 with no gaps).
+ * @return Reachability index
+ */
+template <>
+Reachability AutomatonStruct<int, int>::getReachability()
+{
+  AdjList adjList(this->states.size());
+  for(const auto& tr : this->trans)
   {
-    set<int> tmp({st});
-    ret[st] = AutGraph::reachableVertices(adjList, tmp);
+    adjList[tr.first.first].insert(adjList[tr.first.first].end(), tr.second.begin(), tr.second.end());
   }
-  return ret;
+  return Reachability(adjList);
+}
+
+
+/*
+ * For each state compute a set of reachable states (assumes numbered states
+ * from 0 with no gaps).
+ * @return Vector of sets of reachable states
+ */
+template <>
+vector<set<int> > AutomatonStruct<int, int>::reachableVector()
+{
+  return this->getReachability().toVector();
+}
+
+
+/*
+ * Build the frozen (CSR) transition table of the automaton (assumes
+ * numbered states and symbols from 0).
+ * @return Transition table
+ */
+template <>
+TransitionTable AutomatonStruct<int, int>::getTransitionTable()
+{
+  int stateCnt = this->states.size() > 0 ? *this->states.rbegin() + 1 : 0;
+  int symbolCnt = this->alph.size() > 0 ? *this->alph.rbegin() + 1 : 0;
+  return TransitionTable(this->trans, stateCnt, symbolCnt);
 }
 
 
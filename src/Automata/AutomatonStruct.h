@@ -14,11 +14,14 @@
 #include <chrono>
 
 #include "AutGraph.h"
+#include "TransitionTable.h"
 #include "../Complement/StateKV.h"
 #include "../Complement/StateSch.h"
 #include "../Complement/StateSD.h"
 #include "../Complement/StateGcoBA.h"
 #include "../Algorithms/AuxFunctions.h"
+#include "../Algorithms/DataFlow.h"
+#include "../Algorithms/Reachability.h"
 #include "APSymbol.h"
 #include "StateSemiDet.h"
 
@@ -53,7 +56,7 @@ struct LabelState {
  * Transition function
  */
 template<typename State, typename Symbol> using Delta = std::map<std::pair<State, Symbol>, std::set<State>>;
-template<typename State, typename Label> using VecLabelStatesPtr = std::vector<LabelState<State, Label>* >;
+template<typename State, typename Label> using VecLabelStatesPtr = std::vector<const LabelState<State, Label>* >;
 template<typename State, typename Symbol> using VecTrans = std::vector< Transition<State, Symbol> >;
 
 
@@ -138,6 +141,11 @@ public:
     return this->states;
   }
 
+  const SetStates& getStates() const
+  {
+    return this->states;
+  }
+
   /*
    * Get automaton initial states.
    * @return Set of initial states
@@ -147,6 +155,11 @@ public:
     return this->initials;
   }
 
+  const SetStates& getInitials() const
+  {
+    return this->initials;
+  }
+
   /*
    * Get automaton transitions.
    * @return Transitions: map<pair<State, Symbol>, Set<States>>
@@ -156,6 +169,11 @@ public:
     return this->trans;
   }
 
+  const Transitions& getTransitions() const
+  {
+    return this->trans;
+  }
+
   /*
    * Get automaton alphabet.
    * @return Set of symbols
@@ -165,6 +183,11 @@ public:
     return this->alph;
   }
 
+  const SetSymbols& getAlphabet() const
+  {
+    return this->alph;
+  }
+
   /*
    * Set automaton alphabet.
    * @params st New set of symbols
@@ -217,7 +240,7 @@ public:
    * Get atomic propositions
    * @return Vector of atomic propositions
    */
-  vector<string> getAPPattern()
+  vector<string> getAPPattern() const
   {
     return this->apsPattern;
   }
@@ -246,9 +269,12 @@ public:
   }
 
   vector<set<State> > reachableVector();
+  Reachability getReachability();
+  TransitionTable getTransitionTable();
   vector<Symbol> containsSelfLoop(State& state);
 
   void getAutGraphComponents(AdjList& adjList, Vertices& vrt);
+  Condensation getCondensation();
   set<State> getSelfLoops();
   set<State> getAllSuccessors(State state);
   set<State> getAllSuccessors(State state, map<State, set<Symbol>>& predMap);
@@ -257,57 +283,64 @@ public:
   set<State> getAllPredecessors(State state, map<State, set<Symbol>>& revMap);
 
   /*
-   * Implementation of a simple data flow analysis. The values are iteratively
-   * propagated through graph of the automaton.
-   * @param updFnc Function updating values of the states
+   * Implementation of a simple data flow analysis. The values are propagated
+   * through the graph of the automaton (see DataFlow) until a fixpoint is
+   * reached.
+   * @param updFnc Function updating the value of a state given the states
+   *        it depends on (successors for the backward direction)
    * @param initFnc Function assigning initial values to states
+   * @param dir Direction of the analysis
    * @return Values assigned to each state after fixpoint
    */
   template <typename Label>
-  std::map<State, Label> propagateGraphValues(const std::function<Label(LabelState<State, Label>*,VecLabelStatesPtr<State, Label>)>& updFnc,
-    const std::function<Label(const State&)>& initFnc)
+  std::map<State, Label> propagateGraphValues(const std::function<Label(const LabelState<State, Label>&, const VecLabelStatesPtr<State, Label>&)>& updFnc,
+    const std::function<Label(const State&)>& initFnc, DataFlow::Direction dir = DataFlow::BACKWARD)
   {
-    std::map<State, LabelState<State, Label>*> lst;
-    VecLabelStatesPtr<State, Label> active;
-    std::map<State, std::vector<LabelState<State, Label>*>> tr;
-    for(State st : this->states)
+    std::vector<State> ids(this->states.begin(), this->states.end());
+    auto idOf = [&ids] (const State& st) -> int
     {
-      LabelState<State, Label>* nst = new LabelState<State, Label>;
-      nst->label = initFnc(st);
-      nst->state = st;
+      return std::lower_bound(ids.begin(), ids.end(), st) - ids.begin();
+    };
 
-      active.push_back(nst);
-      lst[st] = nst;
-      tr[st] = std::vector<LabelState<State, Label>*>();
+    AdjList succ(ids.size());
+    for(const auto& t : this->trans)
+    {
+      vector<int>& dst = succ[idOf(t.first.first)];
+      for(const State& d : t.second)
+        dst.push_back(idOf(d));
+    }
+    for(auto& dst : succ)
+    {
+      std::sort(dst.begin(), dst.end());
+      dst.erase(std::unique(dst.begin(), dst.end()), dst.end());
     }
 
-    for(auto t : this->trans)
+    DataFlow flow(succ, dir);
+    std::vector<LabelState<State, Label>> lst;
+    lst.reserve(ids.size());
+    for(const State& st : ids)
+      lst.push_back({ st, initFnc(st) });
+    std::vector<VecLabelStatesPtr<State, Label>> deps(ids.size());
+    for(unsigned i = 0; i < ids.size(); i++)
     {
-      for(auto d : t.second)
-      {
-        tr[t.first.first].push_back(lst[d]);
-      }
+      for(int d : flow.getDependencies(i))
+        deps[i].push_back(&lst[d]);
     }
 
-    bool change = false;
-    do {
-      change = false;
-      for(LabelState<State, Label>* ls : active)
+    flow.solve([&lst, &deps, &updFnc] (int v) -> bool
+    {
+      Label nval = updFnc(lst[v], deps[v]);
+      if(nval != lst[v].label)
       {
-        Label nval = updFnc(ls, tr[ls->state]);
-        if(nval != ls->label)
-          change = true;
-        ls->label = nval;
+        lst[v].label = nval;
+        return true;
       }
-    } while(change);
-
-    map<State, Label> activeVal;
-    for(unsigned i = 0; i < active.size(); i++)
-    {
-      activeVal[active[i]->state] = active[i]->label;
-      delete active[i];
-    }
+      return false;
+    });
 
+    std::map<State, Label> activeVal;
+    for(const auto& ls : lst)
+      activeVal.insert(activeVal.end(), { ls.state, ls.label });
     return activeVal;
   }
 
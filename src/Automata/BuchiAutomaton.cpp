@@ -1,4 +1,5 @@
 #include "BuchiAutomaton.h"
+#include "SubsetConstruction.h"
 #include <boost/math/special_functions/factorials.hpp>
 
 /*
@@ -739,16 +740,17 @@ void BuchiAutomaton<int, int>::removeUseless()
       revList[dst].push_back(i);
   }
 
-  AutGraph gr(adjList, vrt, this->finals);
-  gr.computeSCCs(accTrSet);
+  Condensation cond(adjList);
+  cond.markAccepting(this->finals, accTrSet);
   set<int> fin;
-  for(auto s : gr.getFinalComponents())
+  for(unsigned c = 0; c < cond.size(); c++)
   {
-    fin.insert(s.begin(), s.end());
+    if(cond.isAccepting(c))
+      fin.insert(cond.getVertices(c).begin(), cond.getVertices(c).end());
   }
 
-  set<int> reach = gr.reachableVertices(this->getInitials());
-  set<int> backreach = gr.reachableVertices(revList, fin);
+  set<int> reach = AutGraph::reachableVertices(adjList, this->getInitials());
+  set<int> backreach = AutGraph::reachableVertices(revList, fin);
   set<int> ret;
 
   std::set_intersection(reach.begin(),reach.end(),backreach.begin(),
@@ -757,6 +759,153 @@ void BuchiAutomaton<int, int>::removeUseless()
 }
 
 
+/*
+ * Remove unreachable and nonaccepting states and rename states and symbols
+ * of the automaton to numbers in a single pass (the result is the same as
+ * renaming, removing useless states and renaming again; states are numbered
+ * from 0 in their order).
+ * @param mpsymbol Explicit map assigning numbers to original symbols
+ * @return Renamed automaton with useful states only
+ */
+template <typename State, typename Symbol>
+BuchiAutomaton<int, int> BuchiAutomaton<State, Symbol>::removeUselessRename(map<Symbol, int>& mpsymbol)
+{
+  std::map<State, int> pos;
+  for(const auto& st : this->states)
+    pos.emplace_hint(pos.end(), st, pos.size());
+
+  AdjList adjList(this->states.size());
+  for(const auto& tr : this->trans)
+  {
+    vector<int>& adj = adjList[pos.at(tr.first.first)];
+    for(const auto& dst : tr.second)
+      adj.push_back(pos.at(dst));
+  }
+  set<int> fin = Aux::mapSet(pos, this->finals);
+  set<pair<int, int> > accTrSet;
+  for(const auto& tr : this->accTrans)
+    accTrSet.insert({pos.at(tr.from), pos.at(tr.to)});
+
+  // components reaching an accepting component (successors have smaller ids)
+  Condensation cond(adjList);
+  cond.markAccepting(fin, accTrSet);
+  vector<bool> backreach(cond.size(), false);
+  for(unsigned c = 0; c < cond.size(); c++)
+  {
+    backreach[c] = cond.isAccepting(c);
+    for(int d : cond.getSuccessors(c))
+    {
+      if(backreach[d])
+        backreach[c] = true;
+    }
+  }
+
+  vector<bool> reach(adjList.size(), false);
+  vector<int> stack;
+  for(const auto& st : this->initials)
+  {
+    int v = pos.at(st);
+    if(!reach[v])
+    {
+      reach[v] = true;
+      stack.push_back(v);
+    }
+  }
+  while(!stack.empty())
+  {
+    int v = stack.back();
+    stack.pop_back();
+    for(int d : adjList[v])
+    {
+      if(!reach[d])
+      {
+        reach[d] = true;
+        stack.push_back(d);
+      }
+    }
+  }
+
+  // useful states are numbered in their order
+  vector<int> ren(adjList.size(), -1);
+  std::map<State, int> mpstate;
+  int stcnt = 0;
+  this->invRenameMap.clear();
+  for(const auto& st : this->states)
+  {
+    int v = pos[st];
+    if(reach[v] && backreach[cond.getComponent(v)])
+    {
+      ren[v] = stcnt++;
+      mpstate.emplace_hint(mpstate.end(), st, ren[v]);
+      this->invRenameMap.push_back(st);
+    }
+  }
+  auto renamed = [&](const State& st) { return ren[pos.at(st)]; };
+
+  std::set<int> rstate;
+  for(int i = 0; i < stcnt; i++)
+    rstate.insert(rstate.end(), i);
+  std::set<int> rini;
+  for(const auto& st : this->initials)
+  {
+    if(renamed(st) != -1)
+      rini.insert(renamed(st));
+  }
+  std::set<int> rfin;
+  for(const auto& st : this->finals)
+  {
+    if(renamed(st) != -1)
+      rfin.insert(renamed(st));
+  }
+  set<int> rsym;
+  for(const auto& t : this->alph)
+    rsym.insert(mpsymbol[t]);
+
+  Delta<int, int> rtrans;
+  for(const auto& p : this->trans)
+  {
+    int from = renamed(p.first.first);
+    if(from == -1)
+      continue;
+    std::set<int> to;
+    for(const auto& dst : p.second)
+    {
+      if(renamed(dst) != -1)
+        to.insert(to.end(), renamed(dst));
+    }
+    rtrans.insert({std::make_pair(from, mpsymbol[p.first.second]), to});
+  }
+  VecTrans<int, int> ftrans;
+  for(const auto& tr : this->accTrans)
+  {
+    if(renamed(tr.from) == -1 || renamed(tr.to) == -1)
+      continue;
+    ftrans.push_back({ .from = renamed(tr.from), .to = renamed(tr.to),
+        .symbol = mpsymbol[tr.symbol] });
+  }
+
+  auto ret = BuchiAutomaton<int, int>(rstate, rfin, rini, rtrans, ftrans, rsym);
+  this->renameStateMap = mpstate;
+  this->renameSymbolMap = mpsymbol;
+
+  std::set<std::pair<int, int> > rdirSim, roddSim;
+  for(const auto& item : this->directSim)
+  {
+    if(mpstate.count(item.first) > 0 && mpstate.count(item.second) > 0)
+      rdirSim.insert({mpstate[item.first], mpstate[item.second]});
+  }
+  for(const auto& item : this->oddRankSim)
+  {
+    if(mpstate.count(item.first) > 0 && mpstate.count(item.second) > 0)
+      roddSim.insert({mpstate[item.first], mpstate[item.second]});
+  }
+  ret.setDirectSim(rdirSim);
+  ret.setOddRankSim(roddSim);
+  ret.setAPPattern(this->apsPattern);
+  return ret;
+}
+
+
 /*
  * Restrict the automaton wrt given states (in place modification).
  * @param st States that remain in the automaton
@@ -928,213 +1077,105 @@ void BuchiAutomaton<int, APSymbol>::completeAPComplement()
 }
 
 /*
- * Compute the odd rank simulation (stores in this->oddRankSim)
- * @param cl Closure of states
+ * Get the odd rank simulation over positions of states (in the order of
+ * this->states) initialized by the direct simulation
+ * @return Odd rank simulation (for the empty closure computed)
  */
 template <typename State, typename Symbol>
-void BuchiAutomaton<State, Symbol>::computeRankSim(std::set<State>& cl)
+RankSimulation BuchiAutomaton<State, Symbol>::getRankSimulation()
 {
   /*
   TODO: add support for accepting transitions
   */
   assert(this->accTrans.size() == 0);
 
-  StateRelation rel = this->directSim;
-  bool add = false;
-  std::map<Symbol, bool> ignore;
-
-  for(Symbol s : this->alph)
+  map<State, int> pos;
+  map<Symbol, int> symPos;
+  DenseSet nonacc;
+  int i = 0;
+  for(const State& st : this->states)
   {
-    ignore[s] = false;
-    for(State st : cl)
-    {
-      if(this->trans[{st, s}].size() == 0)
-        ignore[s] = true;
-    }
-
+    if(this->finals.find(st) == this->finals.end())
+      nonacc.insert(i);
+    pos[st] = i++;
   }
+  i = 0;
+  for(const Symbol& sym : this->alph)
+    symPos[sym] = i++;
 
-  do {
-    add = false;
-    transitiveClosure(rel, cl);
-    for(State st1 : this->states)
-    {
-      if(this->finals.find(st1) != this->finals.end())
-        continue;
-      for(State st2 : this->states)
-      {
-        if(this->finals.find(st2) != this->finals.end())
-          continue;
-        bool der = deriveRankConstr(st1, st2, rel);
-        if(der)
-          add = true;
-      }
-    }
-  } while(add);
-  this->oddRankSim = rel;
-}
-
-
-/*
- * Function checking wheather odd rank sim contains equivalent pairs.
- * @param cl Closure of states
- */
-template <typename State, typename Symbol>
-bool BuchiAutomaton<State, Symbol>::containsRankSimEq(std::set<State>& cl)
-{
-  /*
-  TODO: add support for accepting transitions
-  */
-  assert(this->accTrans.size() == 0);
-
-  this->computeRankSim(cl);
-  for(auto& item : this->oddRankSim)
+  RankSimulation ret(pos.size(), symPos.size(), nonacc);
+  for(const auto& tr : this->trans)
   {
-    if(item.first == item.second)
+    auto srcIt = pos.find(tr.first.first);
+    auto symIt = symPos.find(tr.first.second);
+    if(srcIt == pos.end() || symIt == symPos.end())
       continue;
-    if(this->oddRankSim.find({item.second, item.first}) != this->oddRankSim.end())
-      return true;
-  }
-  return false;
-}
-
-
-/*
- * Function computing transitive closure of give relation
- * @param rel Relation (out parameter)
- * @param cl Closure of states (for computation of odd rank simulation)
- */
-template <typename State, typename Symbol>
-void BuchiAutomaton<State, Symbol>::transitiveClosure(
-    BuchiAutomaton<State, Symbol>::StateRelation& rel, std::set<State>& cl)
-{
-  /*
-  TODO: add support for accepting transitions
-  */
-  assert(this->accTrans.size() == 0);
-
-  unsigned s = rel.size();
-  do
-  {
-    s = rel.size();
-    for(const auto& p1 : rel)
+    for(const State& d : tr.second)
     {
-      if(cl.find(p1.first) == cl.end() || cl.find(p1.second) == cl.end())
-        continue;
-      for(const auto& p2 : rel)
-      {
-        if(cl.find(p2.first) == cl.end() || cl.find(p2.second) == cl.end())
-          continue;
-        if(p1.second == p2.first)
-          rel.insert({p1.first, p2.second});
-      }
+      auto dstIt = pos.find(d);
+      if(dstIt != pos.end())
+        ret.addTransition(srcIt->second, symIt->second, dstIt->second);
     }
-  } while(s != rel.size());
-}
-
-
-/*
- * Get constraints for two states wrt odd rank simulation
- * @param st1 First state
- * @param st2 Second state
- * @param rel odd rank simulation
- */
-template <typename State, typename Symbol>
-bool BuchiAutomaton<State, Symbol>::deriveRankConstr(State& st1, State& st2,
-    BuchiAutomaton<State, Symbol>::StateRelation& rel)
-{
-  /*
-  TODO: add support for accepting transitions
-  */
-  assert(this->accTrans.size() == 0);
-
-  bool leq = true;
-  bool geq = true;
-  bool ret = false;
-  //bool fwdlq = false;
-  //bool fwdgq = false;
-  StateRelation nw;
-
-  for(Symbol sym : this->alph)
-  {
-    set<State> dst1 = this->trans[{st1, sym}];
-    set<State> dst2 = this->trans[{st2, sym}];
-    if(!isRankLeq(dst1, dst2, rel) /*&& !ignore[sym]*/)
-      leq = false;
-    if(!isRankLeq(dst2, dst1, rel) /*&& !ignore[sym]*/)
-      geq = false;
-    //propagateFwd(st1, st2, dst1, dst2, rel, nw);
   }
-
-  if(leq) nw.insert({st1, st2});
-  if(geq) nw.insert({st2, st1});
-
-  for(auto it : nw)
+  for(const auto& pr : this->directSim)
   {
-    if(rel.find(it) == rel.end())
-      ret = true;
-    rel.insert(it);
+    auto it1 = pos.find(pr.first);
+    auto it2 = pos.find(pr.second);
+    if(it1 != pos.end() && it2 != pos.end())
+      ret.addDirectSim(it1->second, it2->second);
   }
+  ret.init();
   return ret;
 }
 
 
 /*
- * Propagate odd rank sim values to successor states (obsolete)
+ * Compute the odd rank simulation (stores in this->oddRankSim)
+ * @param cl Closure of states
  */
 template <typename State, typename Symbol>
-void BuchiAutomaton<State, Symbol>::propagateFwd(State& st1, State& st2,
-    std::set<State>& set1, std::set<State>& set2,
-    BuchiAutomaton<State, Symbol>::StateRelation& rel,
-    BuchiAutomaton<State, Symbol>::StateRelation& nw)
+void BuchiAutomaton<State, Symbol>::computeRankSim(std::set<State>& cl)
 {
-  /*
-  TODO: add support for accepting transitions
-  */
-  assert(this->accTrans.size() == 0);
-
-  std::set<State> fset1, fset2;
-  std::set_difference(set1.begin(), set1.end(), this->finals.begin(), this->finals.end(),
-    std::inserter(fset1, fset1.begin()));
-  std::set_difference(set2.begin(), set2.end(), this->finals.begin(), this->finals.end(),
-    std::inserter(fset2, fset2.begin()));
+  vector<State> sts(this->states.begin(), this->states.end());
+  DenseSet clPos;
+  for(unsigned i = 0; i < sts.size(); i++)
+  {
+    if(cl.find(sts[i]) != cl.end())
+      clPos.insert(i);
+  }
+  BitRelation rel = this->getRankSimulation().compute(clPos);
 
-  if(fset1.size() == 1 && fset2.size() == 1 && rel.find({st1, st2}) != rel.end())
-    nw.insert({*(fset1.begin()), *(fset2.begin())});
-  if(fset1.size() == 1 && fset2.size() == 1 && rel.find({st2, st1}) != rel.end())
-    nw.insert({*(fset2.begin()), *(fset1.begin())});
+  StateRelation res = this->directSim;
+  for(unsigned p = 0; p < sts.size(); p++)
+  {
+    for(int q : rel.row(p))
+      res.insert({sts[p], sts[q]});
+  }
+  this->oddRankSim = res;
 }
 
 
 /*
- * Are all states of set1 bigger than all states of set2?
- * @param set1 First set of states
- * @param set2 Second set of states
- * @param rel Rank simulation (or relation in general)
- * @return set1 >=(forall, forall) sett2
+ * Function checking wheather odd rank sim contains equivalent pairs.
+ * @param cl Closure of states
  */
 template <typename State, typename Symbol>
-bool BuchiAutomaton<State, Symbol>::isRankLeq(std::set<State>& set1, std::set<State>& set2,
-    BuchiAutomaton<State, Symbol>::StateRelation& rel)
+bool BuchiAutomaton<State, Symbol>::containsRankSimEq(std::set<State>& cl)
 {
   /*
   TODO: add support for accepting transitions
   */
   assert(this->accTrans.size() == 0);
 
-  for(State st1 : set1)
+  this->computeRankSim(cl);
+  for(auto& item : this->oddRankSim)
   {
-    if(this->finals.find(st1) != this->finals.end())
+    if(item.first == item.second)
       continue;
-    for(State st2 : set2)
-    {
-      if(this->finals.find(st2) != this->finals.end())
-        continue;
-      if(rel.find({st1, st2}) == rel.end())
-        return false;
-    }
+    if(this->oddRankSim.find({item.second, item.first}) != this->oddRankSim.end())
+      return true;
   }
-  return true;
+  return false;
 }
 
 
@@ -1246,21 +1287,14 @@ bool BuchiAutomaton<int, int>::isEmpty()
     accTrSet.insert({tr.from, tr.to});
   }
 
-  AutGraph gr(adjList, vrt, this->finals);
-  gr.computeSCCs(accTrSet);
-  set<int> fin;
-  for(auto s : gr.getFinalComponents())
+  Condensation cond(adjList);
+  cond.markAccepting(this->finals, accTrSet);
+  set<int> tmp = AutGraph::reachableVertices(adjList, this->getInitials());
+  for(int st : tmp)
   {
-    fin.insert(s.begin(), s.end());
+    if(cond.isAccepting(cond.getComponent(st)))
+      return false;
   }
-
-  set<int> in;
-  set<int> tmp = AutGraph::reachableVertices(adjList, this->getInitials());
-  set_intersection(fin.begin(), fin.end(), tmp.begin(), tmp.end(),
-    std::inserter(in, in.begin()));
-
-  if(in.size() > 0)
-    return false;
   return true;
 }
 
@@ -1598,106 +1632,73 @@ set<State> BuchiAutomaton<State, Symbol>::succSet(const set<State>& states, cons
 
 /*
  * Semideterminize the given automaton
+ * @param threads Number of threads expanding the macrostates
  * @return Modified structure with equivalent language
  */
 template <>
-BuchiAutomaton<StateSemiDet, APSymbol> BuchiAutomaton<int, APSymbol>::semideterminize()
+BuchiAutomaton<StateSemiDet, APSymbol> BuchiAutomaton<int, APSymbol>::semideterminize(unsigned threads)
 {
   /*
   TODO: add support for accepting transitions
   */
   assert(this->getFinTrans().size() == 0);
 
-  std::stack<StateSemiDet> stack;
-  set<StateSemiDet> comst;
-  set<StateSemiDet> initials;
-  set<StateSemiDet> finals;
-  //set<StateSch> succ;
-  set<APSymbol> alph = getAlphabet();
-  map<std::pair<StateSemiDet, APSymbol>, set<StateSemiDet> > mp;
-  map<std::pair<StateSemiDet, APSymbol>, set<StateSemiDet> >::iterator it;
-
-  for(const int& i : this->getInitials())
+  // successors of subsets are computed on dense sets (symbols are numbered)
+  map<APSymbol, int> symbols;
+  for(const APSymbol& sym : this->getAlphabet())
+    symbols.insert({sym, symbols.size()});
+  map<std::pair<int, int>, set<int>> numTrans;
+  for(const auto& tr : this->getTransitions())
   {
-    StateSemiDet init = {i, {set<int>(), set<int>()}, true};
-    stack.push(init);
-    comst.insert(init);
-    initials.insert(init);
+    assert(tr.first.first >= 0);
+    numTrans[{tr.first.first, symbols[tr.first.second]}] = tr.second;
   }
+  int stateCnt = this->states.size() > 0 ? *this->states.rbegin() + 1 : 0;
+  TransitionTable table(numTrans, stateCnt, symbols.size());
+  DenseSet fins(this->getFinals());
 
-  set<int> fins = this->getFinals();
-
-  set<int> ignore;
-  set<int> closingStates = this->getCycleClosingStates(ignore);
-
-  while(stack.size() > 0)
+  auto succ = [&symbols, &table, &fins](const StateSemiDet& st, const APSymbol& sym) -> vector<StateSemiDet>
   {
-    StateSemiDet st = stack.top();
-    stack.pop();
-
-    if(!st.isWaiting && st.tight.first == st.tight.second && st.tight.first.size() > 0)
-    {
-      finals.insert(st);
-    }
-
-    for(APSymbol const & sym : alph)
+    int symId = symbols.find(sym)->second;
+    vector<StateSemiDet> dst;
+    if(st.isWaiting)
     {
-      set<StateSemiDet> dst;
-      if(st.isWaiting)
+      for(int d : table.succ(st.waiting, symId))
       {
-        auto pr = std::make_pair(st.waiting, sym);
-        set<int> tmpDst = this->getTransitions()[pr];
-        for(const int& d : tmpDst)
-        {
-          StateSemiDet s1 = { d, {set<int>(), set<int>()}, true };
-          dst.insert(s1);
-
-          //if(closingStates.find(st.waiting) != closingStates.end())
-          {
-            StateSemiDet s2 = { -1, {set<int>({d}), set<int>()}, false };
-            dst.insert(s2);
-          }
-        }
+        dst.push_back({ d, {set<int>(), set<int>()}, true });
+        dst.push_back({ -1, {set<int>({d}), set<int>()}, false });
       }
-      else
-      {
-        if(st.tight.first != st.tight.second)
-        {
-          set<int> succ = succSet(st.tight.first, sym);
-          set<int> succ2;
-          std::set_intersection(succ.begin(), succ.end(), fins.begin(), fins.end(),
-            std::inserter(succ2, succ2.begin()));
-          set<int> tmpsucc = succSet(st.tight.second, sym);
-          succ2.insert(tmpsucc.begin(), tmpsucc.end());
-          StateSemiDet s = { -1, {succ, succ2}, false };
-          dst.insert(s);
-        }
-        else
-        {
-          set<int> succ = succSet(st.tight.first, sym);
-          set<int> succ2;
-          std::set_intersection(succ.begin(), succ.end(), fins.begin(), fins.end(),
-            std::inserter(succ2, succ2.begin()));
-          StateSemiDet s = { -1, {succ, succ2}, false };
-          dst.insert(s);
-        }
-      }
-
-      for(const StateSemiDet& d : dst)
-      {
-        if(comst.find(d) == comst.end())
-        {
-          stack.push(d);
-          comst.insert(d);
-        }
-      }
-      auto pr = std::make_pair(st, sym);
-      mp[pr] = dst;
+      return dst;
     }
-  }
 
-  return BuchiAutomaton<StateSemiDet, APSymbol>(comst, finals,
-    initials, mp, alph, this->getAPPattern());
+    DenseSet succ = table.succSet(DenseSet(st.tight.first), symId);
+    DenseSet succ2 = succ & fins;
+    if(st.tight.first != st.tight.second)
+      succ2 |= table.succSet(DenseSet(st.tight.second), symId);
+    dst.push_back({ -1, {succ.toSet(), succ2.toSet()}, false });
+    return dst;
+  };
+  auto acc = [](const StateSemiDet& st) -> bool
+  {
+    return !st.isWaiting && st.tight.first == st.tight.second && st.tight.first.size() > 0;
+  };
+  auto hash = [](const StateSemiDet& st) -> std::size_t
+  {
+    if(st.isWaiting)
+      return std::hash<int>()(st.waiting);
+    std::size_t h = DenseSet(st.tight.first).hash();
+    h ^= DenseSet(st.tight.second).hash() + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+  };
+
+  vector<StateSemiDet> init;
+  for(const int& i : this->getInitials())
+    init.push_back({i, {set<int>(), set<int>()}, true});
+
+  SubsetConstruction<StateSemiDet, APSymbol> constr(this->getAlphabet(), succ, acc, hash, threads);
+  auto ret = constr.construct(init);
+  ret.setAPPattern(this->getAPPattern());
+  return ret;
 }
 
 
@@ -1707,9 +1708,7 @@ BuchiAutomaton<int, int> BuchiAutomaton<int, int>::removeUselessRename()
   map<int, int> id;
   for(auto al : this->getAlphabet())
     id[al] = al;
-  BuchiAutomaton<int, int> renptr = this->renameAutDict(id);
-  renptr.removeUseless();
-  return renptr.renameAutDict(id);
+  return this->removeUselessRename(id);
 }
 
 
@@ -1719,22 +1718,52 @@ BuchiAutomaton<int, Symbol> BuchiAutomaton<State,Symbol>::reduce()
   //assert(!this->isTBA() && "Reduce not supported for TBAs");
   assert(this->directSim.size() > 0 && "Simulation is not computed");
 
+  vector<State> sts(this->states.begin(), this->states.end());
+  map<State, int> pos;
+  for(unsigned i = 0; i < sts.size(); i++)
+    pos[sts[i]] = i;
+
+  // classes of mutually simulating states
+  UnionFind uf(sts.size());
+  for(const auto& pr : this->directSim)
+  {
+    if(!(pr.first < pr.second) || this->directSim.find({pr.second, pr.first}) == this->directSim.end())
+      continue;
+    auto it1 = pos.find(pr.first);
+    auto it2 = pos.find(pr.second);
+    if(it1 != pos.end() && it2 != pos.end())
+      uf.unite(it1->second, it2->second);
+  }
+
+  // classes are numbered by their least states
   map<State, int> stmap;
-  set<set<State>> eqcl = Aux::getEqClasses(this->directSim, this->getStates());
+  map<int, int> clsId;
+  for(unsigned i = 0; i < sts.size(); i++)
+  {
+    auto it = clsId.insert({uf.find(i), clsId.size()}).first;
+    stmap[sts[i]] = it->second;
+  }
+  return this->quotient(stmap);
+}
+
 
+/*
+ * Collapse states into classes
+ * @param stmap Map assigning states their classes (numbered from 0 without
+ *        gaps)
+ * @return Quotient automaton (a transition is accepting if some of its
+ *         origins is accepting)
+ */
+template<typename State, typename Symbol>
+BuchiAutomaton<int, Symbol> BuchiAutomaton<State,Symbol>::quotient(map<State, int> stmap)
+{
   set<int> nst;
   set<int> nini;
   set<int> nfin;
   Delta<int, Symbol> ntr;
 
-  int i = 0;
-  for(const auto& cl : eqcl)
-  {
-    nst.insert(i);
-    for(const State& st : cl)
-      stmap[st] = i;
-    i++;
-  }
+  for(const auto& st : stmap)
+    nst.insert(st.second);
 
   nini = Aux::mapSet(stmap, this->initials);
   nfin = Aux::mapSet(stmap, this->finals);
@@ -20,6 +20,8 @@
 #include "../Complement/StateSch.h"
 #include "../Complement/StateSD.h"
 #include "../Algorithms/AuxFunctions.h"
+#include "../Algorithms/RankSimulation.h"
+#include "../Algorithms/UnionFind.h"
 #include "APSymbol.h"
 //#include "../Algorithms/Simulations.h"
 
@@ -47,6 +49,10 @@ struct Stat
   long duration = 0;
   string engine;
   std::map<std::set<int>, RankBound> ranks;
+  // rank successor cache
+  size_t rankCacheHits = 0;
+  size_t rankCacheMisses = 0;
+  size_t rankCacheEvictions = 0;
 
   // time
   std::chrono::time_point<std::chrono::high_resolution_clock> beginning;
@@ -113,11 +119,6 @@ protected:
   std::string toGraphwizWith(std::function<std::string(State)>& stateStr,  std::function<std::string(Symbol)>& symStr);
   std::string toGffWith(std::function<std::string(State)>& stateStr,  std::function<std::string(Symbol)>& symStr);
 
-  bool isRankLeq(std::set<State>& set1, std::set<State>& set2, StateRelation& rel);
-  bool deriveRankConstr(State& st1, State& st2, StateRelation& rel);
-  void propagateFwd(State& st1, State& st2, SetStates& set1, SetStates& set2,
-    StateRelation& rel,StateRelation& nw);
-  void transitiveClosure(StateRelation& rel, SetStates& cl);
 
 public:
   BuchiAutomaton(SetStates st, SetStates fin, SetStates ini, Transitions trans) : AutomatonStruct<State, Symbol>(st, ini, trans)
@@ -400,11 +401,21 @@ public:
     return this->finals;
   }
 
+  const SetStates& getFinals() const
+  {
+    return this->finals;
+  }
+
   VecTransG& getFinTrans()
   {
     return this->accTrans;
   }
 
+  const VecTransG& getFinTrans() const
+  {
+    return this->accTrans;
+  }
+
   void addStates(State state){
     this->states.insert(state);
   }
@@ -462,6 +473,7 @@ public:
   void removeUseless();
   void restriction(set<State>& st);
 
+  RankSimulation getRankSimulation();
   void computeRankSim(SetStates& cl);
   bool containsRankSimEq(SetStates& cl);
 
@@ -537,12 +549,14 @@ public:
   }
 
   BuchiAutomaton<int, int> copyStateAcc(int start);
-  BuchiAutomaton<StateSemiDet, Symbol> semideterminize();
+  BuchiAutomaton<StateSemiDet, Symbol> semideterminize(unsigned threads = 1);
   set<State> succSet(const set<State>& state, const Symbol& symbol);
 
   BuchiAutomaton<int, int> removeUselessRename();
+  BuchiAutomaton<int, int> removeUselessRename(map<Symbol, int>& mpsymbol);
 
   BuchiAutomaton<int, Symbol> reduce();
+  BuchiAutomaton<int, Symbol> quotient(map<State, int> stmap);
   BuchiAutomaton<int, Symbol> toTBA();
 
   BuchiAutomaton<int, APSymbol> toAPBA(map<int, string>& symName);
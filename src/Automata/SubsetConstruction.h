@@ -0,0 +1,158 @@
+#ifndef _SUBSET_CONSTRUCTION_H_
+#define _SUBSET_CONSTRUCTION_H_
+
+#include <set>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "BuchiAutomaton.h"
+#include "../Algorithms/ParallelExplorer.h"
+#include "../Complement/ComplProgress.h"
+
+/*
+ * Subset-style construction of an automaton over macrostates. The
+ * construction is parameterized by a policy: successors of a macrostate over
+ * a symbol, accepting macrostates and a hash of macrostates (consistent with
+ * the equivalence given by State::operator<). Macrostates are deduplicated in
+ * a hashed table, the frontier is expanded by several threads (successors are
+ * computed in parallel, only interning of the successors is serialized). The
+ * result does not depend on the number of threads. The policy functions have
+ * to be safe to call concurrently if more threads are used.
+ */
+template <typename State, typename Symbol>
+class SubsetConstruction
+{
+public:
+  typedef uint32_t StateId;
+  typedef std::function<std::vector<State>(const State&, const Symbol&)> SuccFunc;
+  typedef std::function<bool(const State&)> AccFunc;
+  typedef std::function<std::size_t(const State&)> HashFunc;
+
+private:
+  struct Hasher
+  {
+    const HashFunc* func;
+    std::size_t operator()(const State& st) const { return (*func)(st); }
+  };
+
+  struct Equiv
+  {
+    bool operator()(const State& st1, const State& st2) const
+    {
+      return !(st1 < st2) && !(st2 < st1);
+    }
+  };
+
+  std::set<Symbol> alph;
+  SuccFunc succFunc;
+  AccFunc accFunc;
+  HashFunc hashFunc;
+  unsigned threads;
+
+  std::unordered_map<State, StateId, Hasher, Equiv> ids;
+  std::vector<State> states;
+  std::vector<bool> accepting;
+  std::vector<std::map<Symbol, std::vector<StateId>>> succs;
+
+  std::pair<StateId, bool> intern(const State& st)
+  {
+    auto ins = this->ids.insert({st, (StateId)this->states.size()});
+    if(ins.second)
+    {
+      this->states.push_back(st);
+      this->accepting.push_back(false);
+      this->succs.emplace_back();
+    }
+    return {ins.first->second, ins.second};
+  }
+
+public:
+  SubsetConstruction(const std::set<Symbol>& alph, SuccFunc succFunc, AccFunc accFunc,
+    HashFunc hashFunc, unsigned threads = 1) : alph(alph), succFunc(succFunc),
+    accFunc(accFunc), hashFunc(hashFunc), threads(threads),
+    ids(64, Hasher{&this->hashFunc}, Equiv()), states(), accepting(), succs() { }
+
+  SubsetConstruction(const SubsetConstruction&) = delete;
+  SubsetConstruction& operator=(const SubsetConstruction&) = delete;
+
+  /*
+   * Construct the automaton reachable from the initial macrostates
+   * @param init Initial macrostates
+   * @return Constructed automaton (over the alphabet of the construction)
+   */
+  BuchiAutomaton<State, Symbol> construct(const std::vector<State>& init)
+  {
+    typedef std::pair<StateId, State> Item;
+
+    this->ids.clear();
+    this->states.clear();
+    this->accepting.clear();
+    this->succs.clear();
+
+    std::set<State> initials;
+    ParallelExplorer<Item> explorer(this->threads);
+    for(const State& st : init)
+    {
+      auto ins = intern(st);
+      initials.insert(st);
+      if(ins.second)
+        explorer.push({ins.first, st});
+    }
+
+    std::mutex storeLock;
+    ComplProgress* progress = ComplProgress::getActive();
+    explorer.run([&](unsigned, Item& item, std::vector<Item>& out)
+    {
+      std::vector<std::pair<Symbol, std::vector<State>>> succ;
+      for(const Symbol& sym : this->alph)
+        succ.push_back({sym, this->succFunc(item.second, sym)});
+      bool acc = this->accFunc(item.second);
+
+      std::lock_guard<std::mutex> guard(storeLock);
+      this->accepting[item.first] = acc;
+      for(const auto& s : succ)
+      {
+        std::vector<StateId> dst;
+        for(const State& d : s.second)
+        {
+          auto ins = intern(d);
+          dst.push_back(ins.first);
+          if(ins.second)
+          {
+            out.push_back({ins.first, d});
+            if(progress != nullptr)
+              progress->update(this->states.size());
+          }
+        }
+        this->succs[item.first][s.first] = std::move(dst);
+      }
+    });
+
+    std::set<State> resStates(this->states.begin(), this->states.end());
+    std::set<State> resFinals;
+    std::map<std::pair<State, Symbol>, std::set<State>> resTrans;
+    for(StateId i = 0; i < this->states.size(); i++)
+    {
+      if(this->accepting[i])
+        resFinals.insert(this->states[i]);
+      for(const auto& t : this->succs[i])
+      {
+        std::set<State>& dst = resTrans[{this->states[i], t.first}];
+        for(StateId d : t.second)
+          dst.insert(this->states[d]);
+      }
+    }
+    return BuchiAutomaton<State, Symbol>(resStates, resFinals, initials, resTrans, this->alph);
+  }
+
+  /*
+   * Number of macrostates of the last construction
+   */
+  size_t size() const { return this->states.size(); }
+};
+
+#endif
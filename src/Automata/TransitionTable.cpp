@@ -0,0 +1,67 @@
+#include "TransitionTable.h"
+
+/*
+ * Build the table from a transition function.
+ * @param trans Transition function (states and symbols numbered from 0)
+ * @param states Number of states
+ * @param symbols Number of symbols
+ */
+TransitionTable::TransitionTable(const map<pair<int, int>, set<int>>& trans,
+  int states, int symbols) : stateCount(states), symbolCount(symbols),
+  offsets(states*symbols + 1, 0), targets()
+{
+  for(const auto& tr : trans)
+  {
+    if(tr.first.first >= states || tr.first.second >= symbols)
+      continue;
+    offsets[tr.first.first*symbols + tr.first.second + 1] += tr.second.size();
+  }
+  for(unsigned i = 1; i < offsets.size(); i++)
+    offsets[i] += offsets[i-1];
+
+  targets.resize(offsets.back());
+  for(const auto& tr : trans)
+  {
+    if(tr.first.first >= states || tr.first.second >= symbols)
+      continue;
+    unsigned pos = offsets[tr.first.first*symbols + tr.first.second];
+    for(int d : tr.second)
+      targets[pos++] = d;
+  }
+}
+
+
+/*
+ * Set of all successors.
+ * @param states Set of states to get successors
+ * @param symbol Symbol
+ * @return Set of successors over symbol
+ */
+DenseSet TransitionTable::succSet(const DenseSet& states, int symbol) const
+{
+  DenseSet ret;
+  for(int st : states)
+  {
+    for(int d : succ(st, symbol))
+      ret.insert(d);
+  }
+  return ret;
+}
+
+
+/*
+ * Set of all successors.
+ * @param states Set of states to get successors
+ * @param symbol Symbol
+ * @return Set of successors over symbol
+ */
+set<int> TransitionTable::succSet(const set<int>& states, int symbol) const
+{
+  set<int> ret;
+  for(int st : states)
+  {
+    Range dst = succ(st, symbol);
+    ret.insert(dst.begin(), dst.end());
+  }
+  return ret;
+}
@@ -0,0 +1,72 @@
+#ifndef _TRANSITION_TABLE_H_
+#define _TRANSITION_TABLE_H_
+
+#include <set>
+#include <map>
+#include <vector>
+
+#include "../Algorithms/DenseSet.h"
+
+using std::vector;
+using std::set;
+using std::map;
+using std::pair;
+
+/*
+ * Frozen transition function of an automaton with states and symbols
+ * numbered from 0 (compressed sparse row format). Successors of a pair
+ * (state, symbol) are stored contiguously, the position of the pair is
+ * state*symbols + symbol. The table is built once
+ * from the map-based transition function and it is not updated when the
+ * original automaton changes.
+ */
+class TransitionTable
+{
+public:
+  /*
+   * Contiguous (sorted) range of states
+   */
+  struct Range
+  {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    unsigned size() const { return last - first; }
+    bool empty() const { return first == last; }
+  };
+
+private:
+  int stateCount;
+  int symbolCount;
+  vector<unsigned> offsets;
+  vector<int> targets;
+
+public:
+  TransitionTable() : stateCount(0), symbolCount(0), offsets(1, 0), targets() { }
+  TransitionTable(const map<pair<int, int>, set<int>>& trans, int states, int symbols);
+
+  /*
+   * Successors of a state over a symbol
+   * @param state State
+   * @param symbol Symbol
+   * @return Range of successors
+   */
+  Range succ(int state, int symbol) const
+  {
+    if(state < 0 || state >= stateCount || symbol < 0 || symbol >= symbolCount)
+      return { nullptr, nullptr };
+    unsigned pos = state*symbolCount + symbol;
+    return { targets.data() + offsets[pos], targets.data() + offsets[pos + 1] };
+  }
+
+  DenseSet succSet(const DenseSet& states, int symbol) const;
+  set<int> succSet(const set<int>& states, int symbol) const;
+
+  int getStateCount() const { return stateCount; }
+  int getSymbolCount() const { return symbolCount; }
+  unsigned getTransitionCount() const { return targets.size(); }
+};
+
+#endif
@@ -0,0 +1,157 @@
+
+#include "AutomatonAnalysis.h"
+
+/*
+ * Get the condensation of the automaton graph
+ * @return Condensation (components are marked as deterministic)
+ */
+const Condensation& AutomatonAnalysis::getCondensation()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->condensation)
+    this->condensation = this->aut.getCondensation();
+  return *this->condensation;
+}
+
+
+const std::vector<SccClassif>& AutomatonAnalysis::getSccClassesUnlocked()
+{
+  if(!this->sccClasses)
+    this->sccClasses = this->aut.sccClassification();
+  return *this->sccClasses;
+}
+
+
+/*
+ * Get classified SCCs (deterministic, nondeterministic, inherently weak)
+ * @return SCCs in a topological order
+ */
+const std::vector<SccClassif>& AutomatonAnalysis::getSccClasses()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  return getSccClassesUnlocked();
+}
+
+
+/*
+ * Get elevator rank bounds of states
+ * @param detBeginning Deterministic/inherently weak beginning
+ * @return Map assigning states their rank bounds
+ */
+const std::map<int, int>& AutomatonAnalysis::elevatorRank(bool detBeginning)
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  auto it = this->elevatorRanks.find(detBeginning);
+  if(it == this->elevatorRanks.end())
+  {
+    it = this->elevatorRanks.insert({detBeginning,
+      this->aut.elevatorRank(detBeginning, getSccClassesUnlocked())}).first;
+  }
+  return it->second;
+}
+
+
+unsigned AutomatonAnalysis::elevatorStates()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->elevatorStateCount)
+    this->elevatorStateCount = this->aut.elevatorStates();
+  return *this->elevatorStateCount;
+}
+
+
+bool AutomatonAnalysis::isElevator()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->elevator)
+    this->elevator = this->aut.isElevator(getSccClassesUnlocked());
+  return *this->elevator;
+}
+
+
+bool AutomatonAnalysis::isInherentlyWeakBA()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->inhWeak)
+    this->inhWeak = this->aut.isInherentlyWeakBA(getSccClassesUnlocked());
+  return *this->inhWeak;
+}
+
+
+bool AutomatonAnalysis::isSemiDeterministic()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->semiDet)
+    this->semiDet = this->aut.isSemiDeterministic();
+  return *this->semiDet;
+}
+
+
+bool AutomatonAnalysis::isDeterministic()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->det)
+    // isDeterministic of the automaton is hidden by the check of SCCs
+    this->det = this->aut.BuchiAutomaton<int, int>::isDeterministic();
+  return *this->det;
+}
+
+
+bool AutomatonAnalysis::isComplete()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->complete)
+    this->complete = this->aut.isComplete();
+  return *this->complete;
+}
+
+
+/*
+ * Get the reachability index of the automaton
+ * @return Reachability of states
+ */
+const Reachability& AutomatonAnalysis::getReachability()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  if(!this->reach)
+    this->reach = this->aut.getReachability();
+  return *this->reach;
+}
+
+
+/*
+ * Copy accepting SCCs satisfying a predicate (see
+ * ElevatorAutomaton::copyPreprocessing)
+ * @param pred Predicate on SCCs
+ * @return Preprocessed automaton
+ */
+BuchiAutomaton<int, int> AutomatonAnalysis::copyPreprocessing(const std::function<bool(SccClassif)>& pred)
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  return this->aut.copyPreprocessing(pred, getSccClassesUnlocked());
+}
+
+
+/*
+ * Determinize the initial part of the automaton (see
+ * ElevatorAutomaton::nondetInitDeterminize)
+ * @return Automaton with the determinized initial part
+ */
+BuchiAutomaton<int, int> AutomatonAnalysis::nondetInitDeterminize()
+{
+  const std::map<int, int>& ranks = elevatorRank(false);
+  std::lock_guard<std::mutex> guard(this->lock);
+  return this->aut.nondetInitDeterminize(getSccClassesUnlocked(), ranks);
+}
+
+
+/*
+ * Propagate accepting states inside SCCs (see
+ * ElevatorAutomaton::propagateAccStates)
+ * @return Automaton with propagated accepting states
+ */
+BuchiAutomaton<int, int> AutomatonAnalysis::propagateAccStates()
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+  return this->aut.propagateAccStates(getSccClassesUnlocked());
+}
@@ -0,0 +1,65 @@
+#ifndef _AUTOMATON_ANALYSIS_H_
+#define _AUTOMATON_ANALYSIS_H_
+
+#include <set>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <optional>
+#include <functional>
+
+#include "../Automata/BuchiAutomaton.h"
+#include "../Automata/AutGraph.h"
+#include "ElevatorAutomaton.h"
+
+/*
+ * Structural facts about a prepared automaton (states numbered from 0 with
+ * no gaps) shared by all phases of a run. Each fact is computed on the first
+ * request and kept for the following ones. The automaton is copied when the
+ * analysis is created, later changes of the original automaton are not
+ * reflected. Requests may come from several threads.
+ */
+class AutomatonAnalysis
+{
+private:
+  ElevatorAutomaton aut;
+  std::mutex lock;
+
+  std::optional<Condensation> condensation;
+  std::optional<std::vector<SccClassif>> sccClasses;
+  std::map<bool, std::map<int, int>> elevatorRanks;
+  std::optional<unsigned> elevatorStateCount;
+  std::optional<bool> elevator;
+  std::optional<bool> inhWeak;
+  std::optional<bool> semiDet;
+  std::optional<bool> det;
+  std::optional<bool> complete;
+  std::optional<Reachability> reach;
+
+  const std::vector<SccClassif>& getSccClassesUnlocked();
+
+public:
+  AutomatonAnalysis(BuchiAutomaton<int, int>& t) : aut(t), lock(), condensation(),
+    sccClasses(), elevatorRanks(), elevatorStateCount(), elevator(), inhWeak(), semiDet(),
+    det(), complete(), reach() { }
+
+  AutomatonAnalysis(const AutomatonAnalysis&) = delete;
+  AutomatonAnalysis& operator=(const AutomatonAnalysis&) = delete;
+
+  const Condensation& getCondensation();
+  const std::vector<SccClassif>& getSccClasses();
+  const std::map<int, int>& elevatorRank(bool detBeginning);
+  unsigned elevatorStates();
+  bool isElevator();
+  bool isInherentlyWeakBA();
+  bool isSemiDeterministic();
+  bool isDeterministic();
+  bool isComplete();
+  const Reachability& getReachability();
+
+  BuchiAutomaton<int, int> copyPreprocessing(const std::function<bool(SccClassif)>& pred);
+  BuchiAutomaton<int, int> nondetInitDeterminize();
+  BuchiAutomaton<int, int> propagateAccStates();
+};
+
+#endif
@@ -56,10 +56,10 @@ set<StateKV> BuchiAutomatonSpec::succSetKV(StateKV& state, int symbol)
  * @param states Set of states in a macrostate (the S-set)
  * @return Rank restriction
  */
-RankConstr BuchiAutomatonSpec::rankConstr(vector<int>& max, set<int>& states)
+RankConstr BuchiAutomatonSpec::rankConstr(const vector<int>& max, const set<int>& states) const
 {
   RankConstr constr;
-  set<int> fin = getFinals();
+  const set<int>& fin = getFinals();
   char inc = 1;
   for(int st : states)
   {
@@ -182,10 +182,10 @@ void BuchiAutomatonSpec::getSchRanksTight(vector<RankFunc>& out, vector<int>& ma
     constr.push_back(singleConst);
   }
 
-  auto tmp = RankFunc::tightSuccFromRankConstr(constr, dirRel, oddRel, macrostate.f.getMaxRank(),
-    reachCons, reachMax, true);
-  RankFunc sng(sngmap, true);
-  if(sng.isTightRank() && sng.getMaxRank() == macrostate.f.getMaxRank() && tmp.size() > 0)
+  // only the existence of some tight successor is needed
+  RankFuncEnumerator en(constr, dirRel, oddRel, macrostate.f.getMaxRank(), reachCons, reachMax);
+  RankFunc sng(sngmap);
+  if(sng.isTightRank() && sng.getMaxRank() == macrostate.f.getMaxRank() && en.exists())
     out = vector<RankFunc>({sng});
   else
   {
@@ -227,7 +227,7 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStart(set<int>& state, int rankBo
 
   int reachMaxAct = maxReach[sprime];
   RankConstr constr = rankConstr(maxRank, sprime);
-  for(const RankFunc& item : RankFunc::tightFromRankConstr(constr, dirRel, oddRel, reachCons, reachMaxAct, true))
+  for(const RankFunc& item : RankFunc::tightFromRankConstr(constr, dirRel, oddRel, -1, reachCons, reachMaxAct))
   {
     ret.push_back({sprime, set<int>(), item, 0, true});
   }
@@ -236,31 +236,58 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStart(set<int>& state, int rankBo
 
 
 /*
- * Get all ranking functions (use cache memory)
- * @param out Out parameter to store tight ranks
- * @param state Schewe state (macrostate)
- * @param symbol Symbol
- * @return Is successor found in cache?
+ * Build the context of successor functions of the tight part from the
+ * current rank bounds
+ * @param reachCons SuccRank restriction
+ * @param maxReach Maximum reachable macrostate
+ * @return Successor context
  */
-bool BuchiAutomatonSpec::getRankSuccCache(vector<RankFunc>& out, StateSch& state, int symbol)
+SuccContext BuchiAutomatonSpec::createSuccContext(const map<int, int>& reachCons,
+  const map<DFAState, int>& maxReach) const
 {
-  auto it = this->rankCache.find({state.S, symbol, state.f.getMaxRank()});
-  if(it == this->rankCache.end())
+  SuccContext ctx(this->transTable.getStateCount(), this->transTable.getSymbolCount());
+  ctx.finals = DenseSet(this->getFinals());
+  ctx.reachCons = reachCons;
+
+  for(const auto& p : reachCons)
   {
-    this->rankCache[{state.S, symbol, state.f.getMaxRank()}] = vector<std::pair<RankFunc, vector<RankFunc>>>();
+    if(p.first >= 0 && p.first < ctx.states)
+      ctx.minReach[p.first] = p.second;
   }
-  else
+  const VecTrans<int, int>& accTrans = this->getFinTrans();
+  if(!accTrans.empty())
   {
-    for(auto& item : it->second)
+    ctx.accTargets.resize(ctx.states*ctx.symbols);
+    for(const auto& tr : accTrans)
     {
-      if(state.f.isAllLeq(item.first))
-      {
-        out = item.second;
-        return true;
-      }
+      if(tr.from < ctx.states && tr.symbol < ctx.symbols)
+        ctx.accTargets[tr.from*ctx.symbols + tr.symbol].insert(tr.to);
     }
   }
-  return false;
+  for(const auto& p : maxReach)
+    ctx.maxReach[DenseSet(p.first)] = p.second;
+  for(const auto& p : this->rankBound)
+    ctx.rankBound[DenseSet(p.first)] = p.second;
+  return ctx;
+}
+
+
+/*
+ * Store counters of rank successor caches of a run
+ * @param stats Statistical information
+ * @param caches Caches used in the run
+ */
+void BuchiAutomatonSpec::setCacheStats(Stat *stats, const vector<RankSuccCache>& caches)
+{
+  stats->rankCacheHits = 0;
+  stats->rankCacheMisses = 0;
+  stats->rankCacheEvictions = 0;
+  for(const RankSuccCache& cache : caches)
+  {
+    stats->rankCacheHits += cache.getHits();
+    stats->rankCacheMisses += cache.getMisses();
+    stats->rankCacheEvictions += cache.getEvictions();
+  }
 }
 
 
@@ -272,10 +299,12 @@ bool BuchiAutomatonSpec::getRankSuccCache(vector<RankFunc>& out, StateSch& state
  * @param reachMax Maximum reachable macrostate
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
+ * @param cache Rank successor cache of the run
  * @return Set of all successors
  */
 vector<StateSch> BuchiAutomatonSpec::succSetSchTight(StateSch& state, int symbol,
-    map<int, int> reachCons, map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel)
+    map<int, int> reachCons, map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel,
+    RankSuccCache& cache)
 {
   vector<StateSch> ret;
   set<int> sprime;
@@ -342,11 +371,11 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTight(StateSch& state, int symbol
   vector<RankFunc> tmp;
   set<int> inverseRank;
 
-  if(!getRankSuccCache(tmp, state, symbol))
+  if(!cache.lookup(tmp, state.S, symbol, state.f))
   {
     getSchRanksTight(tmp, maxRank, sprime, state,
         reachCons, maxReachAct, dirRel, oddRel);
-    this->rankCache[{state.S, symbol, state.f.getMaxRank()}].push_back({state.f, tmp});
+    cache.insert(state.S, symbol, state.f, tmp);
   }
 
   for (auto& r : tmp)
@@ -372,16 +401,35 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTight(StateSch& state, int symbol
  * @return Backward representation of rel
  */
 BackRel BuchiAutomatonSpec::createBackRel(BuchiAutomaton<int, int>::StateRelation& rel)
+{
+  return createBackRel(BitRelation(rel, this->getStates().size()));
+}
+
+/*
+ * Create backward relation from a relation (special representation). For
+ * each state q, the backward relation contains smaller states p related
+ * with q: (p, false) if (p, q) is in the relation and (p, true) if (q, p) is
+ * in the relation.
+ * @param rel Relation between states (bit matrix)
+ * @return Backward representation of rel
+ */
+BackRel BuchiAutomatonSpec::createBackRel(const BitRelation& rel)
 {
   BackRel bRel(this->getStates().size());
-  for(auto p : rel)
+  for(int q = 0; q < rel.size() && q < (int)bRel.size(); q++)
   {
-    if(p.first == p.second)
-      continue;
-    if(p.first <= p.second)
-      bRel[p.second].push_back({p.first, false});
-    else
-      bRel[p.first].push_back({p.second, true});
+    for(int p : rel.col(q))
+    {
+      if(p >= q)
+        break;
+      bRel[q].push_back({p, false});
+    }
+    for(int p : rel.row(q))
+    {
+      if(p >= q)
+        break;
+      bRel[q].push_back({p, true});
+    }
   }
   return bRel;
 }
@@ -440,6 +488,7 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSch()
 
   BackRel dirRel = createBackRel(this->getDirectSim());
   BackRel oddRel = createBackRel(this->getOddRankSim());
+  RankSuccCache cache(this->opt.CacheMemory);
 
   bool cnt = true;
 
@@ -457,12 +506,13 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSch()
       //set<StateSch> dst;
       if(st.tight)
       {
-        succ = succSetSchTight(st, sym, reachCons, maxReach, dirRel, oddRel);
+        succ = succSetSchTight(st, sym, reachCons, maxReach, dirRel, oddRel, cache);
         //succ = set<StateSch>();
       }
       else
       {
-        succ = succSetSchStart(st.S, rankBound[st.S].bound, reachCons, maxReach, dirRel, oddRel);
+        DFAState macrostate = st.S;
+        succ = succSetSchStart(macrostate, rankBound[macrostate].bound, reachCons, maxReach, dirRel, oddRel);
         cnt = false;
       }
       for (const StateSch& s : succ)
@@ -491,24 +541,25 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSch()
  * @param max Vector of maximal ranks (indexed by states)
  * @param states Set of states in a macrostate (the S-set)
  * @param macrostate Current macrostate
- * @param reachCons SuccRank restriction
+ * @param ctx Successor context
  * @param reachMax Maximum reachable macrostate
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
+ * @param cache Rank successor cache of the run
  */
-void BuchiAutomatonSpec::getSchRanksTightReduced(vector<RankFunc>& out, vector<int>& max,
-    set<int>& states, int symbol, StateSch& macrostate,
-    map<int, int> reachCons, int reachMax, BackRel& dirRel, BackRel& oddRel)
+void BuchiAutomatonSpec::getSchRanksTightReduced(vector<RankFunc>& out, const vector<int>& max,
+    const set<int>& states, int symbol, const StateSch& macrostate,
+    const SuccContext& ctx, int reachMax, const BackRel& dirRel, const BackRel& oddRel,
+    RankSuccCache& cache) const
 {
   RankConstr constr;
   map<int, int> sngmap;
 
-  set<int> fin = getFinals();
   vector<int> rnkBnd;
   for(int st : states)
   {
     vector<std::pair<int, int> > singleConst;
-    if(fin.find(st) == fin.end() /*max[st] % 2 != 0*/)
+    if(!ctx.finals.contains(st) /*max[st] % 2 != 0*/)
     {
       for(int i = 0; i < max[st]; i+= 1)
         singleConst.push_back(std::make_pair(st, i));
@@ -528,13 +579,13 @@ void BuchiAutomatonSpec::getSchRanksTightReduced(vector<RankFunc>& out, vector<i
   vector<RankFunc> tmp;
   int rankSetSize = 1;
 
-  if(this->opt.succEmptyCheck && macrostate.S.size() <= this->opt.CacheMaxState && macrostate.f.getMaxRank() <= this->opt.CacheMaxRank)
+  if(this->opt.succEmptyCheck)
   {
-    if(!getRankSuccCache(tmp, macrostate, symbol))
+    if(!cache.lookup(tmp, macrostate.S, symbol, macrostate.f))
     {
-      tmp = RankFunc::tightSuccFromRankConstr(constr, dirRel, oddRel, macrostate.f.getMaxRank(),
-        reachCons, reachMax, this->opt.cutPoint);
-      this->rankCache[{macrostate.S, symbol, macrostate.f.getMaxRank()}].push_back({macrostate.f, tmp});
+      tmp = RankFunc::tightFromRankConstr(constr, dirRel, oddRel, macrostate.f.getMaxRank(),
+        ctx.reachCons, reachMax);
+      cache.insert(macrostate.S, symbol, macrostate.f, tmp);
       rankSetSize = tmp.size();
     }
     else
@@ -550,14 +601,15 @@ void BuchiAutomatonSpec::getSchRanksTightReduced(vector<RankFunc>& out, vector<i
 
   if(this->opt.lowrankopt)
   {
-    auto stateBound = this->rankBound[states].stateBound;
+    const map<int, int>& stateBound = ctx.getRankBound(states).stateBound;
     for(const auto & s : states)
     {
-      sngmap[s] = std::min(sngmap[s], stateBound[s]);
+      auto it = stateBound.find(s);
+      sngmap[s] = std::min(sngmap[s], it != stateBound.end() ? it->second : 0);
     }
   }
 
-  RankFunc sng(sngmap, this->opt.cutPoint);
+  RankFunc sng(sngmap);
   if(sng.isTightRank() && sng.getMaxRank() == macrostate.f.getMaxRank() && rankSetSize > 0)
     out = vector<RankFunc>({sng});
   else
@@ -571,26 +623,21 @@ void BuchiAutomatonSpec::getSchRanksTightReduced(vector<RankFunc>& out, vector<i
  * Get all Schewe successros (optimized version)
  * @param state Schewe state
  * @param symbol Symbol
- * @param reachCons SuccRank restriction
- * @param reachMax Maximum reachable macrostate
+ * @param ctx Successor context
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
+ * @param cache Rank successor cache of the run
  * @return Set of all successors
  */
-vector<StateSch> BuchiAutomatonSpec::succSetSchTightReduced(StateSch& state, int symbol,
-    map<int, int> reachCons, map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel, set<int> finals)
+vector<StateSch> BuchiAutomatonSpec::succSetSchTightReduced(const StateSch& state, int symbol,
+    const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel,
+    RankSuccCache& cache) const
 {
   vector<StateSch> ret;
   set<int> sprime;
-  set<int> oprime;
+  DenseSet oprime;
   int iprime;
-  vector<int> maxRank(getStates().size(), state.f.getMaxRank());
-  map<int, set<int> > succ;
-  map<int, bool > pre;
-  VecTrans<int, int> accTrans = this->getFinTrans();
-
-  this->setFinals(finals);
-  auto fin = getFinals();
+  vector<int> maxRank(ctx.states, state.f.getMaxRank());
 
   if(this->opt.complete)
   {
@@ -603,42 +650,34 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightReduced(StateSch& state, int
 
   for(int st : state.S)
   {
-    set<int> dst = getTransitions()[std::make_pair(st, symbol)];
+    TransitionTable::Range dst = this->transTable.succ(st, symbol);
+    int rank = state.f[st];
     for(int d : dst)
     {
-      Transition<int, int> tr = { .from = st, .to = d, .symbol = symbol};
-      if(std::find(accTrans.begin(), accTrans.end(), tr) != accTrans.end() )
-        maxRank[d] = std::min(maxRank[d], BuchiAutomatonSpec::evenceil(state.f[st]));
+      if(ctx.isAccepting(st, symbol, d))
+        maxRank[d] = std::min(maxRank[d], BuchiAutomatonSpec::evenceil(rank));
       else
-        maxRank[d] = std::min(maxRank[d], state.f[st]);
+        maxRank[d] = std::min(maxRank[d], rank);
     }
     sprime.insert(dst.begin(), dst.end());
-    if(fin.find(st) == fin.end())
-      succ[st] = dst;
-
   }
 
   // if(this->opt.lowrankopt)
   // {
-  //   RankFunc ubound(this->rankBound[state.S].stateBound, false);
+  //   RankFunc ubound(this->rankBound[state.S].stateBound);
   //   if(!state.f.isAllLeq(ubound))
   //     return ret;
   // }
 
-  if(this->rankBound[state.S].bound < state.f.getMaxRank() || this->rankBound[sprime].bound < state.f.getMaxRank())
+  DenseSet sprimeSet(sprime);
+  if(ctx.getRankBound(state.S).bound < state.f.getMaxRank() || ctx.getRankBound(sprimeSet).bound < state.f.getMaxRank())
   {
     return ret;
   }
 
-  vector<int> rnkBnd;
-  for(int i : sprime)
-  {
-    rnkBnd.push_back(maxRank[i]);
-  }
-
   for(int st : sprime)
   {
-    if(fin.find(st) != fin.end() && maxRank[st] % 2 != 0)
+    if(ctx.finals.contains(st) && maxRank[st] % 2 != 0)
       maxRank[st] -= 1;
   }
   if(state.O.size() == 0)
@@ -648,44 +687,37 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightReduced(StateSch& state, int
   else
   {
     iprime = state.i;
-    oprime = succSet(state.O, symbol);
+    oprime = this->transTable.succSet(state.O, symbol);
   }
 
-  int maxReachAct = maxReach[sprime];
-  set<int> inverseRank;
+  int maxReachAct = ctx.getMaxReach(sprimeSet);
   vector<RankFunc> maxRanks;
 
   getSchRanksTightReduced(maxRanks, maxRank, sprime, symbol, state,
-      reachCons, maxReachAct, dirRel, oddRel);
+      ctx, maxReachAct, dirRel, oddRel, cache);
 
+  const DenseSet& finSet = ctx.finals;
   for (auto& r : maxRanks)
   {
-    set<int> oprime_tmp;
+    DenseSet oprime_tmp;
     if(this->opt.cutPoint)
     {
-      inverseRank = r.inverseRank(iprime);
+      DenseSet inverseRank(r.inverseRank(iprime));
       if (state.O.size() == 0)
         oprime_tmp = inverseRank;
       else
-        std::set_intersection(oprime.begin(),oprime.end(),inverseRank.begin(),
-          inverseRank.end(), std::inserter(oprime_tmp, oprime_tmp.begin()));
+        oprime_tmp = oprime & inverseRank;
     }
     else
     {
-      auto odd = r.getOddStates();
+      DenseSet odd(r.getOddStates());
       if (state.O.size() == 0)
-      {
-        std::set_difference(sprime.begin(), sprime.end(), odd.begin(), odd.end(),
-          std::inserter(oprime_tmp, oprime_tmp.begin()));
-      }
+        oprime_tmp = sprimeSet - odd;
       else
-      {
-        std::set_difference(oprime.begin(), oprime.end(), odd.begin(), odd.end(),
-          std::inserter(oprime_tmp, oprime_tmp.begin()));
-      }
+        oprime_tmp = oprime - odd;
       iprime = 0;
     }
-    ret.push_back({sprime, oprime_tmp, r, iprime, true});
+    ret.push_back({sprimeSet, oprime_tmp, r, iprime, true});
   }
 
   set<StateSch> retAll;
@@ -694,44 +726,40 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightReduced(StateSch& state, int
     retAll.insert(st);
     map<int, int> rnkMap((map<int, int>)st.f);
 
-    if (this->opt.eta4){
-      SCC intersection;
-      std::set_intersection(st.S.begin(), st.S.end(), fin.begin(), fin.end(), std::inserter(intersection, intersection.begin()));
-      if (intersection.size() == 0)
-        continue;
-    }
+    if (this->opt.eta4 && !st.S.intersects(finSet))
+      continue;
 
     if(state.O.size() == 0)
       continue;
     if(this->opt.cutPoint)
     {
-      set<int> no;
+      DenseSet no;
       if(st.i != 0 || st.O.size() == 0)
       {
         for(int o : st.O)
         {
-          if(rnkMap[o] > 0 && fin.find(o) == fin.end())
+          if(rnkMap[o] > 0 && !finSet.contains(o))
             rnkMap[o]--; // = std::min(rnkMap[o] - 1, stateBound[o]);
           else
             no.insert(o);
         }
-        retAll.insert({st.S, no, RankFunc(rnkMap, this->opt.cutPoint), st.i, true});
+        retAll.insert({st.S, no, RankFunc(rnkMap), st.i, true});
       }
     }
     else
     {
-      set<int> no;
+      DenseSet no;
       //bool cnt = true;
       for(int o : st.O)
       {
-        if(rnkMap[o] > 0 && fin.find(o) == fin.end())
+        if(rnkMap[o] > 0 && !finSet.contains(o))
           rnkMap[o]--;
         else
           no.insert(o);
       }
       // if(!cnt)
       //   continue;
-      retAll.insert({st.S, no, RankFunc(rnkMap, this->opt.cutPoint), st.i, true});
+      retAll.insert({st.S, no, RankFunc(rnkMap), st.i, true});
     }
   }
 
@@ -743,29 +771,25 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightReduced(StateSch& state, int
  * Get starting states of the tight part (optimized version)
  * @param state DFA macrostate
  * @param rankBound Maximum rank
- * @param reachCons SuccRank restriction
- * @param maxReach Maximum reachable macrostate
+ * @param ctx Successor context
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
  * @return Set of first states in the tight part (optimized version)
  */
-vector<StateSch> BuchiAutomatonSpec::succSetSchStartReduced(set<int>& state, int rankBound,
-    map<int, int> reachCons, map<DFAState, int> maxReach, BackRel& dirRel,
-    BackRel& oddRel, set<int> finals)
+vector<StateSch> BuchiAutomatonSpec::succSetSchStartReduced(const set<int>& state, int rankBound,
+    const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel) const
 {
   vector<StateSch> ret;
-  set<int> sprime = state;
-  set<int> schfinal;
-  this->setFinals(finals);
-  set<int> fin = getFinals();
-  std::set_difference(sprime.begin(),sprime.end(),fin.begin(),
-    fin.end(), std::inserter(schfinal, schfinal.begin()));
-  int m = std::min((int)(2*schfinal.size() - 1), rankBound);
-  vector<int> maxRank(getStates().size(), m);
+  const set<int>& sprime = state;
+  DenseSet sprimeSet(sprime);
+  const DenseSet& fin = ctx.finals;
+  int schfinal = (sprimeSet - fin).size();
+  int m = std::min((int)(2*schfinal - 1), rankBound);
+  vector<int> maxRank(ctx.states, m);
 
   for(int st : sprime)
   {
-    if(fin.find(st) != fin.end() && maxRank[st] % 2 != 0)
+    if(fin.contains(st) && maxRank[st] % 2 != 0)
       maxRank[st] -= 1;
   }
 
@@ -776,10 +800,11 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStartReduced(set<int>& state, int
   vector<RankFunc> maxRanks2;
   vector<RankFunc> maxRanks3;
 
-  RankFunc ubound(this->rankBound[sprime].stateBound, false);
+  const map<int, int>& stateBound = ctx.getRankBound(sprimeSet).stateBound;
+  RankFunc ubound(stateBound);
   if(this->opt.lowrankopt)
   {
-    maxRanks = RankFunc::getRORanksSD(m, state, fin, this->opt.cutPoint, this->rankBound[sprime].stateBound);
+    maxRanks = RankFunc::getRORanksSD(m, state, fin, stateBound);
     set<RankFunc> tmpSet1;
     for(const RankFunc& f : maxRanks)
     {
@@ -794,17 +819,20 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStartReduced(set<int>& state, int
   }
   else if(state.size() >= this->opt.ROMinState && m >= this->opt.ROMinRank)
   {
-    maxRanks = RankFunc::getRORanks(rankBound, state, fin, this->opt.cutPoint, this->rankBound[sprime].stateBound);
+    maxRanks = RankFunc::getRORanks(rankBound, state, fin, stateBound);
     maxPtr = &maxRanks;
   }
   else
   {
-    int reachMaxAct = maxReach[sprime];
+    int reachMaxAct = ctx.getMaxReach(sprimeSet);
     RankConstr constr = rankConstr(maxRank, sprime);
-    auto tmp = RankFunc::tightFromRankConstr(constr, dirRel, oddRel, reachCons, reachMaxAct, this->opt.cutPoint);
+    // functions are inserted to the antichain as they are enumerated
+    RankFuncAntichain antichain;
+    RankFuncEnumerator en(constr, dirRel, oddRel, -1, ctx.reachCons, reachMaxAct);
+    en.setMaximalFirst(true);
+    en.enumerate([&antichain](const RankFunc& f) { antichain.insert(f); return true; });
 
-    maxRanks = RankFunc::getRORanks(rankBound, state, fin, this->opt.cutPoint, this->rankBound[sprime].stateBound);
-    set<RankFunc> tmpSet2(tmp.begin(), tmp.end());
+    maxRanks = RankFunc::getRORanks(rankBound, state, fin, stateBound);
     set<RankFunc> tmpSet1;//(tmp.begin(), tmp.end());
     for(const RankFunc& f : maxRanks)
     {
@@ -817,7 +845,7 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStartReduced(set<int>& state, int
     }
     maxRanks1 = vector<RankFunc>(tmpSet1.begin(), tmpSet1.end());
     //maxRanks1 = getFuncAntichain(maxRankLeq, true);
-    maxRanks2 = getFuncAntichain(tmpSet2);
+    maxRanks2 = antichain.getFunctions();
 
     // bool cnt = false;
     // for(const RankFunc& f : maxRanks3)
@@ -867,37 +895,19 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStartReduced(set<int>& state, int
 }
 
 
-vector<RankFunc> BuchiAutomatonSpec::getFuncAntichain(set<RankFunc>& tmp, bool oddCheck) const
+/*
+ * Get maximal ranking functions (wrt the pointwise ordering of functions
+ * with the same maximum rank)
+ * @param tmp Ranking functions (of the same macrostate)
+ * @param oddCheck Compare only functions with the same odd states
+ * @return Maximal functions sorted wrt RankFunc::operator<
+ */
+vector<RankFunc> BuchiAutomatonSpec::getFuncAntichain(const vector<RankFunc>& tmp, bool oddCheck) const
 {
-  vector<RankFunc> maxRanks;
-  bool cnt = true;
-  for(auto& r : tmp)
-  {
-    cnt = true;
-    auto it = tmp.upper_bound(r);
-    while(it != tmp.end())
-    {
-      if(r != (*it) && r.getMaxRank() == it->getMaxRank() && r.isAllLeq(*it))
-      {
-        if(oddCheck)
-        {
-          if(r.getOddStates() == it->getOddStates())
-          {
-            cnt = false;
-            break;
-          }
-        }
-        else
-        {
-          cnt = false;
-          break;
-        }
-      }
-      it = std::next(it, 1);
-    }
-    if(cnt) maxRanks.push_back(r);
-  }
-  return maxRanks;
+  RankFuncAntichain antichain(oddCheck);
+  for(const RankFunc& r : tmp)
+    antichain.insert(r);
+  return antichain.getFunctions();
 }
 
 
@@ -969,7 +979,7 @@ void BuchiAutomatonSpec::computeRankBound(BuchiAutomaton<StateSch, int>& comp, S
     cout << "Rank bound: " << endl;
     for(auto & s: this->rankBound)
     {
-      RankFunc fnc(s.second.stateBound, false);
+      RankFunc fnc(s.second.stateBound);
       cout << fnc.toString() << " : " << s.second.bound << endl;
     }
     cout << endl;
@@ -1027,61 +1037,67 @@ void BuchiAutomatonSpec::computeRankBound(BuchiAutomaton<StateSch, int>& comp, S
 
 
 /*
- * Optimized Schewe complementation procedure
- * @return Complemented automaton
+ * Symbols for which successors of macrostates are generated in the tight
+ * part
+ * @param comp Waiting part of the Schewe construction
+ * @return Map assigning to a macrostate (the S-set) its symbols
  */
-
-BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchReduced(Stat *stats, bool updateBounds)
+map<DenseSet, set<int>> BuchiAutomatonSpec::getTightSymbols(const BuchiAutomaton<StateSch, int>& comp) const
 {
-  std::stack<StateSch> stack;
-  set<StateSch> comst;
-  set<StateSch> initials;
-  set<StateSch> finals;
-  vector<StateSch> succ;
-  set<int> alph = getAlphabet();
-  map<std::pair<StateSch, int>, set<StateSch> > mp;
-  map<std::pair<StateSch, int>, vector<StateSch> > mpVect;
-  map<std::pair<StateSch, int>, set<StateSch> >::iterator it;
+  map<DenseSet, set<int> > symsPred;
+  auto tr = comp.getTransitions();
+  for(const auto& m : comp.getStates())
+  {
+    symsPred[m.S] = set<int>();
+    for(int sym : this->getAlphabet())
+    {
 
-  BuchiAutomaton<StateSch, int> comp = this->complementSchNFA(this->getInitials());
-  map<std::pair<StateSch, int>, set<StateSch>> prev = comp.getReverseTransitions();
+      if(tr[{m, sym}].size() > 2)
+        symsPred[m.S].insert(sym);
+      if(tr[{m, sym}].size() == 1 && tr[{m, sym}].begin()->S.size() > 0)
+        symsPred[m.S].insert(sym);
+
+    }
+  }
+  return symsPred;
+}
+
+
+/*
+ * Prepare the automaton for the optimized Schewe complementation: the
+ * waiting part, rank bounds, simulations and the data derived from them are
+ * computed (these analyses modify the object). The result is immutable and
+ * can be shared by several (possibly concurrent) constructions.
+ * @param stats Statistical information
+ * @param updateBounds Compute rank bounds from the waiting part
+ * @return Prepared automaton
+ */
+std::shared_ptr<const SchPrepared> BuchiAutomatonSpec::prepareSchReduced(Stat *stats, bool updateBounds)
+{
+  auto prep = std::make_shared<SchPrepared>();
+  prep->waiting = this->complementSchNFA(this->getInitials());
 
   /*if (comp.getStates().size() == 1){
     comp.setAPPattern(this->getAPPattern());
     return comp;
   }*/
 
-  set<StateSch> nfaStates = comp.getStates();
-  comst.insert(nfaStates.begin(), nfaStates.end());
-  mp.insert(comp.getTransitions().begin(), comp.getTransitions().end());
-  finals = set<StateSch>(comp.getFinals());
-
-  if(updateBounds) this->computeRankBound(comp, stats);
+  if(updateBounds) this->computeRankBound(prep->waiting, stats);
 
   int newState = this->getStates().size(); //Assumes numbered states: from 0, no gaps
-  map<pair<DFAState,int>, StateSch> slTrans;
   for(const auto& pr : this->slNonEmpty)
   {
     StateSch ns = { set<int>({newState}), set<int>(), RankFunc(), 0, false };
-    StateSch src = { pr.first, set<int>(), RankFunc(), 0, false };
-    slTrans[pr] = ns;
-    mp[{ns,pr.second}] = set<StateSch>({ns});
-    mp[{src, pr.second}].insert(ns);
-    finals.insert(ns);
-    comst.insert(ns);
+    prep->slTrans[{pr.first, pr.second}] = ns;
+    prep->sinks[ns.S] = pr.second;
     newState++;
   }
-
   for(const StateSch& tmp : this->tightStartStates)
   {
     if(tmp.S.size() > 0)
-    {
-      stack.push(tmp);
-    }
+      prep->tightStart.insert(tmp);
   }
-
-  StateSch init = {getInitials(), set<int>(), RankFunc(), 0, false};
-  initials.insert(init);
+  prep->tightStartDelay = this->tightStartDelay;
 
   // simulations
   auto start = std::chrono::high_resolution_clock::now();
@@ -1091,112 +1107,423 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchReduced(Stat *sta
     this->computeRankSim(cl);
   }
 
-  BackRel dirRel = createBackRel(this->getDirectSim());
-  BackRel oddRel = createBackRel(this->getOddRankSim());
+  prep->dirRel = createBackRel(this->getDirectSim());
+  prep->oddRel = createBackRel(this->getOddRankSim());
   auto end = std::chrono::high_resolution_clock::now();
   stats->simulations = std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count();
 
-  bool cnt = true;
-  unsigned transitionsToTight = 0;
+  prep->symsPred = getTightSymbols(prep->waiting);
+  prep->delay = this->opt.delay;
+  prep->ctx = createSuccContext(this->reachCons, this->maxReach);
+  prep->init = {getInitials(), set<int>(), RankFunc(), 0, false};
+  return prep;
+}
 
-  map<DFAState, set<int> > symsPred;
-  auto tr = comp.getTransitions();
-  for(const auto& m : comp.getStates())
+
+/*
+ * Successors of a starting macrostate of the tight part: the starting tight
+ * macrostates and the sink of its nonempty self-loop (wrt the first symbol
+ * leading to the tight part). They do not depend on the symbol, hence they
+ * are attached to all transitions entering the macrostate.
+ * @param prep Prepared automaton (see prepareSchReduced)
+ * @param state Starting macrostate of the tight part
+ * @return Successors (empty if no symbol leads to the tight part)
+ */
+vector<StateSch> BuchiAutomatonSpec::succSetSchStartPrepared(const SchPrepared& prep, const StateSch& state) const
+{
+  const set<int>& syms = prep.getTightSymbols(state.S);
+  if(syms.empty())
+    return {};
+
+  vector<StateSch> ret = succSetSchStartReduced(state.S, prep.ctx.getRankBound(state.S).bound,
+    prep.ctx, prep.dirRel, prep.oddRel);
+  auto sl = prep.slTrans.find({state.S, *syms.begin()});
+  if(sl != prep.slTrans.end())
+    ret.push_back(sl->second);
+  return ret;
+}
+
+
+/*
+ * Optimized Schewe complementation procedure constructed on demand. The
+ * waiting part and the rank bounds are given by the prepared automaton,
+ * macrostates of the tight part are generated only when they are reached.
+ * The automaton has to outlive the returned object, each returned object
+ * has its own rank successor cache (of size opt.CacheMemory).
+ * @param prep Prepared automaton (see prepareSchReduced)
+ * @return Lazy complement (the automaton of complementSchReduced before
+ *         dead macrostates of the tight part are dropped)
+ */
+LazyComplement<StateSch> BuchiAutomatonSpec::lazyComplementSchReduced(std::shared_ptr<const SchPrepared> prep) const
+{
+  // exploration state of the lazy complement
+  struct LazyRun
   {
-    symsPred[m.S] = set<int>();
-    for(int sym : this->getAlphabet())
+    // successors of the starting macrostates of the tight part
+    map<StateSch, vector<StateSch>> startSucc;
+    RankSuccCache cache;
+
+    LazyRun(size_t budget) : startSucc(), cache(budget) { }
+  };
+  auto run = std::make_shared<LazyRun>(this->opt.CacheMemory);
+
+  auto succ = [this, prep, run](const StateSch& st, int sym) -> vector<StateSch>
+  {
+    if(st.tight)
     {
+      if(prep->getTightSymbols(st.S).count(sym) == 0)
+        return {};
+      return succSetSchTightReduced(st, sym, prep->ctx, prep->dirRel, prep->oddRel, run->cache);
+    }
 
-      if(tr[{m, sym}].size() > 2)
-        symsPred[m.S].insert(sym);
-      if(tr[{m, sym}].size() == 1 && tr[{m, sym}].begin()->S.size() > 0)
-        symsPred[m.S].insert(sym);
+    vector<StateSch> ret;
+    auto sink = prep->sinks.find(st.S);
+    if(sink != prep->sinks.end())
+    {
+      if(sink->second == sym)
+        ret.push_back(st);
+      return ret;
+    }
 
+    auto sl = prep->slTrans.find({st.S, sym});
+    if(sl != prep->slTrans.end())
+      ret.push_back(sl->second);
+    const auto& waitTrans = prep->waiting.getTransitions();
+    auto it = waitTrans.find({st, sym});
+    if(it == waitTrans.end())
+      return ret;
+    for(const StateSch& d : it->second)
+    {
+      ret.push_back(d);
+      if(prep->tightStart.count(d) == 0 || !prep->entersTight(st, sym))
+        continue;
+      auto start = run->startSucc.find(d);
+      if(start == run->startSucc.end())
+        start = run->startSucc.insert({d, succSetSchStartPrepared(*prep, d)}).first;
+      ret.insert(ret.end(), start->second.begin(), start->second.end());
     }
+    return ret;
+  };
+
+  auto acc = [prep](const StateSch& st) -> bool
+  {
+    if(st.tight)
+      return st.O.size() == 0;
+    return prep->waiting.getFinals().count(st) > 0 || prep->sinks.count(st.S) > 0;
+  };
+
+  return LazyComplement<StateSch>({prep->init}, getAlphabet(), succ, acc);
+}
+
+
+/*
+ * Optimized Schewe complementation procedure constructed on demand
+ * @param stats Statistical information
+ * @return Lazy complement (the automaton of complementSchReduced before
+ *         dead macrostates of the tight part are dropped)
+ */
+LazyComplement<StateSch> BuchiAutomatonSpec::lazyComplementSchReduced(Stat *stats)
+{
+  return this->lazyComplementSchReduced(this->prepareSchReduced(stats));
+}
+
+
+/*
+ * Optimized Schewe complementation procedure
+ * @param stats Statistical information
+ * @param updateBounds Compute rank bounds from the waiting part
+ * @return Complemented automaton
+ */
+BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchReduced(Stat *stats, bool updateBounds)
+{
+  return this->complementSchReduced(*this->prepareSchReduced(stats, updateBounds), stats);
+}
+
+
+/*
+ * Optimized Schewe complementation procedure over a prepared automaton (the
+ * exploration state, including rank successor caches, is local to the call)
+ * @param prep Prepared automaton (see prepareSchReduced)
+ * @param stats Statistical information
+ * @return Complemented automaton (without macrostates of the tight part
+ *         that cannot reach an accepting cycle)
+ */
+BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchReduced(const SchPrepared& prep, Stat *stats) const
+{
+  typedef StateSchStore::StateId StateId;
+
+  // macrostates are interned, the construction works with their ids only
+  StateSchStore store;
+  std::stack<StateId> stack;
+  vector<bool> comst;
+  vector<bool> finals;
+  vector<map<int, set<StateId>>> mp;
+  set<StateSch> initials;
+  vector<StateSch> succ;
+  set<int> alph = getAlphabet();
+
+  auto intern = [&](const StateSch& st, bool state) -> std::pair<StateId, bool>
+  {
+    auto ins = store.insert(st);
+    if(ins.second)
+    {
+      comst.push_back(false);
+      finals.push_back(false);
+      mp.emplace_back();
+    }
+    bool nw = state && !comst[ins.first];
+    if(state)
+      comst[ins.first] = true;
+    return {ins.first, nw};
+  };
+
+  const BuchiAutomaton<StateSch, int>& comp = prep.waiting;
+  for(const StateSch& s : comp.getStates())
+    intern(s, true);
+  map<std::pair<StateId, int>, set<StateId>> prev;
+  for(const auto& t : comp.getTransitions())
+  {
+    StateId src = intern(t.first.first, false).first;
+    set<StateId>& dst = mp[src][t.first.second];
+    for(const StateSch& d : t.second)
+    {
+      StateId did = intern(d, false).first;
+      dst.insert(did);
+      prev[{did, t.first.second}].insert(src);
+    }
+  }
+  for(const StateSch& s : comp.getFinals())
+    finals[intern(s, false).first] = true;
+
+  for(const auto& pr : prep.slTrans)
+  {
+    StateId ns = intern(pr.second, true).first;
+    StateId src = intern({ pr.first.first, set<int>(), RankFunc(), 0, false }, false).first;
+    mp[ns][pr.first.second] = set<StateId>({ns});
+    mp[src][pr.first.second].insert(ns);
+    finals[ns] = true;
+  }
+
+  for(const StateSch& tmp : prep.tightStart)
+  {
+    stack.push(intern(tmp, false).first);
   }
 
+  initials.insert(prep.init);
+
+  unsigned transitionsToTight = 0;
+
   // tight part construction
-  start = std::chrono::high_resolution_clock::now();
+  auto start = std::chrono::high_resolution_clock::now();
+  const SuccContext& ctx = prep.ctx;
+  bool parallel = this->opt.threads > 1;
+  unsigned workers = parallel ? this->opt.threads : 1;
+  // each worker has its own cache (the budget is divided among them)
+  vector<RankSuccCache> caches(workers, RankSuccCache(this->opt.CacheMemory / workers));
+  vector<std::pair<StateId, StateSch>> tightWork;
+
+  // the tight part is closed under successors; it is explored depth-first
+  // and macrostates from which no accepting cycle is reachable are dropped
+  // (together with their transitions) as soon as their SCC is completed
+  SccExplorer tightScc;
+  // number of dropped macrostates (they are not reported to the progress)
+  std::size_t dropped = 0;
+  auto tightSucc = [&](int id) -> vector<int>
+  {
+    StateSch st = store[id];
+    if(isSchFinal(st))
+      finals[id] = true;
+    vector<int> ret;
+    for(int sym : prep.getTightSymbols(st.S))
+    {
+      set<StateId> dst;
+      for(const StateSch& s : succSetSchTightReduced(st, sym, ctx, prep.dirRel, prep.oddRel, caches[0]))
+      {
+        auto ins = intern(s, true);
+        dst.insert(ins.first);
+        if(ins.second)
+          ComplProgress::report(store.size() - dropped);
+      }
+      ret.insert(ret.end(), dst.begin(), dst.end());
+      mp[id][sym] = std::move(dst);
+    }
+    return ret;
+  };
+  auto tightAcc = [&](int id) -> bool { return finals[id]; };
+  auto tightDead = [&](const vector<int>& comp)
+  {
+    for(int id : comp)
+      map<int, set<StateId>>().swap(mp[id]);
+    dropped += comp.size();
+    ComplProgress::report(store.size() - dropped);
+  };
+
   while(stack.size() > 0)
   {
-    StateSch st = stack.top();
+    StateId id = stack.top();
     stack.pop();
+    StateSch st = store[id];
+    if(parallel && st.tight)
+    {
+      tightWork.push_back({id, st});
+      continue;
+    }
+    if(st.tight)
+    {
+      tightScc.explore(id, tightSucc, tightAcc, tightDead);
+      continue;
+    }
     if(isSchFinal(st))
-      finals.insert(st);
-    cnt = true;
+      finals[id] = true;
 
-    //cout << st.toString() << endl;
-
-    for(int sym : symsPred[st.S])
+    // the start successors are computed once and added to all transitions
+    // entering the macrostate
+    succ = succSetSchStartPrepared(prep, st);
+    if(succ.empty())
+      continue;
+    set<StateId> dst;
+    for (const StateSch& s : succ)
     {
-      auto pr = std::make_pair(st, sym);
-      set<StateSch> dst;
-      if(st.tight)
+      auto ins = intern(s, true);
+      dst.insert(ins.first);
+      if(ins.second)
       {
-        succ = succSetSchTightReduced(st, sym, this->reachCons, this->maxReach, dirRel, oddRel, this->getFinals());
+        stack.push(ins.first);
+        ComplProgress::report(store.size() - dropped);
       }
-      else
-      {
-        succ = succSetSchStartReduced(st.S, rankBound[st.S].bound, this->reachCons, this->maxReach, dirRel, oddRel, this->getFinals());
-        // for(const auto& t : succ)
-        // {
-        //   cout << t.f.toString() << endl;
-        // }
-        // cout << endl;
-        cnt = false;
-      }
-      for (const StateSch& s : succ)
-      {
-        dst.insert(s);
-        if(comst.find(s) == comst.end())
-        {
-          stack.push(s);
-          comst.insert(s);
+    }
+
+    for(const auto& a : alph)
+    {
+      auto pr = prev.find({id, a});
+      if(pr == prev.end())
+        continue;
+      for(StateId d : pr->second) {
+        if (prep.entersTight(store[d], a)){
+          mp[d][a].insert(dst.begin(), dst.end());
+          transitionsToTight += dst.size();
         }
       }
+    }
+  }
 
-      auto it = slTrans.find({st.S, sym});
-      if(!st.tight && it != slTrans.end())
-      {
-        dst.insert(it->second);
-      }
-      if(!st.tight)
+  // tight states are explored in parallel (successors of different tight
+  // states are independent, the result does not depend on the order). The
+  // visited set is striped among locks, successors and transitions are
+  // collected in per-worker buffers and merged into the store afterwards.
+  if(parallel && !tightWork.empty())
+  {
+    typedef StripedStateSchStore::Ref Ref;
+    struct TightTrans
+    {
+      Ref src;
+      int symbol;
+      vector<Ref> dst;
+    };
+    StripedStateSchStore visited(16 * workers);
+    ComplProgress* progress = ComplProgress::getActive();
+    std::size_t sequential = store.size() - dropped;
+    vector<vector<TightTrans>> localTrans(workers);
+    vector<vector<Ref>> localFinals(workers);
+
+    ParallelExplorer<std::pair<Ref, StateSch>> explorer(workers);
+    for(const auto& item : tightWork)
+    {
+      auto ins = visited.insert(item.second);
+      if(ins.second)
+        explorer.push({ins.first, item.second});
+    }
+
+    explorer.run([&](unsigned worker, std::pair<Ref, StateSch>& item,
+      vector<std::pair<Ref, StateSch>>& out)
+    {
+      StateSch& st = item.second;
+      if(isSchFinal(st))
+        localFinals[worker].push_back(item.first);
+      for(int sym : prep.getTightSymbols(st.S))
       {
-        if(!cnt)
+        TightTrans tr = { item.first, sym, vector<Ref>() };
+        for(const StateSch& s : succSetSchTightReduced(st, sym, ctx, prep.dirRel,
+          prep.oddRel, caches[worker]))
         {
-            for(const auto& a : this->getAlphabet())
-            {
-              for(const auto& d : prev[{st, a}]) {
-                if ((!this->opt.delay) or this->tightStartDelay[d].find(a) != this->tightStartDelay[d].end()){
-                  mp[{d,a}].insert(dst.begin(), dst.end());
-                  transitionsToTight += dst.size();
-                }
-              }
-            }
-        }
-        else
-        {
-          if (!this->opt.delay)
-            mp[pr].insert(dst.begin(), dst.end());
-          else {
-            if (this->tightStartDelay[st].find(sym) != this->tightStartDelay[st].end()){
-                mp[pr].insert(dst.begin(), dst.end());
-            }
+          auto ins = visited.insert(s);
+          tr.dst.push_back(ins.first);
+          if(ins.second)
+          {
+            out.push_back({ins.first, s});
+            if(progress != nullptr)
+              progress->update(sequential + visited.size());
           }
         }
+        localTrans[worker].push_back(std::move(tr));
       }
-      else{
-        mp[pr] = dst;
+    });
+
+    // stripe ids are translated to the ids of the store
+    vector<vector<StateId>> ids(visited.getStripeCount());
+    for(unsigned s = 0; s < visited.getStripeCount(); s++)
+    {
+      const StateSchStore& stripe = visited.getStripe(s);
+      for(StateId i = 0; i < stripe.size(); i++)
+        ids[s].push_back(intern(stripe[i], true).first);
+    }
+    auto toId = [&ids](const Ref& r) -> StateId { return ids[r.first][r.second]; };
+    for(unsigned i = 0; i < workers; i++)
+    {
+      for(const Ref& r : localFinals[i])
+        finals[toId(r)] = true;
+      for(const TightTrans& tr : localTrans[i])
+      {
+        set<StateId>& dst = mp[toId(tr.src)][tr.symbol];
+        for(const Ref& r : tr.dst)
+          dst.insert(toId(r));
       }
-      if(!cnt) break;
     }
+
+    // macrostates that cannot reach an accepting cycle are dropped as in
+    // the sequential exploration (the successors are already computed)
+    auto storedSucc = [&](int id) -> vector<int>
+    {
+      vector<int> ret;
+      for(const auto& t : mp[id])
+        ret.insert(ret.end(), t.second.begin(), t.second.end());
+      return ret;
+    };
+    for(const auto& item : tightWork)
+      tightScc.explore(item.first, storedSucc, tightAcc, tightDead);
+    // the workers might have reported out of order
+    ComplProgress::report(store.size() - dropped);
   }
 
-  end = std::chrono::high_resolution_clock::now();
+  auto end = std::chrono::high_resolution_clock::now();
   stats->tightPart = std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count();
+  setCacheStats(stats, caches);
 
-  return BuchiAutomaton<StateSch, int>(comst, finals,
-    initials, mp, alph, getAPPattern());
+  set<StateSch> resStates;
+  set<StateSch> resFinals;
+  map<std::pair<StateSch, int>, set<StateSch> > resTrans;
+  for(StateId i = 0; i < store.size(); i++)
+  {
+    if(tightScc.isDead(i))
+      continue;
+    if(comst[i])
+      resStates.insert(store[i]);
+    if(finals[i])
+      resFinals.insert(store[i]);
+    for(const auto& t : mp[i])
+    {
+      set<StateId> dst;
+      for(StateId d : t.second)
+      {
+        if(!tightScc.isDead(d))
+          dst.insert(dst.end(), d);
+      }
+      resTrans[{store[i], t.first}] = store.getStates(dst);
+    }
+  }
+
+  return BuchiAutomaton<StateSch, int>(resStates, resFinals,
+    initials, resTrans, alph, getAPPattern());
 }
 
 
@@ -1206,48 +1533,22 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchReduced(Stat *sta
  */
 BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchNFA(set<int>& start)
 {
-  std::stack<StateSch> stack;
-  set<StateSch> comst;
-  set<StateSch> initials;
-  set<StateSch> finals;
-  //set<StateSch> succ;
-  set<int> alph = getAlphabet();
-  map<std::pair<StateSch, int>, set<StateSch> > mp;
-  map<std::pair<StateSch, int>, set<StateSch> >::iterator it;
-
-  StateSch init = {start, set<int>(), RankFunc(), 0, false};
-  stack.push(init);
-  comst.insert(init);
-  initials.insert(init);
-
-
-  while(stack.size() > 0)
+  auto succ = [this](const StateSch& st, int sym) -> vector<StateSch>
   {
-    StateSch st = stack.top();
-    stack.pop();
-    if(isSchFinal(st))
-      finals.insert(st);
-
-    for(int sym : alph)
-    {
-      auto pr = std::make_pair(st, sym);
-      set<StateSch> dst;
-      if(!st.tight)
-      {
-        StateSch nt = {succSet(st.S, sym), set<int>(), RankFunc(), 0, false};
-        dst.insert(nt);
-        if(comst.find(nt) == comst.end())
-        {
-          stack.push(nt);
-          comst.insert(nt);
-        }
-      }
-      mp[pr] = dst;
-    }
-  }
+    if(st.tight)
+      return {};
+    return {{this->transTable.succSet(st.S, sym), DenseSet(), RankFunc(), 0, false}};
+  };
+  auto acc = [this](const StateSch& st) -> bool
+  {
+    StateSch tmp = st;
+    return isSchFinal(tmp);
+  };
 
-  return BuchiAutomaton<StateSch, int>(comst, finals,
-    initials, mp, alph);
+  SubsetConstruction<StateSch, int> constr(getAlphabet(), succ, acc,
+    StateSchStore::fingerprint, this->opt.threads);
+  StateSch init = {start, set<int>(), RankFunc(), 0, false};
+  return constr.construct({init});
 }
 
 /*
@@ -1387,7 +1688,7 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
 
   if(this->opt.elevator.elevatorRank)
   {
-    elevatorBound = this->elev.elevatorRank(this->opt.elevator.detBeginning);
+    elevatorBound = this->analysis->elevatorRank(this->opt.elevator.detBeginning);
     if(this->opt.debug)
     {
       cout << "Elevator ranks: " << endl;
@@ -1404,7 +1705,7 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
   }
 
   bool sd = false;
-  if(this->opt.semidetOpt && this->isSemiDeterministic()){
+  if(this->opt.semidetOpt && this->analysis->isSemiDeterministic()){
     sd = true;
   }
 
@@ -1415,8 +1716,18 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
 
   if(this->opt.ranksim && this->opt.dirsim)
   {
+    // states are numbered from 0, hence positions of states are the states
+    RankSimulation rankSim = this->getRankSimulation();
     for(const StateSch& s : nfaSchewe.getStates())
     {
+      if(s.S.size() > this->opt.rankSimMaxMacro)
+      {
+        if(sd)
+        {
+          rnkmap[s] = std::min(rnkmap[s], 3);
+        }
+        continue;
+      }
       rnkmap[s] = 0;
       for(vector<int>& sub : Aux::getAllSubsets(vector<int>(s.S.begin(), s.S.end())))
       {
@@ -1424,8 +1735,9 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
 
         if(classesMap.find(st) == classesMap.end())
         {
-          this->computeRankSim(st);
-          classes = Aux::countEqClasses(this->getStates().size(), st, this->getOddRankSim());
+          DenseSet stSet(st);
+          classes = Aux::countEqClasses(rankSim.compute(stSet), st);
+          classesMap[st] = classes;
         }
         else
         {
@@ -1453,42 +1765,40 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
     }
   }
 
-  auto updPred = [this, &slignore, &symsPred, &accTrans] (LabelState<StateSch, RankBound>* dest, const std::vector<LabelState<StateSch, RankBound>*> sts) -> RankBound
+  // accepting transitions as (source, symbol, target)
+  set<std::tuple<int, int, int>> accSet;
+  for(const auto& t : accTrans)
+    accSet.insert({t.from, t.symbol, t.to});
+  const auto& dirSim = this->getDirectSim();
+
+  auto updPred = [this, &slignore, &symsPred, &fin, &accSet, &dirSim] (const LabelState<StateSch, RankBound>& dest, const VecLabelStatesPtr<StateSch, RankBound>& sts) -> RankBound
   {
     int n = this->getStates().size();
     vector<int> mrank(n, 0);
-    set<int> fin = this->getFinals();
     int m = 0;
-    RankBound ret = dest->label;
+    RankBound ret = dest.label;
+    const set<int>& syms = symsPred.at(dest.state.S);
 
     for(const LabelState<StateSch, RankBound>* tmp : sts)
     {
-      if(tmp->state.S != dest->state.S || slignore.find(dest->state) == slignore.end())
+      if(tmp->state.S != dest.state.S || slignore.find(dest.state) == slignore.end())
         m = std::max(m, tmp->label.bound);
 
-      // set<int> syms;
-      // for(int sym : this->getAlphabet())
-      // {
-      //   if(this->succSet(tmp->state.S, sym) == dest->state.S)
-      //     syms.insert(sym);
-      // }
-      for (const int& sym : symsPred[dest->state.S])
+      for (const int& sym : syms)
       {
         vector<int> tmpMrank(n, 2*n);
         for(const int& s : tmp->state.S)
         {
-          set<int> dst = this->getTransitions()[std::make_pair(s, sym)];
-          for(int d : dst)
+          auto it = tmp->label.stateBound.find(s);
+          for(int d : this->transTable.succ(s, sym))
           {
-            auto it = tmp->label.stateBound.find(s);
-            Transition<int, int> tr = { .from = s, .to = d, .symbol = sym};
-            if(std::find(accTrans.begin(), accTrans.end(), tr) != accTrans.end() )
+            if(accSet.find({s, sym, d}) != accSet.end())
               tmpMrank[d] = std::min(tmpMrank[d], BuchiAutomatonSpec::evenceil(it->second));
             else
               tmpMrank[d] = std::min(tmpMrank[d], it->second);
           }
         }
-        for(const int& i : dest->state.S)
+        for(const int& i : dest.state.S)
         {
           mrank[i] = max(tmpMrank[i], mrank[i]);
         }
@@ -1497,9 +1807,9 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
 
     if(this->opt.flowDirSim)
     {
-      for(const auto & sim : this->getDirectSim())
+      for(const auto & sim : dirSim)
       {
-        if(dest->state.S.find(sim.first) != dest->state.S.end() && dest->state.S.find(sim.second) != dest->state.S.end())
+        if(dest.state.S.find(sim.first) != dest.state.S.end() && dest.state.S.find(sim.second) != dest.state.S.end())
         {
           mrank[sim.first] = std::min(mrank[sim.first], mrank[sim.second]);
         }
@@ -1508,7 +1818,7 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
 
     int tmpm = 0;
     int tmpmax = 0;
-    for(const int& i : dest->state.S)
+    for(const int& i : dest.state.S)
     {
       tmpm = min(ret.stateBound[i], mrank[i]);
       tmpm = std::min(tmpm, ret.bound);
@@ -1517,7 +1827,7 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
       ret.stateBound[i] = tmpm;
       tmpmax = std::max(tmpm, tmpmax);
     }
-    ret.bound = std::min(dest->label.bound, m);
+    ret.bound = std::min(dest.label.bound, m);
 
     if(tmpmax < ret.bound)
       ret.bound = tmpmax;
@@ -1528,16 +1838,16 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
   };
 
 
-  auto updMaxFnc = [&slignore] (LabelState<StateSch, RankBound>* a, const std::vector<LabelState<StateSch, RankBound>*> sts) -> RankBound
+  auto updMaxFnc = [&slignore] (const LabelState<StateSch, RankBound>& a, const VecLabelStatesPtr<StateSch, RankBound>& sts) -> RankBound
   {
     int m = 0;
     for(const LabelState<StateSch, RankBound>* tmp : sts)
     {
-      if(tmp->state.S == a->state.S && slignore.find(a->state) != slignore.end())
+      if(tmp->state.S == a.state.S && slignore.find(a.state) != slignore.end())
         continue;
       m = std::max(m, tmp->label.bound);
     }
-    return { .bound = std::min(a->label.bound, m), .stateBound = a->label.stateBound };
+    return { .bound = std::min(a.label.bound, m), .stateBound = a.label.stateBound };
   };
 
   auto initMaxFnc = [this, &maxReachSize, &minReachSize, &rnkmap, &elevatorBound] (const StateSch& act) -> RankBound
@@ -1623,16 +1933,16 @@ map<DFAState, RankBound> BuchiAutomatonSpec::getRankBound(BuchiAutomaton<StateSc
  */
 map<DFAState, int> BuchiAutomatonSpec::getMaxReachSize(BuchiAutomaton<StateSch, int>& nfaSchewe, set<StateSch>& slIgnore)
 {
-  auto updMaxFnc = [&slIgnore] (LabelState<StateSch, int>* a, const std::vector<LabelState<StateSch, int>*> sts) -> int
+  auto updMaxFnc = [&slIgnore] (const LabelState<StateSch, int>& a, const VecLabelStatesPtr<StateSch, int>& sts) -> int
   {
     int m = 0;
     for(const LabelState<StateSch, int>* tmp : sts)
     {
-      if(tmp->state.S == a->state.S && slIgnore.find(a->state) != slIgnore.end())
+      if(tmp->state.S == a.state.S && slIgnore.find(a.state) != slIgnore.end())
         continue;
       m = std::max(m, tmp->label);
     }
-    return std::min(a->label, m);
+    return std::min(a.label, m);
   };
 
   auto initMaxFnc = [] (const StateSch& act) -> int
@@ -1659,16 +1969,16 @@ map<int, int> BuchiAutomatonSpec::getMinReachSize()
   map<StateSch, int> mp;
   map<int, int> ret;
 
-  auto updMaxFnc = [&slIgnore] (LabelState<StateSch, int>* a, const std::vector<LabelState<StateSch, int>*> sts) -> int
+  auto updMaxFnc = [&slIgnore] (const LabelState<StateSch, int>& a, const VecLabelStatesPtr<StateSch, int>& sts) -> int
   {
     int m = 0;
     for(const LabelState<StateSch, int>* tmp : sts)
     {
-      if(tmp->state.S == a->state.S && slIgnore.find(a->state) != slIgnore.end())
+      if(tmp->state.S == a.state.S && slIgnore.find(a.state) != slIgnore.end())
         continue;
       m = std::max(m, tmp->label);
     }
-    return std::min(a->label, m);
+    return std::min(a.label, m);
   };
 
   auto initMaxFnc = [] (const StateSch& act) -> int
@@ -1707,16 +2017,16 @@ map<int, int> BuchiAutomatonSpec::getMaxReachSizeInd()
   map<StateSch, int> mp;
   map<int, int> ret;
 
-  auto updMaxFnc = [&slIgnore] (LabelState<StateSch, int>* a, const std::vector<LabelState<StateSch, int>*> sts) -> int
+  auto updMaxFnc = [&slIgnore] (const LabelState<StateSch, int>& a, const VecLabelStatesPtr<StateSch, int>& sts) -> int
   {
     int m = 0;
     for(const LabelState<StateSch, int>* tmp : sts)
     {
-      if(tmp->state.S == a->state.S && slIgnore.find(a->state) != slIgnore.end())
+      if(tmp->state.S == a.state.S && slIgnore.find(a.state) != slIgnore.end())
         continue;
       m = std::max(m, tmp->label);
     }
-    return std::max(a->label, m);
+    return std::max(a.label, m);
   };
 
   auto initMaxFnc = [] (const StateSch& act) -> int
@@ -1750,23 +2060,22 @@ map<int, int> BuchiAutomatonSpec::getMaxReachSizeInd()
  * @param max Vector of maximal ranks (indexed by states)
  * @param states Set of states in a macrostate (the S-set)
  * @param macrostate Current macrostate
- * @param reachCons SuccRank restriction
+ * @param ctx Successor context
  * @param reachMax Maximum reachable macrostate
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
  */
-void BuchiAutomatonSpec::getSchRanksTightOpt(vector<RankFunc>& out, vector<int>& max,
-    set<int>& states, StateSch& macrostate,
-    map<int, int> reachCons, int reachMax, BackRel& dirRel, BackRel& oddRel)
+void BuchiAutomatonSpec::getSchRanksTightOpt(vector<RankFunc>& out, const vector<int>& max,
+    const set<int>& states, const StateSch& macrostate, const SuccContext& ctx,
+    int reachMax, const BackRel& dirRel, const BackRel& oddRel) const
 {
   RankConstr constr;
   map<int, int> sngmap;
 
-  set<int> fin = getFinals();
   for(int st : states)
   {
     vector<std::pair<int, int> > singleConst;
-    if(fin.find(st) == fin.end())
+    if(!ctx.finals.contains(st))
     {
       for(int i = 0; i < max[st]; i+= 1)
         singleConst.push_back(std::make_pair(st, i));
@@ -1782,8 +2091,8 @@ void BuchiAutomatonSpec::getSchRanksTightOpt(vector<RankFunc>& out, vector<int>&
     constr.push_back(singleConst);
   }
 
-  out = RankFunc::tightSuccFromRankConstrPure(constr, dirRel, oddRel, macrostate.f.getMaxRank(),
-    reachCons, reachMax, true);
+  out = RankFunc::tightFromRankConstr(constr, dirRel, oddRel, macrostate.f.getMaxRank(),
+    ctx.reachCons, reachMax);
 }
 
 
@@ -1791,14 +2100,15 @@ void BuchiAutomatonSpec::getSchRanksTightOpt(vector<RankFunc>& out, vector<int>&
  * Get all Schewe successros (with RankRestr)
  * @param state Schewe state
  * @param symbol Symbol
- * @param reachCons SuccRank restriction
- * @param maxReach Maximum reachable macrostate
+ * @param ctx Successor context
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
+ * @param cache Rank successor cache of the run
  * @return Set of all successors
  */
-vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(StateSch& state, int symbol,
-    map<int, int> reachCons, map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel)
+vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(const StateSch& state, int symbol,
+    const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel,
+    RankSuccCache& cache) const
 {
   /*
   TODO: add support for accepting transitions
@@ -1807,24 +2117,25 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(StateSch& state, int sym
 
   vector<StateSch> ret;
   set<int> sprime;
-  set<int> oprime;
+  DenseSet oprime;
   int iprime;
-  vector<int> maxRank(getStates().size(), state.f.getMaxRank());
+  vector<int> maxRank(ctx.states, state.f.getMaxRank());
   map<int, set<int> > succ;
-  auto fin = getFinals();
+  const DenseSet& fin = ctx.finals;
 
   for(int st : state.S)
   {
-    set<int> dst = getTransitions()[std::make_pair(st, symbol)];
+    TransitionTable::Range dst = this->transTable.succ(st, symbol);
+    int rank = state.f[st];
     for(int d : dst)
     {
-      maxRank[d] = std::min(maxRank[d], state.f[st]);
+      maxRank[d] = std::min(maxRank[d], rank);
     }
     sprime.insert(dst.begin(), dst.end());
-    if(fin.find(st) == fin.end())
-      succ[st] = dst;
+    if(!fin.contains(st))
+      succ[st] = set<int>(dst.begin(), dst.end());
 
-    if(state.f.find(st)->second == 0 && reachCons[st] > 0)
+    if(state.f.find(st)->second == 0 && ctx.minReach[st] > 0)
     {
       return ret;
     }
@@ -1834,7 +2145,8 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(StateSch& state, int sym
     }
   }
 
-  if(this->rankBound[state.S].bound < state.f.getMaxRank() || this->rankBound[sprime].bound < state.f.getMaxRank())
+  DenseSet sprimeSet(sprime);
+  if(ctx.getRankBound(state.S).bound < state.f.getMaxRank() || ctx.getRankBound(sprimeSet).bound < state.f.getMaxRank())
   {
     return ret;
   }
@@ -1847,7 +2159,7 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(StateSch& state, int sym
 
   for(int st : sprime)
   {
-    if(fin.find(st) != fin.end() && maxRank[st] % 2 != 0)
+    if(fin.contains(st) && maxRank[st] % 2 != 0)
       maxRank[st] -= 1;
   }
   if(state.O.size() == 0)
@@ -1857,32 +2169,29 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(StateSch& state, int sym
   else
   {
     iprime = state.i;
-    oprime = succSet(state.O, symbol);
+    oprime = this->transTable.succSet(state.O, symbol);
   }
 
-  int maxReachAct = maxReach[sprime];
+  int maxReachAct = ctx.getMaxReach(sprimeSet);
   vector<RankFunc> ranks;
   vector<RankFunc> tmp;
   set<int> inverseRank;
 
-  if(!getRankSuccCache(tmp, state, symbol))
+  if(!cache.lookup(tmp, state.S, symbol, state.f))
   {
     getSchRanksTightOpt(tmp, maxRank, sprime, state,
-        reachCons, maxReachAct, dirRel, oddRel);
-    this->rankCache[{state.S, symbol, state.f.getMaxRank()}].push_back({state.f, tmp});
+        ctx, maxReachAct, dirRel, oddRel);
+    cache.insert(state.S, symbol, state.f, tmp);
   }
 
   for (auto& r : tmp)
   {
     if(!r.isSuccValid(state.f, succ) ||  !r.isMaxRankValid(rnkBnd))
       continue;
-    set<int> oprime_tmp;
     inverseRank = r.inverseRank(iprime);
-    if (state.O.size() == 0)
-      oprime_tmp = inverseRank;
-    else
-      std::set_intersection(oprime.begin(),oprime.end(),inverseRank.begin(),
-        inverseRank.end(), std::inserter(oprime_tmp, oprime_tmp.begin()));
+    DenseSet oprime_tmp(inverseRank);
+    if (state.O.size() != 0)
+      oprime_tmp &= oprime;
     ret.push_back({sprime, oprime_tmp, r, iprime, true});
   }
   return ret;
@@ -1894,15 +2203,13 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchTightOpt(StateSch& state, int sym
  * @param state DFA macrostate
  * @param rankBound Maximum rank
  * @param macrostate Current macrostate
- * @param reachCons SuccRank restriction
- * @param maxReach Maximum reachable macrostate
+ * @param ctx Successor context
  * @param dirRel Direct simulation
  * @param oddRel Rank simulation
  * @return Set of first states in the tight part
  */
-vector<StateSch> BuchiAutomatonSpec::succSetSchStartOpt(set<int>& state, int rankBound,
-    map<int, int> reachCons, map<DFAState, int> maxReach, BackRel& dirRel,
-    BackRel& oddRel)
+vector<StateSch> BuchiAutomatonSpec::succSetSchStartOpt(const set<int>& state, int rankBound,
+    const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel) const
 {
   /*
   TODO: add support for accepting transitions
@@ -1910,23 +2217,22 @@ vector<StateSch> BuchiAutomatonSpec::succSetSchStartOpt(set<int>& state, int ran
   assert(this->getFinTrans().size() == 0);
 
   vector<StateSch> ret;
-  set<int> sprime = state;
-  set<int> schfinal;
-  set<int> fin = getFinals();
-  std::set_difference(sprime.begin(),sprime.end(),fin.begin(),
-    fin.end(), std::inserter(schfinal, schfinal.begin()));
-  int m = std::min((int)(2*schfinal.size() - 1), 2*rankBound - 1);
-  vector<int> maxRank(getStates().size(), m);
+  const set<int>& sprime = state;
+  DenseSet sprimeSet(sprime);
+  const DenseSet& fin = ctx.finals;
+  int schfinal = (sprimeSet - fin).size();
+  int m = std::min((int)(2*schfinal - 1), 2*rankBound - 1);
+  vector<int> maxRank(ctx.states, m);
 
   for(int st : sprime)
   {
-    if(fin.find(st) != fin.end() && maxRank[st] % 2 != 0)
+    if(fin.contains(st) && maxRank[st] % 2 != 0)
       maxRank[st] -= 1;
   }
 
-  int reachMaxAct = maxReach[sprime];
+  int reachMaxAct = ctx.getMaxReach(sprimeSet);
   RankConstr constr = rankConstr(maxRank, sprime);
-  for(const RankFunc& item : RankFunc::tightFromRankConstrPure(constr, dirRel, oddRel, reachCons, reachMaxAct, true))
+  for(const RankFunc& item : RankFunc::tightFromRankConstr(constr, dirRel, oddRel, -1, ctx.reachCons, reachMaxAct))
   {
     ret.push_back({sprime, set<int>(), item, 0, true});
   }
@@ -2038,6 +2344,8 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchOpt(bool delay, s
 
   BackRel dirRel = createBackRel(this->getDirectSim());
   BackRel oddRel = createBackRel(this->getOddRankSim());
+  const SuccContext ctx = createSuccContext(reachCons, maxReach);
+  vector<RankSuccCache> caches(1, RankSuccCache(this->opt.CacheMemory));
 
   bool cnt = true;
 
@@ -2057,11 +2365,12 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchOpt(bool delay, s
       set<StateSch> dst;
       if(st.tight)
       {
-        succ = succSetSchTightOpt(st, sym, reachCons, maxReach, dirRel, oddRel);
+        succ = succSetSchTightOpt(st, sym, ctx, dirRel, oddRel, caches[0]);
       }
       else // waiting part
       {
-        succ = succSetSchStartOpt(st.S, rankBound[st.S].bound, reachCons, maxReach, dirRel, oddRel);
+        DFAState macrostate = st.S;
+        succ = succSetSchStartOpt(macrostate, ctx.getRankBound(macrostate).bound, ctx, dirRel, oddRel);
         //cout << st.toString() << " : " << succ.size() << endl;
         cnt = false;
       }
@@ -2110,6 +2419,7 @@ BuchiAutomaton<StateSch, int> BuchiAutomatonSpec::complementSchOpt(bool delay, s
       if(!cnt) break;
     }
   }
+  setCacheStats(stats, caches);
 
   return BuchiAutomaton<StateSch, int>(comst, finals,
     initials, mp, alph, getAPPattern());
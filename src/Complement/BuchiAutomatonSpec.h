@@ -8,18 +8,32 @@
 #include <stack>
 #include <chrono>
 #include <algorithm>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
 
 #include <iostream>
 #include <algorithm>
 
 #include "../Algorithms/AuxFunctions.h"
+#include "../Algorithms/BitRelation.h"
+#include "../Algorithms/ParallelExplorer.h"
+#include "../Algorithms/SccExplorer.h"
 #include "../Automata/BuchiAutomaton.h"
+#include "../Automata/SubsetConstruction.h"
 #include "BuchiDelay.h"
 #include "ElevatorAutomaton.h"
+#include "AutomatonAnalysis.h"
 #include "StateKV.h"
 #include "RankFunc.h"
+#include "RankSuccCache.h"
+#include "RankFuncAntichain.h"
+#include "RankFuncEnumerator.h"
 #include "StateSch.h"
+#include "StateSchStore.h"
 #include "Options.h"
+#include "ComplProgress.h"
+#include "LazyComplement.h"
 #include "../Automata/StateSemiDet.h"
 
 using std::vector;
@@ -46,18 +60,124 @@ struct RankBound
 };
 
 /*
- * Successor cache data type
+ * Data of an automaton required by the successor functions of the tight
+ * part. The context is built once per complementation run and it is not
+ * modified afterwards (it can be shared by several threads).
  */
-typedef map<std::tuple<DFAState, int, int>, vector<std::pair<RankFunc,vector<RankFunc>>>> SuccRankCache;
+struct SuccContext
+{
+  // states and symbols are numbered from 0
+  int states;
+  int symbols;
+  DenseSet finals;
+  // SuccRank restriction (dense and map version required by RankFunc)
+  vector<int> minReach;
+  map<int, int> reachCons;
+  // targets of accepting transitions indexed by state*symbols + symbol
+  // (empty if the automaton does not have accepting transitions)
+  vector<DenseSet> accTargets;
+  std::unordered_map<DenseSet, int> maxReach;
+  std::unordered_map<DenseSet, RankBound> rankBound;
+
+  SuccContext(int states = 0, int symbols = 0) : states(states), symbols(symbols),
+    finals(), minReach(states, 0), reachCons(), accTargets(), maxReach(),
+    rankBound() { }
+
+  bool isAccepting(int from, int symbol, int to) const
+  {
+    return !accTargets.empty() && accTargets[from*symbols + symbol].contains(to);
+  }
+
+  /*
+   * Maximum reachable macrostate size (0 if the macrostate is unknown)
+   */
+  int getMaxReach(const DenseSet& macrostate) const
+  {
+    auto it = maxReach.find(macrostate);
+    return it != maxReach.end() ? it->second : 0;
+  }
+
+  /*
+   * Rank bound of a macrostate (zero bound if the macrostate is unknown)
+   */
+  const RankBound& getRankBound(const DenseSet& macrostate) const
+  {
+    static const RankBound empty = { 0, map<int, int>() };
+    auto it = rankBound.find(macrostate);
+    return it != rankBound.end() ? it->second : empty;
+  }
+};
 
 /*
- * Specified Buchi automata with complementation
+ * Automaton prepared for the optimized Schewe construction: the waiting part
+ * together with the results of the rank analysis and simulations. The object
+ * is not modified once it is created, hence several complementation runs or
+ * lazy successor queries (possibly in different threads) can share it.
+ */
+struct SchPrepared
+{
+  BuchiAutomaton<StateSch, int> waiting;
+  StateSch init;
+  // starting macrostates of the tight part
+  set<StateSch> tightStart;
+  // symbols allowing to enter the tight part (delay optimization)
+  map<StateSch, set<int>> tightStartDelay;
+  // sink states for macrostates with a nonempty self-loop language
+  map<std::pair<DenseSet, int>, StateSch> slTrans;
+  map<DenseSet, int> sinks;
+  // symbols of transitions to be generated in the tight part
+  map<DenseSet, set<int>> symsPred;
+  // the delay optimization is used
+  bool delay;
+  BackRel dirRel;
+  BackRel oddRel;
+  SuccContext ctx;
+
+  SchPrepared() : waiting(), init({DenseSet(), DenseSet(), RankFunc(), 0, false}),
+    tightStart(), tightStartDelay(), slTrans(), sinks(), symsPred(), delay(false),
+    dirRel(), oddRel(), ctx() { }
+
+  /*
+   * Is it allowed to enter the tight part from a macrostate over a symbol
+   * (delay optimization)
+   */
+  bool isDelayAllowed(const StateSch& st, int symbol) const
+  {
+    auto it = tightStartDelay.find(st);
+    return it != tightStartDelay.end() && it->second.count(symbol) > 0;
+  }
+
+  /*
+   * Is the tight part entered from a macrostate of the waiting part over a
+   * symbol (always without the delay optimization)
+   */
+  bool entersTight(const StateSch& st, int symbol) const
+  {
+    return !delay || isDelayAllowed(st, symbol);
+  }
+
+  /*
+   * Symbols of transitions generated in the tight part for a macrostate
+   * (empty if there is none)
+   */
+  const set<int>& getTightSymbols(const DenseSet& macrostate) const
+  {
+    static const set<int> empty;
+    auto it = symsPred.find(macrostate);
+    return it != symsPred.end() ? it->second : empty;
+  }
+};
+
+/*
+ * Specified Buchi automata with complementation. The analyses (rank bounds,
+ * simulations) modify the object; the constructions working on a prepared
+ * automaton (SchPrepared) are const and keep their exploration state (e.g.,
+ * the rank successor cache) local, so they can run concurrently.
  */
 class BuchiAutomatonSpec : public BuchiAutomaton<int, int>
 {
 private:
   map<DFAState, RankBound> rankBound;
-  SuccRankCache rankCache;
 
   map<DFAState, int> maxReach;
   map<int, int> reachCons;
@@ -66,10 +186,11 @@ private:
   set<StateSch> tightStartStates;
 
   ComplOptions opt;
-  ElevatorAutomaton elev;
+  std::shared_ptr<AutomatonAnalysis> analysis;
+  TransitionTable transTable;
 
 protected:
-  RankConstr rankConstr(vector<int>& max, set<int>& states);
+  RankConstr rankConstr(const vector<int>& max, const set<int>& states) const;
 
   vector<RankFunc> getKVRanks(vector<int>& max, set<int>& states);
   set<StateKV> succSetKV(StateKV& state, int symbol);
@@ -82,35 +203,49 @@ protected:
   vector<StateSch> succSetSchStart(set<int>& state, int rankBound, map<int, int> reachCons,
       map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel);
   vector<StateSch> succSetSchTight(StateSch& state, int symbol, map<int, int> reachCons,
-      map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel);
+      map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel, RankSuccCache& cache);
   bool isSchFinal(StateSch& state) const { return state.tight ? state.O.size() == 0 : state.S.size() == 0; }
-  bool getRankSuccCache(vector<RankFunc>& out, StateSch& state, int symbol);
+  static void setCacheStats(Stat *stats, const vector<RankSuccCache>& caches);
 
   bool acceptSl(StateSch& state, vector<int>& alp);
 
 
-  void getSchRanksTightOpt(vector<RankFunc>& out, vector<int>& max,
-      set<int>& states, StateSch& macrostate,
-      map<int, int> reachCons, int reachMax, BackRel& dirRel, BackRel& oddRel);
-  vector<StateSch> succSetSchStartOpt(set<int>& state, int rankBound, map<int, int> reachCons,
-      map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel);
-  vector<StateSch> succSetSchTightOpt(StateSch& state, int symbol, map<int, int> reachCons,
-      map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel);
+  void getSchRanksTightOpt(vector<RankFunc>& out, const vector<int>& max,
+      const set<int>& states, const StateSch& macrostate, const SuccContext& ctx,
+      int reachMax, const BackRel& dirRel, const BackRel& oddRel) const;
+  vector<StateSch> succSetSchStartOpt(const set<int>& state, int rankBound,
+      const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel) const;
+  vector<StateSch> succSetSchTightOpt(const StateSch& state, int symbol,
+      const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel,
+      RankSuccCache& cache) const;
 
-  vector<RankFunc> getFuncAntichain(set<RankFunc>& tmp, bool oddCheck=false) const;
+  vector<RankFunc> getFuncAntichain(const vector<RankFunc>& tmp, bool oddCheck=false) const;
+  map<DenseSet, set<int>> getTightSymbols(const BuchiAutomaton<StateSch, int>& comp) const;
 
 public:
-  BuchiAutomatonSpec(BuchiAutomaton<int, int> *t) : BuchiAutomaton<int, int>(*t), rankBound(),
-    rankCache(), maxReach(), reachCons(), slNonEmpty(), tightStartDelay(), tightStartStates(), elev(*t)
+  BuchiAutomatonSpec(BuchiAutomaton<int, int> *t) : BuchiAutomatonSpec(t, std::make_shared<AutomatonAnalysis>(*t)) { }
+
+  /*
+   * @param t Automaton to be complemented
+   * @param analysis Analysis of the automaton t (shared with other phases)
+   */
+  BuchiAutomatonSpec(BuchiAutomaton<int, int> *t, std::shared_ptr<AutomatonAnalysis> analysis) :
+    BuchiAutomaton<int, int>(*t), rankBound(), maxReach(), reachCons(), slNonEmpty(),
+    tightStartDelay(), tightStartStates(), analysis(analysis), transTable(t->getTransitionTable())
   {
     opt = { .cutPoint = false};
   }
 
   BackRel createBackRel(BuchiAutomaton<int, int>::StateRelation& rel);
+  BackRel createBackRel(const BitRelation& rel);
 
   BuchiAutomaton<StateKV, int> complementKV();
   BuchiAutomaton<StateSch, int> complementSch();
+  std::shared_ptr<const SchPrepared> prepareSchReduced(Stat *stats, bool updateBounds = true);
+  BuchiAutomaton<StateSch, int> complementSchReduced(const SchPrepared& prep, Stat *stats) const;
   BuchiAutomaton<StateSch, int> complementSchReduced(Stat *stats, bool updateBounds = true);
+  LazyComplement<StateSch> lazyComplementSchReduced(std::shared_ptr<const SchPrepared> prep) const;
+  LazyComplement<StateSch> lazyComplementSchReduced(Stat *stats);
   BuchiAutomaton<StateSch, int> complementSchNFA(set<int>& start);
   //BuchiAutomaton<StateSch, int> complementSchOpt(bool delay);
   BuchiAutomaton<StateSch, int> complementSchOpt(bool delay, std::set<int> originalFinals, double w, Stat *stats);
@@ -128,16 +263,23 @@ public:
     this->rankBound = rankbound;
   }
 
-  void setComplOptions(ComplOptions& co) { this->opt = co; }
+  void setComplOptions(ComplOptions& co)
+  {
+    this->opt = co;
+  }
   ComplOptions getComplOptions() const { return this->opt; }
 
-  void getSchRanksTightReduced(vector<RankFunc>& out, vector<int>& max,
-      set<int>& states, int symbol, StateSch& macrostate,
-      map<int, int> reachCons, int reachMax, BackRel& dirRel, BackRel& oddRel);
-  vector<StateSch> succSetSchStartReduced(set<int>& state, int rankBound, map<int, int> reachCons,
-      map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel, set<int> finals);
-  vector<StateSch> succSetSchTightReduced(StateSch& state, int symbol, map<int, int> reachCons,
-      map<DFAState, int> maxReach, BackRel& dirRel, BackRel& oddRel, set<int> finals);
+  SuccContext createSuccContext(const map<int, int>& reachCons, const map<DFAState, int>& maxReach) const;
+  void getSchRanksTightReduced(vector<RankFunc>& out, const vector<int>& max,
+      const set<int>& states, int symbol, const StateSch& macrostate,
+      const SuccContext& ctx, int reachMax, const BackRel& dirRel, const BackRel& oddRel,
+      RankSuccCache& cache) const;
+  vector<StateSch> succSetSchStartReduced(const set<int>& state, int rankBound,
+      const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel) const;
+  vector<StateSch> succSetSchStartPrepared(const SchPrepared& prep, const StateSch& state) const;
+  vector<StateSch> succSetSchTightReduced(const StateSch& state, int symbol,
+      const SuccContext& ctx, const BackRel& dirRel, const BackRel& oddRel,
+      RankSuccCache& cache) const;
 
   BuchiAutomaton<StateSemiDet, int> semidetermize();
 
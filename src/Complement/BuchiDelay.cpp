@@ -118,6 +118,164 @@ unsigned BuchiAutomatonDelay<Symbol> :: getAllPossibleRankings(unsigned maxRank,
   }
 }
 
+/*
+ * Estimate the number of rankings of a macrostate (the same count as the
+ * version with Stirling numbers) without an overflow
+ * @param maxRank Maximum rank
+ * @param accStates Number of accepting states
+ * @param nonAccStates Number of nonaccepting states
+ * @param comb Tables of combinatorial numbers
+ * @return Logarithm of the number of rankings (-infinity if there is none)
+ */
+template<typename Symbol>
+double BuchiAutomatonDelay<Symbol> :: getLogRankings(unsigned maxRank, unsigned accStates, unsigned nonAccStates, LogCombinatorics& comb){
+  unsigned count = (maxRank+1)/2;
+  double odd = -std::numeric_limits<double>::infinity();
+  if (count == 0)
+    return odd;
+  for (unsigned k = 1; k <= count && k <= nonAccStates; k++)
+    odd = LogCombinatorics::logSum(odd, comb.surjections(nonAccStates, k));
+  return accStates * std::log((double)count) + odd;
+}
+
+/*
+ * Get states closing a cycle in the automaton graph in polynomial time
+ * (cycles are not enumerated). Nontrivial SCCs are processed one by one:
+ * states whose successors in the SCC have no rankings cover their cycles
+ * without generating any transitions; otherwise a state minimizing
+ * rankings^w / cycles^(1-w) is picked (the number of cycles through a
+ * state is approximated by the product of its in- and out-degree in the
+ * SCC). The picked states are removed and the rest of the SCC is split
+ * into SCCs again, until no cycle remains.
+ * @params dmap Delay map (mapping assigning information about macrostates for the Delay optimization)
+ * @params w Weight of rankings
+ * @return Set of states and symbols for which transitions to the tight part should be generated
+ */
+template <typename Symbol>
+std::map<StateSch, std::set<Symbol>> BuchiAutomatonDelay<Symbol> :: getCycleClosingStatesFvs(DelayMap<StateSch>& dmap, double w) {
+  const double zero = -std::numeric_limits<double>::infinity();
+  std::vector<StateSch> states(this->getStates().begin(), this->getStates().end());
+  std::map<StateSch, int> pos;
+  for (unsigned i = 0; i < states.size(); i++)
+    pos.emplace_hint(pos.end(), states[i], i);
+
+  std::vector<std::vector<std::pair<int, Symbol>>> edges(states.size());
+  AdjList adj(states.size());
+  for (const auto& tr : this->getTransitions()){
+    auto from = pos.find(tr.first.first);
+    if (from == pos.end())
+      continue;
+    for (const StateSch& d : tr.second){
+      auto to = pos.find(d);
+      if (to == pos.end())
+        continue;
+      edges[from->second].push_back({to->second, tr.first.second});
+      adj[from->second].push_back(to->second);
+    }
+  }
+
+  // rankings of the tight successors of each state
+  LogCombinatorics comb;
+  std::vector<double> weight(states.size(), zero);
+  for (unsigned i = 0; i < states.size(); i++){
+    const DelayLabel& lab = dmap[states[i]];
+    if (lab.maxRank != 0)
+      weight[i] = this->getLogRankings(lab.maxRank, lab.macrostateSize - lab.nonAccStates, lab.nonAccStates, comb);
+  }
+
+  // position of a state in the processed set of states (-1 if it is not there)
+  std::vector<int> local(states.size(), -1);
+  std::vector<std::vector<int>> work;
+  auto addCycles = [&](const std::vector<int>& vert){
+    for (unsigned i = 0; i < vert.size(); i++)
+      local[vert[i]] = i;
+    AdjList ladj(vert.size());
+    for (unsigned i = 0; i < vert.size(); i++){
+      for (int d : adj[vert[i]]){
+        if (local[d] != -1)
+          ladj[i].push_back(local[d]);
+      }
+    }
+    for (int v : vert)
+      local[v] = -1;
+    Condensation cond(ladj);
+    for (unsigned c = 0; c < cond.size(); c++){
+      if (cond.isTrivial(c))
+        continue;
+      std::vector<int> scc;
+      for (int l : cond.getVertices(c))
+        scc.push_back(vert[l]);
+      work.push_back(scc);
+    }
+  };
+
+  std::map<StateSch, std::set<Symbol>> statesToGenerate;
+  for (const StateSch& st : states)
+    statesToGenerate[st];
+  std::vector<int> all(states.size());
+  std::iota(all.begin(), all.end(), 0);
+  addCycles(all);
+
+  while (not work.empty()){
+    std::vector<int> scc = std::move(work.back());
+    work.pop_back();
+    for (unsigned i = 0; i < scc.size(); i++)
+      local[scc[i]] = i;
+
+    std::vector<double> rankings(scc.size(), zero);
+    std::vector<unsigned> inDeg(scc.size(), 0);
+    std::vector<unsigned> outDeg(scc.size(), 0);
+    for (unsigned i = 0; i < scc.size(); i++){
+      std::set<int> succ;
+      for (const auto& e : edges[scc[i]]){
+        if (local[e.first] != -1)
+          succ.insert(e.first);
+      }
+      for (int d : succ){
+        rankings[i] = LogCombinatorics::logSum(rankings[i], weight[d]);
+        outDeg[i]++;
+        inDeg[local[d]]++;
+      }
+    }
+
+    std::vector<unsigned> removed;
+    for (unsigned i = 0; i < scc.size(); i++){
+      if (std::isinf(rankings[i]))
+        removed.push_back(i);
+    }
+    if (removed.empty()){
+      unsigned best = 0;
+      double bestScore = 0.0;
+      for (unsigned i = 0; i < scc.size(); i++){
+        double score = w*rankings[i] - (1-w)*std::log((double)inDeg[i]*outDeg[i]);
+        if (i == 0 or score < bestScore or (not (score > bestScore) and
+          dmap[states[scc[i]]].maxRank < dmap[states[scc[best]]].maxRank)){
+          best = i;
+          bestScore = score;
+        }
+      }
+      removed.push_back(best);
+      std::set<Symbol>& symbols = statesToGenerate[states[scc[best]]];
+      for (const auto& e : edges[scc[best]]){
+        if (local[e.first] != -1)
+          symbols.insert(e.second);
+      }
+    }
+
+    for (unsigned i : removed)
+      local[scc[i]] = -1;
+    std::vector<int> rest;
+    for (int v : scc){
+      if (local[v] != -1)
+        rest.push_back(v);
+      local[v] = -1;
+    }
+    addCycles(rest);
+  }
+
+  return statesToGenerate;
+}
+
 /*
  * Get states closing a cycle in the automaton graph
  * @params slignore States containing self-loops to be ignored
@@ -140,6 +298,16 @@ std::map<StateSch, std::set<Symbol>> BuchiAutomatonDelay<Symbol> :: getCycleClos
   auto trans = this->getTransitions();
   srand(time(0));
 
+  // cycles are not enumerated
+  if (version == fvsVersion){
+    auto start = std::chrono::high_resolution_clock::now();
+    statesToGenerate = this->getCycleClosingStatesFvs(dmap, w);
+    auto end = std::chrono::high_resolution_clock::now();
+    stats->getAllCycles = 0;
+    stats->statesToGenerate = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    return statesToGenerate;
+  }
+
   // get all cycles
   auto start = std::chrono::high_resolution_clock::now();
   allCycles = this->getAllCycles();
@@ -8,11 +8,14 @@
 #include <stack>
 #include <chrono>
 #include <cmath>
+#include <limits>
+#include <numeric>
 
 #include <iostream>
 #include <algorithm>
 
 #include "../Algorithms/AuxFunctions.h"
+#include "../Algorithms/LogCombinatorics.h"
 #include "../Automata/BuchiAutomaton.h"
 #include "StateKV.h"
 #include "RankFunc.h"
@@ -24,7 +27,8 @@ enum DelayVersion : unsigned
   newVersion,
   randomVersion,
   subsetVersion,
-  stirlingVersion
+  stirlingVersion,
+  fvsVersion
 };
 
 template <typename Symbol>
@@ -40,6 +44,8 @@ public:
     std::set<int> scc, AdjList adjlist, int startState, std::vector<std::vector<int>> &allCyclesRenamed);
   void unblock(int state, std::set<int> &blockedSet, std::map<int, std::set<int>> &blockedMap);
   unsigned getAllPossibleRankings(unsigned maxRank, unsigned accStates, unsigned nonAccStates, DelayVersion version);
+  double getLogRankings(unsigned maxRank, unsigned accStates, unsigned nonAccStates, LogCombinatorics& comb);
+  std::map<StateSch, std::set<Symbol>> getCycleClosingStatesFvs(DelayMap<StateSch>& dmap, double w);
   std::map<StateSch, std::set<Symbol>> getCycleClosingStates(set<StateSch>& slignore, DelayMap<StateSch>& dmap, double w, DelayVersion version, Stat *stats);
 };
 
@@ -1,180 +1,195 @@
 
 #include "CoBuchiCompl.h"
 
-BuchiAutomaton<StateGcoBA, int> CoBuchiAutomatonCompl::complementCoBA()
+/*
+ * Complementation of co-Buchi automata
+ * @param threads Number of threads expanding the macrostates
+ * @return Complemented automaton
+ */
+BuchiAutomaton<StateGcoBA, int> CoBuchiAutomatonCompl::complementCoBA(unsigned threads)
 {
-  //assert(false && "complementCoBA is not implemented");
-
-  auto alph = this->getAlphabet();
-  map<std::pair<StateGcoBA, int>, set<StateGcoBA>> mp;
-  std::set<StateGcoBA> states;
-  std::set<StateGcoBA> finals;
-
-  auto finalStates = this->getFinals()[0];
-
-  // initial states
-  std::set<StateGcoBA> initials;
-  StateGcoBA init = {.S = this->getInitials(), .B = set<int>(), .i = 0};
-  init.B.clear();
-  std::set_difference(this->getInitials().begin(), this->getInitials().end(), finalStates.begin(), finalStates.end(), std::inserter(init.B, init.B.begin()));
-  initials.insert(init);
-  states.insert(init);
-  if (init.B.size() == 0 or init.S.size() == 0)
-    finals.insert(init);
-
-  // push initial state on stack
-  std::stack<StateGcoBA> stack;
-  stack.push(init);
-  while (not stack.empty()){
-    // pop state from stack
-    StateGcoBA state = stack.top();
-    stack.pop();
-
-    // generate transitions and new states
-    for (int sym : alph){
-        auto pr = std::make_pair(state, sym);
-        std::set<StateGcoBA> dst;
-
-        auto S_prime = succSet(state.S, sym);
-        std::set<int> B_prime;
-
-        if (state.B.empty()){
-            std::set_difference(S_prime.begin(), S_prime.end(), finalStates.begin(), finalStates.end(), std::inserter(B_prime, B_prime.begin()));
-        } else {
-            auto tmp = succSet(state.B, sym);
-            std::set_difference(tmp.begin(), tmp.end(), finalStates.begin(), finalStates.end(), std::inserter(B_prime, B_prime.begin()));
-        }
-
-        StateGcoBA newState = {.S = S_prime, .B = B_prime, .i = 0};
-
-        // push new state on stack
-        dst.insert(newState);
-        if (states.find(newState) == states.end()){
-            states.insert(newState);
-            stack.push(newState);
-            if ((newState.B.size() == 0) or newState.S.size() == 0)
-              finals.insert(newState);
-        }
-
-        // transitions
-        mp.insert({pr, dst});
-    }
-  }
+  this->transTable = this->getTransitionTable();
+  DenseSet finalStates(this->getFinals()[0]);
+
+  StateGcoBA init = {.S = this->getInitials(), .B = DenseSet(), .i = 0};
+  init.B = init.S - finalStates;
 
-  auto ret = BuchiAutomaton<StateGcoBA, int>(states, finals, initials, mp, alph, getAPPattern());
+  auto succ = [this, &finalStates](const StateGcoBA& st, int sym) -> vector<StateGcoBA>
+  {
+    return {getSuccessor(st, sym, finalStates)};
+  };
+  SubsetConstruction<StateGcoBA, int> constr(this->getAlphabet(), succ, isCoBAFinal,
+    stateHash, threads);
+  auto ret = constr.construct({init});
+  ret.setAPPattern(getAPPattern());
   //std::cerr << ret.toString() << std::endl;
   return ret;
 }
 
+/*
+ * Complementation of co-Buchi automata with simulation pruning/saturation
+ * @param opt Complementation options
+ * @return Complemented automaton
+ */
 BuchiAutomaton<StateGcoBA, int> CoBuchiAutomatonCompl::complementCoBASim(ComplOptions opt){
 
   /*for (auto pr : this->getWeakDirSim()){
     std::cout << pr.first << " < " << pr.second << std::endl;
   }*/
 
-  Relation<int> sim;
-  set<int> (CoBuchiAutomatonCompl::*getSet)(set<int>&, Relation<int>&) = NULL;
+  BitRelation sim;
+  SetFunc getSet = simSetFunc(opt, sim);
+
+  this->transTable = this->getTransitionTable();
+  DenseSet finalStates(this->getFinals()[0]);
+
+  auto initialsSim = (this->*getSet)(DenseSet(this->getInitials()), sim);
+  StateGcoBA init = {.S = initialsSim, .B = DenseSet(), .i = 0};
+  init.B = init.S - finalStates;
+
+  auto succ = [this, &finalStates, &sim, getSet](const StateGcoBA& st, int sym) -> vector<StateGcoBA>
+  {
+    return {getSuccessorSim(st, sym, finalStates, sim, getSet)};
+  };
+  SubsetConstruction<StateGcoBA, int> constr(this->getAlphabet(), succ, isCoBAFinal,
+    stateHash, opt.threads);
+  auto ret = constr.construct({init});
+  ret.setAPPattern(getAPPattern());
+  //std::cerr << ret.toString() << std::endl;
+  return ret;
+}
+
+/*
+ * Successor of a macrostate in the complementation of co-Buchi automata
+ * @param state Macrostate
+ * @param sym Symbol
+ * @param finalStates Final states of the co-Buchi automaton
+ * @return Successor macrostate
+ */
+StateGcoBA CoBuchiAutomatonCompl::getSuccessor(const StateGcoBA& state, int sym, const DenseSet& finalStates)
+{
+  DenseSet S_prime = succSet(state.S, sym);
+  DenseSet B_prime;
+
+  if (state.B.empty()){
+      B_prime = S_prime - finalStates;
+  } else {
+      B_prime = succSet(state.B, sym) - finalStates;
+  }
+
+  return {.S = S_prime, .B = B_prime, .i = 0};
+}
+
+/*
+ * Successor of a macrostate in the complementation of co-Buchi automata
+ * with simulation pruning/saturation
+ * @param state Macrostate
+ * @param sym Symbol
+ * @param finalStates Final states of the co-Buchi automaton
+ * @param sim Simulation relation
+ * @param getSet Function pruning/saturating sets of states wrt sim
+ * @return Successor macrostate
+ */
+StateGcoBA CoBuchiAutomatonCompl::getSuccessorSim(const StateGcoBA& state, int sym, const DenseSet& finalStates,
+  const BitRelation& sim, SetFunc getSet)
+{
+  DenseSet S_prime = (this->*getSet)(succSet(state.S, sym), sim);
+  DenseSet B_prime;
+  if (state.B.empty()){
+      B_prime = S_prime - finalStates;
+  } else {
+      B_prime = (succSet(state.B, sym) & S_prime) - finalStates;
+  }
+
+  return {.S = S_prime, .B = B_prime, .i = 0};
+}
+
+/*
+ * Get the simulation and the corresponding set function wrt options
+ * @param opt Complementation options (iwSim/iwSat)
+ * @param sim Out parameter for the simulation relation
+ * @return Function pruning/saturating sets of states (NULL if none is set)
+ */
+CoBuchiAutomatonCompl::SetFunc CoBuchiAutomatonCompl::simSetFunc(ComplOptions& opt, BitRelation& sim)
+{
   if (opt.iwSim){
     sim = this->getWeakDirSim();
-    getSet = &CoBuchiAutomatonCompl::getDirectSet;
+    return &CoBuchiAutomatonCompl::getDirectSet;
   }
   else if (opt.iwSat){
     sim = this->getDirSim();
-    getSet = &CoBuchiAutomatonCompl::getSatSet;
+    return &CoBuchiAutomatonCompl::getSatSet;
   }
+  return NULL;
+}
 
-  auto alph = this->getAlphabet();
-  map<std::pair<StateGcoBA, int>, set<StateGcoBA>> mp;
-  std::set<StateGcoBA> states;
-  std::set<StateGcoBA> finals;
-
-  // initial states
-  std::set<StateGcoBA> initials;
-  auto initialsSim = (this->*getSet)(this->getInitials(), sim);
-  StateGcoBA init = {.S = initialsSim, .B = set<int>(), .i = 0};
-  init.B.clear();
-  std::set_difference(initialsSim.begin(), initialsSim.end(), this->getFinals()[0].begin(), this->getFinals()[0].end(), std::inserter(init.B, init.B.begin()));
-  initials.insert(init);
-  states.insert(init);
-  if (init.B.size() == 0 or init.S.size() == 0)
-    finals.insert(init);
-
-  // push initial state on stack
-  std::stack<StateGcoBA> stack;
-  stack.push(init);
-  while (not stack.empty()){
-    // pop state from stack
-    StateGcoBA state = stack.top();
-    stack.pop();
-
-    // generate transitions and new states
-    for (int sym : alph){
-        auto pr = std::make_pair(state, sym);
-        std::set<StateGcoBA> dst;
-
-        auto ssucc = succSet(state.S, sym);
-        auto S_prime = (this->*getSet)(ssucc, sim);
-        std::set<int> B_prime;
-        if (state.B.empty()){
-            std::set_difference(S_prime.begin(), S_prime.end(), this->getFinals()[0].begin(), this->getFinals()[0].end(), std::inserter(B_prime, B_prime.begin()));
-        } else {
-            auto tmp = succSet(state.B, sym);
-            std::vector<int> intersectionSet;
-            std::set_intersection(tmp.begin(), tmp.end(), S_prime.begin(), S_prime.end(), std::back_inserter(intersectionSet));
-            std::set_difference(intersectionSet.begin(), intersectionSet.end(), this->getFinals()[state.i].begin(), this->getFinals()[state.i].end(), std::inserter(B_prime, B_prime.begin()));
-        }
-
-        StateGcoBA newState = {.S = S_prime, .B = B_prime, .i = 0};
-
-        // push new state on stack
-        dst.insert(newState);
-        if (states.find(newState) == states.end()){
-            states.insert(newState);
-            stack.push(newState);
-            if ((newState.B.size() == 0) or newState.S.size() == 0)
-              finals.insert(newState);
-        }
-
-        // transitions
-        mp.insert({pr, dst});
-    }
-  }
+/*
+ * Complementation of co-Buchi automata constructed on demand (the
+ * automaton has to outlive the returned object)
+ * @return Lazy complement
+ */
+LazyComplement<StateGcoBA> CoBuchiAutomatonCompl::lazyComplementCoBA()
+{
+  this->transTable = this->getTransitionTable();
+  DenseSet finalStates(this->getFinals()[0]);
 
-  auto ret = BuchiAutomaton<StateGcoBA, int>(states, finals, initials, mp, alph, getAPPattern());
-  //std::cerr << ret.toString() << std::endl;
-  return ret;
+  StateGcoBA init = {.S = this->getInitials(), .B = DenseSet(), .i = 0};
+  init.B = init.S - finalStates;
+
+  auto succ = [this, finalStates](const StateGcoBA& st, int sym) -> vector<StateGcoBA>
+  {
+    return {getSuccessor(st, sym, finalStates)};
+  };
+  return LazyComplement<StateGcoBA>({init}, this->getAlphabet(), succ, isCoBAFinal);
 }
 
-set<int> CoBuchiAutomatonCompl::succSet(set<int>& states, int symbol)
+/*
+ * Complementation of co-Buchi automata with simulation constructed on
+ * demand (the automaton has to outlive the returned object)
+ * @param opt Complementation options
+ * @return Lazy complement
+ */
+LazyComplement<StateGcoBA> CoBuchiAutomatonCompl::lazyComplementCoBASim(ComplOptions opt)
 {
-  set<int> ret;
-  for(int st : states)
+  auto sim = std::make_shared<BitRelation>();
+  SetFunc getSet = simSetFunc(opt, *sim);
+
+  this->transTable = this->getTransitionTable();
+  DenseSet finalStates(this->getFinals()[0]);
+
+  StateGcoBA init = {.S = (this->*getSet)(DenseSet(this->getInitials()), *sim), .B = DenseSet(), .i = 0};
+  init.B = init.S - finalStates;
+
+  auto succ = [this, finalStates, sim, getSet](const StateGcoBA& st, int sym) -> vector<StateGcoBA>
   {
-    set<int> dst = getTransitions()[std::make_pair(st, symbol)];
-    ret.insert(dst.begin(), dst.end());
-  }
-  return ret;
+    return {getSuccessorSim(st, sym, finalStates, *sim, getSet)};
+  };
+  return LazyComplement<StateGcoBA>({init}, this->getAlphabet(), succ, isCoBAFinal);
 }
 
-set<int> CoBuchiAutomatonCompl::getDirectSet(set<int>& states, Relation<int>& dirSim)
+DenseSet CoBuchiAutomatonCompl::succSet(const DenseSet& states, int symbol)
 {
-  // remove smaller states w.r.t. direct simulation on weak automaton
-  std::set<int> retStates;
-  for (const auto& state : states){
-    if (not std::any_of(dirSim.begin(), dirSim.end(), [state, states](std::pair<int, int> pr){ return state == pr.first and state != pr.second and states.find(pr.second) != states.end(); }))
-      retStates.insert(state);
-  }
-
-  return retStates;
+  return this->transTable.succSet(states, symbol);
 }
 
-set<int> CoBuchiAutomatonCompl::getSatSet(set<int>& allStates, Relation<int>& dirSim){
-  // add smaller states w.r.t. direct simulation on weak automaton
-  std::set<int> retStates = allStates;
-  for (const auto& pr : dirSim){
-    if (allStates.find(pr.second) != allStates.end())
-      retStates.insert(pr.first);
-  }
+/*
+ * Remove states simulated by another state of the set
+ * @param states Set of states
+ * @param dirSim Direct simulation on the weak automaton
+ * @return Pruned set of states
+ */
+DenseSet CoBuchiAutomatonCompl::getDirectSet(const DenseSet& states, const BitRelation& dirSim)
+{
+  return dirSim.removeSmaller(states);
+}
 
-  return retStates;
+/*
+ * Add states simulated by some state of the set
+ * @param allStates Set of states
+ * @param dirSim Direct simulation on the weak automaton
+ * @return Saturated set of states
+ */
+DenseSet CoBuchiAutomatonCompl::getSatSet(const DenseSet& allStates, const BitRelation& dirSim)
+{
+  return allStates | dirSim.downwardClosure(allStates);
 }
@@ -8,16 +8,22 @@
 #include <vector>
 #include <stack>
 #include <chrono>
+#include <memory>
 
 #include <iostream>
 #include <algorithm>
 
 #include "../Algorithms/AuxFunctions.h"
+#include "../Algorithms/BitRelation.h"
 #include "../Automata/BuchiAutomaton.h"
 #include "../Automata/GenCoBuchiAutomaton.h"
+#include "../Automata/SubsetConstruction.h"
 #include "StateGcoBA.h"
 #include "Options.h"
+#include "ComplProgress.h"
+#include "LazyComplement.h"
 #include "../Algorithms/Simulations.h"
+#include "AutomatonAnalysis.h"
 
 using std::vector;
 using std::set;
@@ -27,20 +33,42 @@ class CoBuchiAutomatonCompl : public GeneralizedCoBuchiAutomaton<int, int>
 {
 
 private:
-  Relation<int> dirSim;
-  Relation<int> reachDirSim;
+  BitRelation dirSim;
+  BitRelation reachDirSim;
+  TransitionTable transTable;
 
-public:
-  CoBuchiAutomatonCompl(GeneralizedCoBuchiAutomaton<int, int> *t) : GeneralizedCoBuchiAutomaton<int, int>(*t) { }
+  typedef DenseSet (CoBuchiAutomatonCompl::*SetFunc)(const DenseSet&, const BitRelation&);
+
+  StateGcoBA getSuccessor(const StateGcoBA& state, int sym, const DenseSet& finalStates);
+  StateGcoBA getSuccessorSim(const StateGcoBA& state, int sym, const DenseSet& finalStates,
+    const BitRelation& sim, SetFunc getSet);
+  SetFunc simSetFunc(ComplOptions& opt, BitRelation& sim);
 
-  CoBuchiAutomatonCompl(BuchiAutomaton<int,int>& inhWeakBA)
+  static bool isCoBAFinal(const StateGcoBA& st) { return st.B.size() == 0 or st.S.size() == 0; }
+  static std::size_t stateHash(const StateGcoBA& st) { return st.hash(); }
+
+public:
+  CoBuchiAutomatonCompl(GeneralizedCoBuchiAutomaton<int, int> *t) : GeneralizedCoBuchiAutomaton<int, int>(*t),
+    dirSim(), reachDirSim(), transTable() { }
+
+  CoBuchiAutomatonCompl(BuchiAutomaton<int,int>& inhWeakBA) : CoBuchiAutomatonCompl(inhWeakBA,
+    std::make_shared<AutomatonAnalysis>(inhWeakBA)) { }
+
+  /*
+   * @param inhWeakBA Inherently weak automaton (accepting states are changed
+   *        to make it weak)
+   * @param analysis Analysis of the automaton inhWeakBA (shared with other phases)
+   */
+  CoBuchiAutomatonCompl(BuchiAutomaton<int,int>& inhWeakBA, std::shared_ptr<AutomatonAnalysis> analysis) :
+    dirSim(), reachDirSim(), transTable()
   {
     // convert inherently weak to co-BA
-    auto sccs = inhWeakBA.getAutGraphSCCs();
+    const Condensation& cond = analysis->getCondensation();
     auto finals = inhWeakBA.getFinals();
     auto finTrans = inhWeakBA.getFinTrans();
     std::set<int> fins;
-    for (auto scc : sccs){
+    for (unsigned c = 0; c < cond.size(); c++){
+      std::set<int> scc(cond.getVertices(c).begin(), cond.getVertices(c).end());
       if ((not std::any_of(scc.begin(), scc.end(), [finals](int state){return finals.find(state) != finals.end();})) and
           (not std::any_of(finTrans.begin(), finTrans.end(), [scc](auto tr){return scc.find(tr.from) != scc.end() and scc.find(tr.to) != scc.end();})))
         fins.insert(scc.begin(), scc.end());
@@ -55,22 +83,18 @@ public:
     inhWeakBA.setFinals(weakFins);
 
     // compute direct sim on weak automaton
-    this->dirSim = inhWeakBA.getDirectSim();
+    int n = inhWeakBA.getStates().size();
+    this->dirSim = BitRelation(inhWeakBA.getDirectSim(), n);
 
     // reachability
-    Relation<int> rel;
-    SCCs reachabilityVector = inhWeakBA.reachableVector();
-    for (auto pr : this->dirSim){
-      // check reachability
-      //if (reachabilityVector[pr.second].find(pr.first) == reachabilityVector[pr.second].end())
-
-      set<int> intersect;
-      std::set_intersection(reachabilityVector[pr.first].begin(), reachabilityVector[pr.first].end(), reachabilityVector[pr.second].begin(), reachabilityVector[pr.second].end(), std::inserter(intersect, intersect.begin()));
-      if(intersect.size() == 0)
-        rel.insert(pr);
-
-      if (reachabilityVector[pr.first].find(pr.second) != reachabilityVector[pr.first].end() and reachabilityVector[pr.second].find(pr.first) == reachabilityVector[pr.second].end())
-        rel.insert(pr);
+    BitRelation rel(n);
+    const Reachability& reach = analysis->getReachability();
+    for (int p = 0; p < n; p++){
+      for (int q : this->dirSim.row(p)){
+        // check reachability
+        if (not reach.reachCommon(p, q) or (reach.isReachable(p, q) and not reach.isReachable(q, p)))
+          rel.add(p, q);
+      }
     }
     this->reachDirSim = rel;
 
@@ -81,17 +105,19 @@ public:
     this->apsPattern = inhWeakBA.getAPPattern();
   }
 
-  BuchiAutomaton<StateGcoBA, int> complementCoBA();
+  BuchiAutomaton<StateGcoBA, int> complementCoBA(unsigned threads = 1);
   BuchiAutomaton<StateGcoBA, int> complementCoBASim(ComplOptions opt);
-  set<int> succSet(set<int>& states, int symbol);
-  set<int> getDirectSet(set<int>& states, Relation<int>& dirSim);
-  set<int> getSatSet(set<int>& allStates, Relation<int>& dirSim);
+  LazyComplement<StateGcoBA> lazyComplementCoBA();
+  LazyComplement<StateGcoBA> lazyComplementCoBASim(ComplOptions opt);
+  DenseSet succSet(const DenseSet& states, int symbol);
+  DenseSet getDirectSet(const DenseSet& states, const BitRelation& dirSim);
+  DenseSet getSatSet(const DenseSet& allStates, const BitRelation& dirSim);
 
-  Relation<int>& getWeakDirSim(){
+  BitRelation& getWeakDirSim(){
     return this->reachDirSim;
   }
 
-  Relation<int>& getDirSim(){
+  BitRelation& getDirSim(){
     return this->dirSim;
   }
 };
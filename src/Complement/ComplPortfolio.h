@@ -0,0 +1,119 @@
+#ifndef _COMPL_PORTFOLIO_H_
+#define _COMPL_PORTFOLIO_H_
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+
+#include "ComplProgress.h"
+
+/*
+ * Portfolio of complementation engines. Candidates run concurrently (each
+ * in its own thread) and report their number of generated states. The
+ * results are compared by their sizes after trimming, which is not known
+ * for running candidates. A running candidate is therefore compared with
+ * the best finished one by the number of generated states: it is cancelled
+ * once it has reported more states than the best finished candidate
+ * reported at its end (both counts are taken from the progress, so that
+ * the same measure is compared). The cancellation is a heuristic (a cancelled candidate might
+ * have given a smaller result after trimming).
+ */
+class ComplPortfolio
+{
+private:
+  struct Candidate
+  {
+    std::function<size_t()> engine;
+    ComplProgress progress;
+    bool finished;
+    size_t size;
+    std::exception_ptr error;
+
+    Candidate(std::function<size_t()> eng) : engine(eng), progress(),
+      finished(false), size(0), error() { }
+  };
+
+  std::vector<std::unique_ptr<Candidate>> candidates;
+  // the finished candidate with the smallest result
+  Candidate* best;
+  std::mutex lock;
+
+  void runCandidate(Candidate& cand)
+  {
+    ComplProgress::setActive(&cand.progress);
+    try
+    {
+      size_t size = cand.engine();
+      std::lock_guard<std::mutex> guard(this->lock);
+      cand.finished = true;
+      cand.size = size;
+      if(this->best == nullptr || size < this->best->size)
+      {
+        this->best = &cand;
+        for(auto& other : this->candidates)
+        {
+          if(other.get() != &cand)
+            other->progress.setLimit(cand.progress.getStates());
+        }
+      }
+    }
+    catch(const ComplCancelled&) { }
+    catch(...)
+    {
+      cand.error = std::current_exception();
+    }
+    ComplProgress::setActive(nullptr);
+  }
+
+public:
+  ComplPortfolio() : candidates(), best(nullptr), lock() { }
+
+  ComplPortfolio(const ComplPortfolio&) = delete;
+  ComplPortfolio& operator=(const ComplPortfolio&) = delete;
+
+  /*
+   * Add a candidate engine
+   * @param engine Function computing the complement and returning the
+   *        size of the trimmed complement
+   * @return Index of the candidate
+   */
+  unsigned add(std::function<size_t()> engine)
+  {
+    this->candidates.push_back(std::unique_ptr<Candidate>(new Candidate(engine)));
+    return this->candidates.size() - 1;
+  }
+
+  /*
+   * Run all candidates concurrently and wait for them. If no candidate
+   * finishes, the first error of a candidate is rethrown.
+   */
+  void run()
+  {
+    std::vector<std::thread> threads;
+    for(unsigned i = 1; i < this->candidates.size(); i++)
+      threads.emplace_back([this, i]() { this->runCandidate(*this->candidates[i]); });
+    if(!this->candidates.empty())
+      runCandidate(*this->candidates[0]);
+    for(std::thread& t : threads)
+      t.join();
+
+    for(const auto& cand : this->candidates)
+    {
+      if(cand->finished)
+        return;
+    }
+    for(const auto& cand : this->candidates)
+    {
+      if(cand->error)
+        std::rethrow_exception(cand->error);
+    }
+  }
+
+  bool isFinished(unsigned i) const { return this->candidates[i]->finished; }
+  size_t getSize(unsigned i) const { return this->candidates[i]->size; }
+};
+
+#endif
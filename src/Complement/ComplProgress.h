@@ -0,0 +1,83 @@
+#ifndef _COMPL_PROGRESS_H_
+#define _COMPL_PROGRESS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+
+/*
+ * Exception thrown when a running complementation is cancelled
+ */
+class ComplCancelled : public std::exception
+{
+public:
+  const char* what() const noexcept override
+  {
+    return "complementation cancelled";
+  }
+};
+
+/*
+ * Progress of a complementation running in a portfolio. Engines report the
+ * number of generated states (states already dropped as dead are not
+ * counted, hence the number reported at the end is the size of the
+ * untrimmed result); once the number exceeds the limit (the number of states
+ * generated by the best finished complementation), the complementation is
+ * cancelled by throwing ComplCancelled. Engines report to the progress of
+ * the current thread (no progress is set outside of the portfolio, i.e.,
+ * reporting is a no-op).
+ */
+class ComplProgress
+{
+private:
+  std::atomic<size_t> states;
+  std::atomic<size_t> limit;
+
+  static ComplProgress*& activeProgress()
+  {
+    static thread_local ComplProgress* active = nullptr;
+    return active;
+  }
+
+public:
+  ComplProgress() : states(0), limit(SIZE_MAX) { }
+
+  size_t getStates() const { return this->states; }
+  size_t getLimit() const { return this->limit; }
+
+  /*
+   * Set the limit of generated states
+   * @param lim New limit
+   */
+  void setLimit(size_t lim)
+  {
+    this->limit = lim;
+  }
+
+  /*
+   * Update the number of generated states
+   * @param cnt Number of generated states
+   */
+  void update(size_t cnt)
+  {
+    this->states = cnt;
+    if(cnt > this->limit)
+      throw ComplCancelled();
+  }
+
+  static ComplProgress* getActive() { return activeProgress(); }
+  static void setActive(ComplProgress* progress) { activeProgress() = progress; }
+
+  /*
+   * Report the number of generated states to the progress of the current thread
+   * @param cnt Number of generated states
+   */
+  static void report(size_t cnt)
+  {
+    ComplProgress* act = activeProgress();
+    if(act != nullptr)
+      act->update(cnt);
+  }
+};
+
+#endif
@@ -85,16 +85,26 @@ bool ElevatorAutomaton::isInherentlyWeak(const std::set<int>& scc, map<int, set<
 }
 
 BuchiAutomaton<int ,int> ElevatorAutomaton::propagateAccStates(){
+  return propagateAccStates(this->sccClassification());
+}
+
+/*
+ * Mark states whose transitions inside their SCC all lead to (or come from)
+ * accepting states as accepting
+ * @param sccClass Classified SCCs (see sccClassification)
+ * @return Automaton with propagated accepting states
+ */
+BuchiAutomaton<int ,int> ElevatorAutomaton::propagateAccStates(const std::vector<SccClassif>& sccClass){
   BuchiAutomaton<int, int> ret(*this);
   set<int> fins = ret.getFinals();
   auto finTrans = this->getFinTrans();
 
   map<int, set<int>> predSyms = this->getPredSymbolMap();
   map<int, set<int>> revSyms = this->getReverseSymbolMap();
-  vector<set<int>> sccs = this->getAutGraphSCCs();
 
   bool change;
-  for (auto scc : sccs){
+  for (const auto& cl : sccClass){
+    const set<int>& scc = cl.states;
     do {
       change = false;
       for (auto state : scc){
@@ -124,33 +134,49 @@ BuchiAutomaton<int ,int> ElevatorAutomaton::propagateAccStates(){
   return ret;
 }
 
-BuchiAutomaton<int, int> ElevatorAutomaton::copyPreprocessing(const std::function<bool(SccClassif)>& pred)
-{
-  BuchiAutomaton<int, int> aut(*this);
-  BuchiAutomaton<int, int> ret(*this);
-  set<int> newfins = set<int>(ret.getFinals().begin(), ret.getFinals().end());
-  set<int> tmpFins;
-  // get all sorted sccs
+/*
+ * Classify SCCs of the automaton (each SCC is checked to be deterministic,
+ * nondeterministic, and inherently weak independently)
+ * @return Classified SCCs in a topological order
+ */
+std::vector<SccClassif> ElevatorAutomaton::sccClassification(){
   map<int, set<int> > predSyms = this->getPredSymbolMap();
-  std::vector<std::set<int>> sccs = this->topologicalSort(predSyms);
   std::vector<SccClassif> sccClass;
-  for (const auto& scc : sccs){
+  for (const auto& scc : this->topologicalSort()){
     SccClassif tmp = {.states = scc, .det = false, .inhWeak = false, .nonDet = false};
-    sccClass.push_back(tmp);
-  }
-
-  // scc classification
-  for (auto it = sccClass.begin(); it != sccClass.end(); it++){
     // deterministic
-    if (isDeterministic(it->states, predSyms))
-      it->det = true;
+    if (isDeterministic(tmp.states, predSyms))
+      tmp.det = true;
     // nondeterministic
-    if (isNonDeterministic(it->states))
-      it->nonDet = true;
+    if (isNonDeterministic(tmp.states))
+      tmp.nonDet = true;
     // inherently weak
-    if (isInherentlyWeak(it->states, predSyms))
-      it->inhWeak = true;
+    if (isInherentlyWeak(tmp.states, predSyms))
+      tmp.inhWeak = true;
+    sccClass.push_back(tmp);
   }
+  return sccClass;
+}
+
+BuchiAutomaton<int, int> ElevatorAutomaton::copyPreprocessing(const std::function<bool(SccClassif)>& pred)
+{
+  return copyPreprocessing(pred, this->sccClassification());
+}
+
+/*
+ * Copy accepting SCCs satisfying a predicate
+ * @param pred Predicate on SCCs
+ * @param sccClass Classified SCCs (see sccClassification)
+ * @return Preprocessed automaton
+ */
+BuchiAutomaton<int, int> ElevatorAutomaton::copyPreprocessing(const std::function<bool(SccClassif)>& pred,
+  std::vector<SccClassif> sccClass)
+{
+  BuchiAutomaton<int, int> aut(*this);
+  BuchiAutomaton<int, int> ret(*this);
+  set<int> newfins = set<int>(ret.getFinals().begin(), ret.getFinals().end());
+  set<int> tmpFins;
+  map<int, set<int> > predSyms = this->getPredSymbolMap();
 
   int start = this->getStates().size();
   for (auto it = sccClass.begin(); it != sccClass.end(); it++)
@@ -185,120 +211,30 @@ BuchiAutomaton<int, int> ElevatorAutomaton::copyPreprocessing(const std::functio
 
 
 bool ElevatorAutomaton::isElevator(){
-
-  // get all sorted sccs
-  map<int, set<int> > predSyms = this->getPredSymbolMap();
-  std::vector<std::set<int>> sccs = this->topologicalSort(predSyms);
-  std::vector<SccClassif> sccClass;
-  for (const auto& scc : sccs){
-    SccClassif tmp = {.states = scc, .det = false, .inhWeak = false, .nonDet = false};
-    sccClass.push_back(tmp);
-  }
-
-  // scc classification
-  for (auto it = sccClass.begin(); it != sccClass.end(); it++){
-    // deterministic
-    if (isDeterministic(it->states, predSyms))
-    {
-      it->det = true;
-    }
-    // nondeterministic
-    else if (isNonDeterministic(it->states))
-    {
-      it->nonDet = true;
-    }
-    // inherently weak
-    else if (isInherentlyWeak(it->states, predSyms))
-    {
-      it->inhWeak = true;
-    }
-    else
-    {
-      return false;
-    }
-  }
-
-  return true;
+  return isElevator(this->sccClassification());
 }
 
 
-void ElevatorAutomaton::topologicalSortUtil(std::set<int> currentScc, std::vector<std::set<int>> allSccs, std::map<std::set<int>, bool> &visited, std::stack<std::set<int>> &Stack, vector<set<int>>& adjList){
-  // mark the current node as visited
-  visited[currentScc] = true;
-  auto trans = this->getTransitions();
-
-  // recursion call for all nonvisited successors
-  for (auto& scc : allSccs){
-    bool cnt = true;
-    if (not visited[scc]){
-      for (auto state : currentScc){
-        for(auto m : scc)
-        {
-          if(adjList[state].find(m) != adjList[state].end())
-          {
-            this->topologicalSortUtil(scc, allSccs, visited, Stack, adjList);
-            cnt = false;
-            break;
-          }
-        }
-        if(!cnt)
-          break;
-      }
-      //   for (auto a : this->getAlphabet()){
-      //     if(trans[{state, a}].size() == 0)
-      //       continue;
-      //     if (std::any_of(scc.begin(), scc.end(), [this, state, a](int succ){auto trans = this->getTransitions(); return trans[{state, a}].find(succ) != trans[{state, a}].end();}))
-      //       this->topologicalSortUtil(scc, allSccs, visited, Stack);
-      //   }
-      // }
-    }
-  }
-
-  // push scc to stack storing the topological order
-  Stack.push(currentScc);
+/*
+ * Is the automaton elevator (each SCC is deterministic, nondeterministic,
+ * or inherently weak)?
+ * @param sccClass Classified SCCs (see sccClassification)
+ */
+bool ElevatorAutomaton::isElevator(const std::vector<SccClassif>& sccClass){
+  return std::all_of(sccClass.begin(), sccClass.end(), [](const SccClassif& c){return c.det or c.nonDet or c.inhWeak;});
 }
 
-std::vector<std::set<int>> ElevatorAutomaton::topologicalSort(std::map<int, std::set<int>>& predSyms){
-  // get all sccs
-  vector<set<int>> adjList(this->states.size());
-  std::vector<std::set<int>> sccs = this->getAutGraphSCCs();
-  auto tr = this->getTransitions();
 
-  for(const auto & st : this->getStates())
-  {
-    for (const auto& a : predSyms[st])
-    {
-      for(const auto & d : tr[{st, a}])
-        adjList[st].insert(d);
-    }
-  }
-
-
-  std::stack<std::set<int>> Stack;
-  // no scc is visited
-  std::map<std::set<int>, bool> visited;
-  for (auto& scc : sccs){
-    visited.insert({scc, false});
-  }
-
-  // for(int i = 0; i < adjList.size(); i++)
-  //   cout << adjList[i].size() << endl;
-
-
-  // get topological sort starting from all sccs one by one
-  for (auto& scc : sccs){
-    if (visited[scc] == false)
-      this->topologicalSortUtil(scc, sccs, visited, Stack, adjList);
-    //std::cerr << "size: " << scc.size() << std::endl;
-  }
-
-  //cout << "scc complete " << visited.size() << " " << adjList.size() << endl;
-
-  // return topological sort
+/*
+ * Get SCCs of the automaton in a topological order (an SCC precedes all
+ * SCCs reachable from it)
+ * @return Vector of SCCs
+ */
+std::vector<std::set<int>> ElevatorAutomaton::topologicalSort(){
+  Condensation cond = this->getCondensation();
   std::vector<std::set<int>> sorted;
-  while (not Stack.empty()){
-    sorted.push_back(Stack.top());
-    Stack.pop();
+  for (int c : cond.topologicalOrder()){
+    sorted.push_back(std::set<int>(cond.getVertices(c).begin(), cond.getVertices(c).end()));
   }
   return sorted;
 }
@@ -308,7 +244,7 @@ unsigned ElevatorAutomaton::elevatorStates(){
 
   // topological sort
   map<int, set<int> > predSyms = this->getPredSymbolMap();
-  std::vector<std::set<int>> sortedComponents = this->topologicalSort(predSyms);
+  std::vector<std::set<int>> sortedComponents = this->topologicalSort();
 
   // determine scc type (deterministic, nondeterministic, bad, both)
   std::map<std::set<int>, sccType> typeMap;
@@ -380,32 +316,19 @@ unsigned ElevatorAutomaton::elevatorStates(){
  * Updates rankBound of every state based on elevator automaton structure (minimum of these two options)
  */
 std::map<int, int> ElevatorAutomaton::elevatorRank(bool detBeginning){
+  return elevatorRank(detBeginning, this->sccClassification());
+}
 
-  map<int, set<int> > predSyms = this->getPredSymbolMap();
 
-  // get all sorted sccs
-  std::vector<std::set<int>> sccs = this->topologicalSort(predSyms);
-  std::vector<SccClassif> sccClass;
-  for (const auto& scc : sccs){
-    SccClassif tmp = {.states = scc, .det = false, .inhWeak = false, .nonDet = false};
-    sccClass.push_back(tmp);
-  }
+/**
+ * Elevator rank bounds of states
+ * @param detBeginning Deterministic/inherently weak beginning
+ * @param sccClass Classified SCCs (see sccClassification)
+ * @return Map assigning states their rank bounds
+ */
+std::map<int, int> ElevatorAutomaton::elevatorRank(bool detBeginning, std::vector<SccClassif> sccClass){
 
-  // scc classification
-  for (auto it = sccClass.begin(); it != sccClass.end(); it++){
-    // deterministic
-    if (isDeterministic(it->states, predSyms))
-    {
-      it->det = true;
-    }
-    // nondeterministic
-    if (isNonDeterministic(it->states))
-      it->nonDet = true;
-    // inherently weak
-    if (isInherentlyWeak(it->states, predSyms))
-      it->inhWeak = true;
-    //cout << it->states.size() << " " << it->det << " " << it->nonDet << " " << it->inhWeak << endl;
-  }
+  map<int, set<int> > predSyms = this->getPredSymbolMap();
 
   // for(auto cl : sccClass)
   // {
@@ -633,12 +556,21 @@ std::map<int, int> ElevatorAutomaton::elevatorRank(bool detBeginning){
 
 bool ElevatorAutomaton::isInherentlyWeakBA()
 {
-  map<int, set<int>> predSyms = this->getPredSymbolMap();
-  auto sccs = this->getAutGraphSCCs();
+  return isInherentlyWeakBA(this->sccClassification());
+}
+
+
+/*
+ * Is the automaton inherently weak (each accepting SCC is inherently weak)?
+ * @param sccClass Classified SCCs (see sccClassification)
+ */
+bool ElevatorAutomaton::isInherentlyWeakBA(const std::vector<SccClassif>& sccClass)
+{
   auto finals = this->getFinals();
   auto finTrans = this->getFinTrans();
-  for (const auto& scc : sccs) {
-    if ((not isInherentlyWeak(scc, predSyms)) and
+  for (const auto& cl : sccClass) {
+    const auto& scc = cl.states;
+    if ((not cl.inhWeak) and
         (std::any_of(scc.begin(), scc.end(), [finals](int state){return finals.find(state) != finals.end();}) or
         std::any_of(finTrans.begin(), finTrans.end(), [scc](auto tr){
             return scc.find(tr.from) != scc.end() and scc.find(tr.to) != scc.end();
@@ -663,46 +595,18 @@ BuchiAutomaton<int, int> ElevatorAutomaton::convertToWeak()
 }
 
 
-map<int, bool> ElevatorAutomaton::nondetStates()
+map<int, bool> ElevatorAutomaton::nondetStates(const std::vector<SccClassif>& sccClass,
+  const std::map<int, int>& ranks)
 {
-  map<int, set<int> > predSyms = this->getPredSymbolMap();
-  std::vector<std::set<int>> sccs = this->topologicalSort(predSyms);
-  std::vector<SccClassif> sccClass;
-  for (const auto& scc : sccs)
-  {
-    SccClassif tmp = {.states = scc, .det = false, .inhWeak = false, .nonDet = false};
-    sccClass.push_back(tmp);
-  }
-
-  map<int,int> ranks = this->elevatorRank(false);
   int m = Aux::maxValue(ranks);
 
-  // scc classification
-  for (auto it = sccClass.begin(); it != sccClass.end(); it++)
-  {
-    // deterministic
-    if (isDeterministic(it->states, predSyms))
-    {
-      it->det = true;
-    }
-    // nondeterministic
-    if (isNonDeterministic(it->states))
-    {
-      it->nonDet = true;
-    }
-    // inherently weak
-    if (isInherentlyWeak(it->states, predSyms))
-    {
-      it->inhWeak = true;
-    }
-  }
-
   map<int, bool> types;
   for (const auto& scc : sccClass)
   {
     for(int st : scc.states)
     {
-      if(scc.nonDet && ranks[st] == m)
+      auto it = ranks.find(st);
+      if(scc.nonDet && it != ranks.end() && it->second == m)
       {
         types[st] = true;
       }
@@ -717,7 +621,22 @@ map<int, bool> ElevatorAutomaton::nondetStates()
 
 BuchiAutomaton<int, int> ElevatorAutomaton::nondetInitDeterminize()
 {
-  map<int, bool> nondetSt = this->nondetStates();
+  std::vector<SccClassif> sccClass = this->sccClassification();
+  return nondetInitDeterminize(sccClass, this->elevatorRank(false, sccClass));
+}
+
+
+/*
+ * Determinize the initial part of the automaton leading to nondeterministic
+ * SCCs with the maximal elevator rank
+ * @param sccClass Classified SCCs (see sccClassification)
+ * @param ranks Elevator ranks of states (see elevatorRank(false))
+ * @return Automaton with the determinized initial part
+ */
+BuchiAutomaton<int, int> ElevatorAutomaton::nondetInitDeterminize(const std::vector<SccClassif>& sccClass,
+  const std::map<int, int>& ranks)
+{
+  map<int, bool> nondetSt = this->nondetStates(sccClass, ranks);
 
   map<DFAState, int> stInt;
   int cnt = this->getStates().size();
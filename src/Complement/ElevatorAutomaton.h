@@ -27,29 +27,37 @@ class ElevatorAutomaton : public BuchiAutomaton<int, int> {
 public:
   ElevatorAutomaton(BuchiAutomaton<int, int> t) : BuchiAutomaton<int, int>(t) { }
 
+  std::vector<SccClassif> sccClassification();
+
   bool isElevator();
-  std::vector<std::set<int>> topologicalSort(map<int, set<int>>& predSyms);
+  bool isElevator(const std::vector<SccClassif>& sccClass);
+  std::vector<std::set<int>> topologicalSort();
 
   unsigned elevatorStates();
   std::map<int, int> elevatorRank(bool detBeginning);
+  std::map<int, int> elevatorRank(bool detBeginning, std::vector<SccClassif> sccClass);
 
   BuchiAutomaton<int, int> copyPreprocessing(const std::function<bool(SccClassif)>& pred);
+  BuchiAutomaton<int, int> copyPreprocessing(const std::function<bool(SccClassif)>& pred,
+    std::vector<SccClassif> sccClass);
   BuchiAutomaton<int, int> propagateAccStates();
+  BuchiAutomaton<int, int> propagateAccStates(const std::vector<SccClassif>& sccClass);
 
   bool isInherentlyWeakBA();
+  bool isInherentlyWeakBA(const std::vector<SccClassif>& sccClass);
   BuchiAutomaton<int, int> convertToWeak();
 
   BuchiAutomaton<int, int> nondetInitDeterminize();
+  BuchiAutomaton<int, int> nondetInitDeterminize(const std::vector<SccClassif>& sccClass,
+    const std::map<int, int>& ranks);
 
 protected:
   bool isDeterministic(std::set<int>& scc, map<int, set<int> >& predSyms);
   bool isNonDeterministic(std::set<int>& scc);
   bool isInherentlyWeak(const std::set<int>& scc, map<int, set<int> >& predSyms);
 
-  void topologicalSortUtil(std::set<int> currentScc, std::vector<std::set<int>> allSccs, std::map<std::set<int>, bool> &visited, std::stack<std::set<int>> &Stack, vector<set<int>>& adjList);
-
 private:
-  map<int, bool> nondetStates();
+  map<int, bool> nondetStates(const std::vector<SccClassif>& sccClass, const std::map<int, int>& ranks);
 
 };
 
@@ -1,63 +1,44 @@
 #include "GenCoBuchiAutomatonCompl.h"
 
-BuchiAutomaton<StateGcoBA, int> GeneralizedCoBuchiAutomatonCompl::complementGcoBA(){
-    auto alph = this->getAlphabet();
-    map<std::pair<StateGcoBA, int>, set<StateGcoBA>> mp;
-    std::set<StateGcoBA> states;
-    std::set<StateGcoBA> finals;
-
-    // initial states
-    std::set<StateGcoBA> initials;
-    StateGcoBA init = {.S = this->getInitials(), .B = set<int>(), .i = 0};
-    init.B.clear();
-    std::set_difference(this->getInitials().begin(), this->getInitials().end(), this->getFinals()[0].begin(), this->getFinals()[0].end(), std::inserter(init.B, init.B.begin()));
-    initials.insert(init);
-    states.insert(init);
-    if (init.B.size() == 0 or init.S.size() == 0)
-        finals.insert(init);
-
-    // push initial state on stack
-    std::stack<StateGcoBA> stack;
-    stack.push(init);
-    while (not stack.empty()){
-        // pop state from stack
-        StateGcoBA state = stack.top();
-        stack.pop();
-
-        // generate transitions and new states
-        for (int sym : alph){
-            auto pr = std::make_pair(state, sym);
-            std::set<StateGcoBA> dst;
-
-            auto S_prime = succSet(state.S, sym);
-            int i_prime;
-            std::set<int> B_prime;
-            if (state.B.empty()){
-                i_prime = (state.i + 1) % this->getFinals().size();
-                std::set_difference(S_prime.begin(), S_prime.end(), this->getFinals()[i_prime].begin(), this->getFinals()[i_prime].end(), std::inserter(B_prime, B_prime.begin()));
-            } else {
-                i_prime = state.i;
-                auto tmp = succSet(state.B, sym);
-                std::set_difference(tmp.begin(), tmp.end(), this->getFinals()[state.i].begin(), this->getFinals()[state.i].end(), std::inserter(B_prime, B_prime.begin()));
-            }
-
-            StateGcoBA newState = {.S = S_prime, .B = B_prime, .i = i_prime};
+/*
+ * Complementation of generalized co-Buchi automata
+ * @param threads Number of threads expanding the macrostates
+ * @return Complemented automaton
+ */
+BuchiAutomaton<StateGcoBA, int> GeneralizedCoBuchiAutomatonCompl::complementGcoBA(unsigned threads){
+    this->transTable = this->getTransitionTable();
 
-            // push new state on stack
-            dst.insert(newState);
-            if (states.find(newState) == states.end()){
-                states.insert(newState);
-                stack.push(newState);
-                if ((newState.B.size() == 0 and newState.i == 0) or newState.S.size() == 0)
-                    finals.insert(newState);
-            }
+    vector<DenseSet> finalStates;
+    for (unsigned i = 0; i < this->getFinals().size(); i++)
+        finalStates.push_back(DenseSet(this->getFinals()[i]));
 
-            // transitions
-            mp.insert({pr, dst});
+    // initial states
+    StateGcoBA init = {.S = this->getInitials(), .B = DenseSet(), .i = 0};
+    init.B = init.S - finalStates[0];
+
+    auto succ = [this, &finalStates](const StateGcoBA& state, int sym) -> vector<StateGcoBA>
+    {
+        DenseSet S_prime = succSet(state.S, sym);
+        int i_prime;
+        DenseSet B_prime;
+        if (state.B.empty()){
+            i_prime = (state.i + 1) % finalStates.size();
+            B_prime = S_prime - finalStates[i_prime];
+        } else {
+            i_prime = state.i;
+            B_prime = succSet(state.B, sym) - finalStates[state.i];
         }
-    }
-
-    auto ba = BuchiAutomaton<StateGcoBA, int>(states, finals, initials, mp, alph, getAPPattern());
+        return {{.S = S_prime, .B = B_prime, .i = i_prime}};
+    };
+    auto acc = [](const StateGcoBA& st) -> bool
+    {
+        return (st.B.size() == 0 and st.i == 0) or st.S.size() == 0;
+    };
+    auto hash = [](const StateGcoBA& st) -> std::size_t { return st.hash(); };
+
+    SubsetConstruction<StateGcoBA, int> constr(this->getAlphabet(), succ, acc, hash, threads);
+    auto ba = constr.construct({init});
+    ba.setAPPattern(getAPPattern());
     //std::cerr << ba.toString() << std::endl << std::endl;
     return ba;
 }
@@ -68,13 +49,7 @@ BuchiAutomaton<StateGcoBA, int> GeneralizedCoBuchiAutomatonCompl::complementGcoB
  * @param symbol Symbol
  * @return Set of successors over symbol
  */
-set<int> GeneralizedCoBuchiAutomatonCompl::succSet(set<int>& states, int symbol)
+DenseSet GeneralizedCoBuchiAutomatonCompl::succSet(const DenseSet& states, int symbol)
 {
-  set<int> ret;
-  for(int st : states)
-  {
-    set<int> dst = getTransitions()[std::make_pair(st, symbol)];
-    ret.insert(dst.begin(), dst.end());
-  }
-  return ret;
+  return this->transTable.succSet(states, symbol);
 }
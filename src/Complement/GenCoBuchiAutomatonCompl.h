@@ -15,6 +15,7 @@
 #include "../Algorithms/AuxFunctions.h"
 #include "../Automata/BuchiAutomaton.h"
 #include "../Automata/GenCoBuchiAutomaton.h"    
+#include "../Automata/SubsetConstruction.h"
 #include "StateGcoBA.h"
 #include "Options.h"
 
@@ -27,14 +28,16 @@ using std::map;
  */
 class GeneralizedCoBuchiAutomatonCompl : public GeneralizedCoBuchiAutomaton<int, int>
 {
+private:
+  TransitionTable transTable;
 
 public:
-  GeneralizedCoBuchiAutomatonCompl(GeneralizedCoBuchiAutomaton<int, int> *t) : GeneralizedCoBuchiAutomaton<int, int>(*t)
+  GeneralizedCoBuchiAutomatonCompl(GeneralizedCoBuchiAutomaton<int, int> *t) : GeneralizedCoBuchiAutomaton<int, int>(*t), transTable()
   {
   }
 
-  BuchiAutomaton<StateGcoBA, int> complementGcoBA();
-  set<int> succSet(set<int>& states, int symbol);
+  BuchiAutomaton<StateGcoBA, int> complementGcoBA(unsigned threads = 1);
+  DenseSet succSet(const DenseSet& states, int symbol);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef _LAZY_COMPLEMENT_H_
+#define _LAZY_COMPLEMENT_H_
+
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+/*
+ * Complement automaton constructed on demand. Macrostates are created only
+ * when they are reached from the initial states via successors(), they are
+ * stored (and numbered) in the order of discovery and their successors are
+ * memoized. Two macrostates are the same iff they are equivalent wrt
+ * State::operator< (i.e., the same states as in the eager construction).
+ * The object refers to the automaton it was created from, hence the
+ * automaton has to outlive it.
+ */
+template <typename State>
+class LazyComplement
+{
+public:
+  typedef uint32_t StateId;
+  typedef std::function<std::vector<State>(const State&, int)> SuccFunc;
+  typedef std::function<bool(const State&)> AccFunc;
+
+private:
+  std::map<State, StateId> ids;
+  std::vector<State> states;
+  std::vector<bool> accepting;
+  // memoized successors (for each state and symbol)
+  std::vector<std::map<int, std::vector<StateId>>> succs;
+  std::vector<StateId> initials;
+  std::set<int> alph;
+
+  SuccFunc succFunc;
+  AccFunc accFunc;
+
+  StateId intern(const State& st)
+  {
+    auto ins = this->ids.insert({st, (StateId)this->states.size()});
+    if(ins.second)
+    {
+      this->states.push_back(st);
+      this->accepting.push_back(this->accFunc(st));
+      this->succs.emplace_back();
+    }
+    return ins.first->second;
+  }
+
+public:
+  LazyComplement(const std::vector<State>& init, const std::set<int>& alph,
+    SuccFunc succFunc, AccFunc accFunc) : ids(), states(), accepting(), succs(),
+    initials(), alph(alph), succFunc(succFunc), accFunc(accFunc)
+  {
+    for(const State& st : init)
+      this->initials.push_back(intern(st));
+  }
+
+  /*
+   * Get the initial state (the complement has a single initial state)
+   * @return Id of the initial state
+   */
+  StateId initial() const
+  {
+    return this->initials.front();
+  }
+
+  const std::vector<StateId>& getInitials() const
+  {
+    return this->initials;
+  }
+
+  /*
+   * Is the state accepting
+   * @param id Id of a discovered state
+   * @return Accepting
+   */
+  bool isAccepting(StateId id) const
+  {
+    return this->accepting[id];
+  }
+
+  /*
+   * Get successors of a state (computed on the first call)
+   * @param id Id of a discovered state
+   * @param symbol Symbol
+   * @return Ids of successors
+   */
+  const std::vector<StateId>& successors(StateId id, int symbol)
+  {
+    auto it = this->succs[id].find(symbol);
+    if(it != this->succs[id].end())
+      return it->second;
+
+    std::vector<StateId> dst;
+    // the state is copied (the store may be reallocated by intern)
+    State st = this->states[id];
+    for(const State& s : this->succFunc(st, symbol))
+      dst.push_back(intern(s));
+    std::sort(dst.begin(), dst.end());
+    dst.erase(std::unique(dst.begin(), dst.end()), dst.end());
+    return this->succs[id][symbol] = dst;
+  }
+
+  const State& getState(StateId id) const { return this->states[id]; }
+  const std::set<int>& getAlphabet() const { return this->alph; }
+
+  /*
+   * Number of states discovered so far
+   */
+  size_t size() const { return this->states.size(); }
+};
+
+#endif
@@ -28,8 +28,8 @@ struct ComplOptions
   unsigned ROMinState = 9;
   int ROMinRank = 7;
 
-  unsigned CacheMaxState = 6;
-  int CacheMaxRank = 8;
+  // memory budget of the rank successor cache (in bytes)
+  size_t CacheMemory = 64 << 20;
 
   bool semidetOpt = false;
   DataFlowOptions dataFlow = INNER;
@@ -46,6 +46,12 @@ struct ComplOptions
 
   bool dirsim = true;
   bool ranksim = true;
+  // maximum size of macrostates whose rank bound is refined by the odd rank
+  // simulation (the refinement checks all subsets of the macrostate)
+  unsigned rankSimMaxMacro = 12;
+  // automata with less states have the rank bound refined in all macrostates
+  // (unless the maximum size is given explicitly)
+  unsigned rankSimMaxStates = 20;
   bool sl = true;
   bool reach = true;
 
@@ -76,11 +82,18 @@ struct ComplOptions
 
   bool prered = true;
   bool postred = false;
+  // maximum number of states of the bisimulation quotient of the result
+  // that is further reduced by the direct simulation (the simulation needs
+  // quadratic memory in the number of states)
+  unsigned postredSimMaxStates = 2000;
 
   bool iwOrigOnly = false;
   bool iwPruneOnly = false;
   bool sdLazyOnly = false;
   bool sdMaxrankOnly = false;
+
+  unsigned threads = 1;
+  bool portfolio = false;
 };
 
 #endif
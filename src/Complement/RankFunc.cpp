@@ -1,323 +1,99 @@
 
 #include "RankFunc.h"
+#include "RankFuncEnumerator.h"
 
 
+/*
+ * Value of a key in a map (0 if the key is not present, i.e., the value
+ * operator[] would insert)
+ * @param mp Map
+ * @param key Key
+ * @return Value of the key
+ */
+static int mapValue(const map<int, int>& mp, int key)
+{
+  auto it = mp.find(key);
+  return it != mp.end() ? it->second : 0;
+}
+
 /*
  * Constructor for the Ranking function
  * @param mp Mapping representing the ranking function
- * @param useInverse Use inverse mapping
  */
-RankFunc::RankFunc(const map<int,int>& mp, bool useInverse) : map<int,int>(mp),
-  oddStates(), inverse(), ranks(), tight()
+RankFunc::RankFunc(const map<int,int>& mp) : func(mp.begin(), mp.end()),
+  oddStates(), oddRanks(), maxRank(0), reachRest(INF)
 {
-  this->maxRank = 0;
-  this->reachRest = INF;
-  RankInverse::iterator it;
   for(const auto& k : mp)
   {
-    this->maxRank = std::max(this->maxRank, k.second);
-    this->ranks.push_back(k.second);
-    int tmp = this->maxRank;
-    if(tmp % 2 == 0) tmp++;
-    if((int)this->tight.size() < (tmp-1)/2 + 1)
-      this->tight.resize((tmp-1)/2 + 1, 0);
-    if(k.second % 2 != 0)
-    {
-      this->oddStates.insert(k.first);
-      //this->tight.set((k.second - 1) / 2);
-      this->tight[(k.second - 1) / 2] = 1;
-    }
-
-    if(useInverse)
-    {
-      it = this->inverse.find(k.second);
-      if(it != this->inverse.end())
-        it->second.insert(k.first);
-      else
-        this->inverse[k.second] = set<int>({k.first});
-    }
+    updateRanks(k);
   }
 }
 
 
 /*
- * Add pair to the ranking function
- * @param val Pair to be added
- * @param useInverse Use inverse mapping
+ * Update the maximum rank and odd states/ranks wrt a new pair
+ * @param val Pair (state, rank)
  */
-void RankFunc::addPair(const std::pair<int, int>& val, bool useInverse)
+void RankFunc::updateRanks(const value_type& val)
 {
   this->maxRank = std::max(this->maxRank, val.second);
-  int tmp = this->maxRank;
-  if(tmp % 2 == 0) tmp++;
-  if((int)this->tight.size() < (tmp-1)/2 + 1)
-    this->tight.resize((tmp-1)/2 + 1, 0);
   if(val.second % 2 != 0)
   {
     this->oddStates.insert(val.first);
-    //this->tight.set((val.second - 1) / 2);
-    this->tight[(val.second - 1) / 2] = 1;
-  }
-
-  this->insert(val);
-  this->ranks.push_back(val.second);
-
-  if(useInverse)
-  {
-    RankInverse::iterator it = this->inverse.find(val.second);
-    if(it != this->inverse.end())
-      it->second.insert(val.first);
-    else
-      this->inverse[val.second] = set<int>({val.first});
-  }
-}
-
-
-/*
- * Cartesian product of a set of ranking functions and pairs to be added
- * @param s1 Set of ranking funtions
- * @param s2 Vector of pairs to be added to s1
- * @param rem Number of remaining tight positions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param reachRes Reachability restriction (SuccRank)
- * @param maxReach Maximum reachable macrostate
- * @return Set of combinations of ranking functions with joined pairs
- */
-vector<RankFunc> RankFunc::cartTightProductMap(vector<RankFunc>& s1, vector<std::pair<int, int> >& s2,
-    int rem, BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  (void)rel;
-  vector<RankFunc> ret;
-  int maxRank;
-  for(const auto& v1 : s1)
-  {
-    for(const auto& v2 : s2)
-    {
-      RankFunc tmp(v1);
-      tmp.addPair(v2, useInverse);
-      if(rem < tmp.remTightCount())
-        continue;
-      if(max != -1 && rem == 0 && tmp.getMaxRank() != max)
-        continue;
-
-      maxRank = std::min(tmp.getReachRestr(), v2.second + 2*(reachMax - reachRes[v2.first]));
-      if(maxRank < tmp.getMaxRank())
-        continue;
-      tmp.setReachRestr(maxRank);
-
-      // if(!RankFunc::checkDirectBackRel(v2, tmp, rel))
-      //   continue;
-      if(!RankFunc::checkOddBackRel(v2, tmp, oddRel))
-        continue;
-      ret.push_back(tmp);
-    }
-  }
-  return ret;
-}
-
-
-/*
- * Cartesian product of a set of ranking functions and pairs to be added (odd variant)
- * @param s1 Set of ranking funtions
- * @param s2 Vector of pairs to be added to s1
- * @param rem Number of remaining tight positions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Maximum rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param maxReach Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of combinations of ranking functions with joined pairs
- */
-vector<RankFunc> RankFunc::cartTightProductMapOdd(vector<RankFunc>& s1, vector<std::pair<int, int> >& s2,
-    int rem, BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  vector<RankFunc> ret;
-  int maxRank;
-  bool ins;
-  for(const auto& v1 : s1)
-  {
-    ins = false;
-    for(const auto& v2 : s2)
-    {
-      if(v2.second % 2 == 0)
-      {
-        if(!ins)
-          ret.push_back(v1);
-        ins = true;
-        continue;
-      }
-      RankFunc tmp(v1);
-      tmp.addPair(v2, useInverse);
-      if(rem < tmp.remTightCount())
-        continue;
-      if(max != -1 && rem == 0 && tmp.getMaxRank() != max)
-        continue;
-
-      maxRank = std::min(tmp.getReachRestr(), v2.second + 2*(reachMax - reachRes[v2.first]));
-      if(maxRank < tmp.getMaxRank())
-        continue;
-      tmp.setReachRestr(maxRank);
-
-      if(!RankFunc::checkDirectBackRel(v2, tmp, rel))
-        continue;
-      if(!RankFunc::checkOddBackRel(v2, tmp, oddRel))
-        continue;
-      ret.push_back(tmp);
-    }
+    this->oddRanks.insert((val.second - 1) / 2);
   }
-  return ret;
 }
 
 
 /*
- * Check if combination or tmp with joined act fulfills direct simulation restr
- * @param act Pair
- * @param tmp Ranking function
- * @param rel Direct simulation
- * @return DirSim Compatibility
+ * Add pair to the ranking function
+ * @param val Pair to be added
  */
-bool RankFunc::checkDirectBackRel(const std::pair<int, int>& act, const RankFunc& tmp, BackRel& rel)
+void RankFunc::addPair(const std::pair<int, int>& val)
 {
-  for(auto st : rel[act.first])
-  {
-    auto it = tmp.find(st.first);
-    if(it != tmp.end())
-    {
-      if(st.second && it->second < act.second)
-      {
-        return false;
-      }
-      if(!st.second && it->second > act.second)
-      {
-        return false;
-      }
-    }
-  }
-  return true;
-}
+  updateRanks(val);
 
-
-/*
- * Check if combination or tmp with joined act fulfills rank simulation restr
- * @param act Pair
- * @param tmp Ranking function
- * @param oddRel Direct simulation
- * @return RankSim Compatibility
- */
-bool RankFunc::checkOddBackRel(const std::pair<int, int>& act, const RankFunc& tmp, BackRel& oddRel)
-{
-  if(act.second % 2 != 0)
+  // pairs are usually added in the ascending order of states
+  if(this->func.empty() || this->func.back().first < val.first)
   {
-    for(auto st : oddRel[act.first])
-    {
-      auto it = tmp.find(st.first);
-      if(it != tmp.end())
-      {
-        if(it->second % 2 == 0)
-          continue;
-        if(st.second && it->second < act.second)
-        {
-          return false;
-        }
-        if(!st.second && it->second > act.second)
-        {
-          return false;
-        }
-      }
-    }
+    this->func.push_back(val);
+    return;
   }
-  return true;
+  auto it = std::lower_bound(this->func.begin(), this->func.end(), val.first,
+    [](const value_type& p, int st) { return p.first < st; });
+  if(it == this->func.end() || it->first != val.first)
+    this->func.insert(it, val);
 }
 
 
 /*
- * Generate all ranking functions based on restriction slist
- * @param slist Restriction of ranking functions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Maximum rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of all ranking functions
+ * Get states having a given rank
+ * @param i Rank
+ * @return Set of states with the rank i
  */
-vector<RankFunc> RankFunc::cartTightProductMapList(RankConstr slist, BackRel& rel, BackRel& oddRel,
-    int max, map<int, int>& reachRes, int reachMax, bool useInverse)
+set<int> RankFunc::inverseRank(int i) const
 {
-  vector<RankFunc> ret;
-  if(slist.size() == 0)
-    return ret;
-
-  for(auto p : slist[0])
+  set<int> ret;
+  for(const auto& p : this->func)
   {
-    RankFunc sing(map<int, int>({p}), useInverse);
-    sing.setReachRestr(p.second + 2*(reachMax - reachRes[p.first]));
-    ret.push_back(sing);
-  }
-  for(int i = 1; i < (int)slist.size(); i++)
-  {
-    ret = RankFunc::cartTightProductMap(ret, slist[i], slist.size() - i - 1, rel, oddRel,
-      max, reachRes, reachMax, useInverse);
+    if(p.second == i)
+      ret.insert(ret.end(), p.first);
   }
   return ret;
 }
 
 
 /*
- * Generate all ranking functions based on restriction slist (odd version)
- * @param slist Restriction of ranking functions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Maximum rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of all ranking functions
+ * Get ranks of the states (in the ascending order of states)
+ * @return Vector of ranks
  */
-vector<RankFunc> RankFunc::cartTightProductMapListOdd(RankConstr slist, BackRel& rel, BackRel& oddRel,
-    int max, map<int, int>& reachRes, int reachMax, bool useInverse)
+vector<int> RankFunc::getRanks() const
 {
-  vector<RankFunc> ret;
-  vector<RankFunc> retcp;
-  if(slist.size() == 0)
-    return ret;
-  set<int> states;
-
-  for(auto p : slist[0])
-  {
-    RankFunc sing(map<int, int>({p}), useInverse);
-    sing.setReachRestr(p.second + 2*(reachMax - reachRes[p.first]));
-    ret.push_back(sing);
-    states.insert(p.first);
-  }
-  for(int i = 1; i < (int)slist.size(); i++)
-  {
-    if(slist[i].size() == 0)
-      return ret;
-    ret = RankFunc::cartTightProductMapOdd(ret, slist[i], slist.size() - i - 1, rel, oddRel, max,
-      reachRes, reachMax, useInverse);
-    states.insert(slist[i][0].first);
-    //std::cout << i << " : " << ret.size() << std::endl;
-  }
-
-  for(unsigned i = 0; i < ret.size(); i++)
-  {
-    if(ret[i].getMaxRank() % 2 == 0 || ret[i].remTightCount() != 0)
-      continue;
-    auto odd(ret[i].getOddStates());
-    for(int s : states)
-    {
-      if(odd.find(s) == odd.end())
-      {
-        ret[i].addPair({s, ret[i].getMaxRank() - 1}, useInverse);
-      }
-    }
-    retcp.push_back(ret[i]);
-  }
-
-  return retcp;
+  vector<int> ret;
+  ret.reserve(this->func.size());
+  for(const auto& p : this->func)
+    ret.push_back(p.second);
+  return ret;
 }
 
 
@@ -330,24 +106,27 @@ vector<RankFunc> RankFunc::fromRankConstr(RankConstr constr)
 {
   vector<vector<std::pair<int,bool> > > emp;
   map<int, int> empMap;
-  return RankFunc::cartTightProductMapList(constr, emp, emp, -1, empMap, INF, false);
+  RankFuncEnumerator en(constr, emp, emp, -1, empMap, INF);
+  return en.getFunctions();
 }
 
 
 /*
- * Generate all tight ranking functions based on restriction (no max rank, tight start)
+ * Generate all tight ranking functions based on restriction
  * @param constr Restriction of ranking functions
  * @param rel Direct simulation
  * @param oddRel Rank simulation
+ * @param max Maximum rank of the functions (-1 if it is not given, e.g.,
+ *        for the tight start)
  * @param reachRes Reachability restriction (SuccRank)
  * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
  * @return Set of all tight ranking functions
  */
-vector<RankFunc> RankFunc::tightFromRankConstr(RankConstr constr, BackRel& rel, BackRel& oddRel,
-    map<int, int>& reachRes, int reachMax, bool useInverse)
+vector<RankFunc> RankFunc::tightFromRankConstr(RankConstr constr, const BackRel& rel, const BackRel& oddRel,
+    int max, const map<int, int>& reachRes, int reachMax)
 {
-  return RankFunc::cartTightProductMapList(constr, rel, oddRel, -1, reachRes, reachMax, useInverse);
+  RankFuncEnumerator en(constr, rel, oddRel, max, reachRes, reachMax);
+  return en.getFunctions();
 }
 
 
@@ -358,32 +137,15 @@ vector<RankFunc> RankFunc::tightFromRankConstr(RankConstr constr, BackRel& rel,
  * @param oddRel Rank simulation
  * @param reachRes Reachability restriction (SuccRank)
  * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of all tight ranking functions
- */
-vector<RankFunc> RankFunc::tightFromRankConstrOdd(RankConstr constr, BackRel& rel, BackRel& oddRel,
-    map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  return RankFunc::cartTightProductMapListOdd(constr, rel, oddRel, -1, reachRes, reachMax, useInverse);
-}
-
-
-/*
- * Generate all tight ranking functions based on restriction (tailored for
- * successors with given maximum rank)
- * @param constr Restriction of ranking functions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Maximum rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
  * @return Set of all tight ranking functions
  */
-vector<RankFunc> RankFunc::tightSuccFromRankConstr(RankConstr constr, BackRel& rel, BackRel& oddRel,
-    int max, map<int, int>& reachRes, int reachMax, bool useInverse)
+vector<RankFunc> RankFunc::tightFromRankConstrOdd(RankConstr constr, const BackRel& rel, const BackRel& oddRel,
+    const map<int, int>& reachRes, int reachMax)
 {
-  return RankFunc::cartTightProductMapList(constr, rel, oddRel, max, reachRes, reachMax, useInverse);
+  RankFuncEnumerator en(constr, rel, oddRel, -1, reachRes, reachMax);
+  en.setOddOnly(true);
+  en.setDirectCheck(true);
+  return en.getFunctions();
 }
 
 
@@ -393,7 +155,7 @@ vector<RankFunc> RankFunc::tightSuccFromRankConstr(RankConstr constr, BackRel& r
  * @param succ RankRestr restriction
  * @return True valid, otherwise false
  */
-bool RankFunc::isSuccValid(RankFunc& prev, map<int, set<int> >& succ) const
+bool RankFunc::isSuccValid(const RankFunc& prev, const map<int, set<int> >& succ) const
 {
   bool val = true;
   int fnc = 0;
@@ -438,11 +200,11 @@ bool RankFunc::isSuccValid(RankFunc& prev, map<int, set<int> >& succ) const
  * @param maxRank Vector of maximum ranks
  * @return Max rank consistency
  */
-bool RankFunc::isMaxRankValid(vector<int>& maxRank) const
+bool RankFunc::isMaxRankValid(const vector<int>& maxRank) const
 {
   for(unsigned i = 0; i < maxRank.size(); i++)
   {
-    if(maxRank[i] < this->ranks[i])
+    if(maxRank[i] < this->func[i].second)
     {
       return false;
     }
@@ -473,12 +235,7 @@ std::string RankFunc::toString() const
  */
 bool RankFunc::isTightRank() const
 {
-  // for(const auto& t : this->tight)
-  // {
-  //   if(!t)  return false;
-  // }
-  // return true;
-  return this->tight.all();
+  return this->remTightCount() == 0;
 }
 
 
@@ -502,12 +259,11 @@ bool RankFunc::eqEven() const
  */
 bool RankFunc::isAllLeq(const RankFunc& f) const
 {
-  vector<int> rnk = f.getRanks();
-  if(this->ranks.size() != rnk.size())
+  if(this->func.size() != f.func.size())
     return false;
-  for(unsigned i = 0; i < this->ranks.size(); i++)
+  for(unsigned i = 0; i < this->func.size(); i++)
   {
-    if(this->ranks[i] > rnk[i])
+    if(this->func[i].second > f.func[i].second)
       return false;
   }
   return true;
@@ -584,17 +340,18 @@ std::string RankFunc::toStringVer() const
  * @param ranks Maximum rank
  * @param states Macrostate
  * @param fin Final states
- * @param useInverse Use inverse ranking function
+ * @param rankBound Rank bounds of states
  * @return Ranking functions (RO)
  */
-vector<RankFunc> RankFunc::getRORanksSD(int ranks, std::set<int>& states, std::set<int>& fin, bool useInverse, map<int, int>& rankBound)
+vector<RankFunc> RankFunc::getRORanksSD(int ranks, const std::set<int>& states, const DenseSet& fin, const map<int, int>& rankBound)
 {
   vector<RankFunc> ret;
-  set<int> nofin;
-  std::set_difference(states.begin(), states.end(), fin.begin(),
-    fin.end(), std::inserter(nofin, nofin.begin()));
-
-  vector<int> nfvec(nofin.begin(), nofin.end());
+  vector<int> nfvec;
+  for(int st : states)
+  {
+    if(!fin.contains(st))
+      nfvec.push_back(st);
+  }
   vector<vector<int>> subsets = Aux::getAllSubsets(nfvec, (ranks+1)/2);
   for(auto& sb : subsets)
   {
@@ -606,17 +363,17 @@ vector<RankFunc> RankFunc::getRORanksSD(int ranks, std::set<int>& states, std::s
       std::map<int, int> rnk;
       for(const int st : states)
       {
-        if(fin.find(st) == fin.end())
-          rnk[st] = std::min(rankBound[st],  (int)(2*sb.size() - 1));
+        if(!fin.contains(st))
+          rnk[st] = std::min(mapValue(rankBound, st),  (int)(2*sb.size() - 1));
         else
-          rnk[st] = std::min(rankBound[st],  (int)(2*(sb.size() - 1)));
+          rnk[st] = std::min(mapValue(rankBound, st),  (int)(2*(sb.size() - 1)));
       }
       for(const int p : perm)
       {
         rnk[p] = i;
         i += 2;
       }
-      RankFunc fnc(rnk, useInverse);
+      RankFunc fnc(rnk);
       ret.push_back(fnc);
 
     } while(std::next_permutation(perm.begin(), perm.end()));
@@ -630,17 +387,18 @@ vector<RankFunc> RankFunc::getRORanksSD(int ranks, std::set<int>& states, std::s
  * @param ranks Maximum rank
  * @param states Macrostate
  * @param fin Final states
- * @param useInverse Use inverse ranking function
+ * @param rankBound Rank bounds of states
  * @return Ranking functions (RO)
  */
-vector<RankFunc> RankFunc::getRORanks(int ranks, std::set<int>& states, std::set<int>& fin, bool useInverse, map<int, int>& rankBound)
+vector<RankFunc> RankFunc::getRORanks(int ranks, const std::set<int>& states, const DenseSet& fin, const map<int, int>& rankBound)
 {
   vector<RankFunc> ret;
-  set<int> nofin;
-  std::set_difference(states.begin(), states.end(), fin.begin(),
-    fin.end(), std::inserter(nofin, nofin.begin()));
-
-  vector<int> nfvec(nofin.begin(), nofin.end());
+  vector<int> nfvec;
+  for(int st : states)
+  {
+    if(!fin.contains(st))
+      nfvec.push_back(st);
+  }
   vector<vector<int>> subsets = Aux::getAllSubsets(nfvec, (ranks+1)/2);
   for(auto& sb : subsets)
   {
@@ -653,132 +411,19 @@ vector<RankFunc> RankFunc::getRORanks(int ranks, std::set<int>& states, std::set
       int i = 1;
       for(int st : states)
       {
-        if(fin.find(st) == fin.end())
-          rnk[st] = std::min(rankBound[st],  (int)(2*sb.size() - 1));
+        if(!fin.contains(st))
+          rnk[st] = std::min(mapValue(rankBound, st),  (int)(2*sb.size() - 1));
         else
-          rnk[st] = std::min(rankBound[st],  (int)(2*(sb.size() - 1)));
+          rnk[st] = std::min(mapValue(rankBound, st),  (int)(2*(sb.size() - 1)));
       }
       for(int item : perm)
       {
         rnk[item] = i;
         i += 2;
       }
-      RankFunc fnc(rnk, useInverse);
+      RankFunc fnc(rnk);
       ret.push_back(fnc);
     } while(std::next_permutation(perm.begin(), perm.end()));
   }
   return ret;
 }
-
-
-/*
- * Cartesian product of a set of ranking functions and pairs to be added
- * @param s1 Set of ranking funtions
- * @param s2 Vector of pairs to be added to s1
- * @param rem Number of remaining tight positions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Max rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse ranking function
- * @return Set of combinations of ranking functions with joined pairs
- */
-vector<RankFunc> RankFunc::cartTightProductMapPure(vector<RankFunc>& s1, vector<std::pair<int, int> >& s2,
-    int rem, BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  vector<RankFunc> ret;
-  int maxRank;
-  for(const auto& v1 : s1)
-  {
-    for(const auto& v2 : s2)
-    {
-      RankFunc tmp(v1);
-      tmp.addPair(v2, useInverse);
-      if(rem < tmp.remTightCount())
-        continue;
-      if(max != -1 && rem == 0 && tmp.getMaxRank() != max)
-        continue;
-
-      maxRank = std::min(tmp.getReachRestr(), v2.second + 2*(reachMax - reachRes[v2.first]));
-      if(maxRank < tmp.getMaxRank())
-        continue;
-      tmp.setReachRestr(maxRank);
-
-      if(!RankFunc::checkDirectBackRel(v2, tmp, rel))
-        continue;
-      if(!RankFunc::checkOddBackRel(v2, tmp, oddRel))
-        continue;
-      ret.push_back(tmp);
-    }
-  }
-  return ret;
-}
-
-
-/*
- * Generate all ranking functions based on restriction slist (pure version)
- * @param slist Restriction of ranking functions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Maximum rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of all ranking functions
- */
-vector<RankFunc> RankFunc::cartTightProductMapListPure(RankConstr slist, BackRel& rel, BackRel& oddRel,
-    int max, map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  vector<RankFunc> ret;
-  if(slist.size() == 0)
-    return ret;
-
-  for(auto p : slist[0])
-  {
-    RankFunc sing(map<int, int>({p}), useInverse);
-    sing.setReachRestr(p.second + 2*(reachMax - reachRes[p.first]));
-    ret.push_back(sing);
-  }
-  for(int i = 1; i < (int)slist.size(); i++)
-  {
-    ret = RankFunc::cartTightProductMap(ret, slist[i], slist.size() - i - 1, rel, oddRel,
-      max, reachRes, reachMax, useInverse);
-  }
-  return ret;
-}
-
-
-/*
- * Generate all tight ranking functions based on restriction (no max rank, tight start) (pure version)
- * @param constr Restriction of ranking functions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of all tight ranking functions
- */
-vector<RankFunc> RankFunc::tightFromRankConstrPure(RankConstr constr, BackRel& rel, BackRel& oddRel,
-    map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  return RankFunc::cartTightProductMapListPure(constr, rel, oddRel, -1, reachRes, reachMax, useInverse);
-}
-
-
-/*
- * Generate all tight ranking functions based on restriction (no max rank, tight start) (pure version)
- * @param constr Restriction of ranking functions
- * @param rel Direct simulation
- * @param oddRel Rank simulation
- * @param max Maximum rank
- * @param reachRes Reachability restriction (SuccRank)
- * @param reachMax Maximum reachable macrostate
- * @param useInverse Use inverse function
- * @return Set of all tight ranking functions
- */
-vector<RankFunc> RankFunc::tightSuccFromRankConstrPure(RankConstr constr, BackRel& rel, BackRel& oddRel,
-    int max, map<int, int>& reachRes, int reachMax, bool useInverse)
-{
-  return RankFunc::cartTightProductMapListPure(constr, rel, oddRel, max, reachRes, reachMax, useInverse);
-}
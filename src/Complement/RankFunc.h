@@ -10,8 +10,7 @@
 #include <string>
 #include <algorithm>
 #include "../Algorithms/AuxFunctions.h"
-
-#include <boost/dynamic_bitset.hpp>
+#include "../Algorithms/DenseSet.h"
 
 #define INF 100000000
 
@@ -27,74 +26,119 @@ typedef map<int, set<int> > RankInverse;
 typedef vector<vector<std::pair<int,bool> > > BackRel;
 
 /*
- * Ranking function
+ * Ranking function. The function is stored as a flat array of pairs
+ * (state, rank) sorted by states, i.e., the i-th rank belongs to the i-th
+ * state of the macrostate. Odd states and covered odd ranks are kept as
+ * bitsets, the inverse function is derived on demand. The interface mimics
+ * (const) map<int,int> (including the iteration order and comparison).
  */
-class RankFunc : public map<int,int>
+class RankFunc
 {
+public:
+  typedef std::pair<int, int> value_type;
+  typedef vector<value_type>::const_iterator const_iterator;
+  typedef const_iterator iterator;
+
 private:
 
-  set<int> oddStates;
+  vector<value_type> func;
+  DenseSet oddStates;
+  // (r-1)/2 for each odd rank r of the function
+  DenseSet oddRanks;
   int maxRank;
-  RankInverse inverse;
-  vector<int> ranks;
   int reachRest;
-  boost::dynamic_bitset<> tight;
-  //vector<bool> tight;
 
-  static vector<RankFunc> cartTightProductMap(vector<RankFunc>& s1, vector<std::pair<int, int> >& s2, int rem,
-      BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse);
-  static vector<RankFunc> cartTightProductMapList(RankConstr slist, BackRel& rel, BackRel& oddRel, int max,
-      map<int, int>& reachRes, int reachMax, bool useInverse);
-  static inline bool checkDirectBackRel(const std::pair<int, int>& act, const RankFunc& tmp, BackRel& rel);
-  static inline bool checkOddBackRel(const std::pair<int, int>& act, const RankFunc& tmp, BackRel& oddRel);
+  /*
+   * Number of odd ranks up to the maximum rank (positions to be covered)
+   */
+  int tightSize() const
+  {
+    if(this->func.empty())
+      return 0;
+    return (this->maxRank % 2 == 0 ? this->maxRank + 2 : this->maxRank + 1) / 2;
+  }
 
-  static vector<RankFunc> cartTightProductMapOdd(vector<RankFunc>& s1, vector<std::pair<int, int> >& s2,
-      int rem, BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse);
-  static vector<RankFunc> cartTightProductMapListOdd(RankConstr slist, BackRel& rel, BackRel& oddRel,
-      int max, map<int, int>& reachRes, int reachMax, bool useInverse);
+  void updateRanks(const value_type& val);
 
+public:
+  RankFunc() : func(), oddStates(), oddRanks(), maxRank(0), reachRest(INF) { }
 
-  static vector<RankFunc> cartTightProductMapPure(vector<RankFunc>& s1, vector<std::pair<int, int> >& s2, int rem,
-      BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse);
-  static vector<RankFunc> cartTightProductMapListPure(RankConstr slist, BackRel& rel, BackRel& oddRel, int max,
-      map<int, int>& reachRes, int reachMax, bool useInverse);
+  explicit RankFunc(const map<int,int>& mp);
+  void addPair(const std::pair<int, int>& val);
 
+  const_iterator begin() const { return this->func.begin(); }
+  const_iterator end() const { return this->func.end(); }
+  size_t size() const { return this->func.size(); }
+  bool empty() const { return this->func.empty(); }
 
-public:
-  RankFunc() : map<int,int>(), oddStates(), inverse(), ranks(), tight()
+  /*
+   * Find the rank of a state
+   * @param state State
+   * @return Iterator to the pair (state, rank) or end()
+   */
+  const_iterator find(int state) const
+  {
+    auto it = std::lower_bound(this->func.begin(), this->func.end(), state,
+      [](const value_type& p, int st) { return p.first < st; });
+    if(it != this->func.end() && it->first == state)
+      return it;
+    return this->func.end();
+  }
+
+  size_t count(int state) const
+  {
+    return find(state) != end() ? 1 : 0;
+  }
+
+  /*
+   * Rank of a state (0 if the state is not in the domain)
+   */
+  int operator[](int state) const
   {
-    this->maxRank = 0;
-    this->reachRest = INF;
+    auto it = find(state);
+    return it != end() ? it->second : 0;
   }
 
-  RankFunc(const map<int,int>& mp, bool useInverse);
-  void addPair(const std::pair<int, int>& val, bool useInverse);
+  explicit operator map<int,int>() const
+  {
+    return map<int,int>(this->func.begin(), this->func.end());
+  }
+
+  bool operator<(const RankFunc& rhs) const { return this->func < rhs.func; }
+  bool operator==(const RankFunc& rhs) const { return this->func == rhs.func; }
+  bool operator!=(const RankFunc& rhs) const { return this->func != rhs.func; }
 
   inline void addOddStates(set<int>& states)
   {
     this->oddStates.insert(states.begin(), states.end());
   }
 
-  inline const set<int>& getOddStates() const
+  inline const DenseSet& getOddStates() const
   {
     return this->oddStates;
   }
 
-  inline set<int>& inverseRank(int i)
-  {
-    return this->inverse[i];
-  }
+  set<int> inverseRank(int i) const;
 
   inline int getMaxRank() const
   {
     return this->maxRank;
   }
 
+  /*
+   * Number of bytes allocated by the function (approximately)
+   */
+  size_t memoryUsage() const
+  {
+    return sizeof(RankFunc) + this->func.capacity()*sizeof(value_type)
+      + this->oddStates.memoryUsage() + this->oddRanks.memoryUsage() - 2*sizeof(DenseSet);
+  }
+
   bool eqEven() const;
   bool relConsistent(set<std::pair<int, int> >& rel) const;
   bool relOddConsistent(set<std::pair<int, int> >& rel) const;
-  bool isSuccValid(RankFunc& prev, map<int, set<int> >& succ) const;
-  bool isMaxRankValid(vector<int>& maxRank) const;
+  bool isSuccValid(const RankFunc& prev, const map<int, set<int> >& succ) const;
+  bool isMaxRankValid(const vector<int>& maxRank) const;
 
   bool isAllLeq(const RankFunc& f) const;
 
@@ -103,13 +147,7 @@ public:
    */
   int remTightCount() const
   {
-    return this->tight.size() - this->tight.count();
-    // int i = 0;
-    // for(const auto& t : this->tight)
-    // {
-    //   if(t) i++;
-    // }
-    // return this->tight.size() - i;
+    return this->tightSize() - this->oddRanks.size();
   }
 
   std::string toString() const;
@@ -117,20 +155,16 @@ public:
   bool isTightRank() const;
   bool isReachConsistent(map<int, int>& res, int reachMax) const;
 
-  const vector<int>& getRanks() const { return this->ranks; }
+  vector<int> getRanks() const;
   int getReachRestr() const { return this->reachRest; }
   void setReachRestr(int val) { this->reachRest = val; }
 
   static vector<RankFunc> fromRankConstr(RankConstr constr);
-  static vector<RankFunc> tightFromRankConstr(RankConstr constr, BackRel& rel, BackRel& oddRel, map<int, int>& reachRes, int reachMax, bool useInverse);
-  static vector<RankFunc> tightFromRankConstrOdd(RankConstr constr, BackRel& rel, BackRel& oddRel, map<int, int>& reachRes, int reachMax, bool useInverse);
-  static vector<RankFunc> tightSuccFromRankConstr(RankConstr constr, BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse);
-
-  static vector<RankFunc> tightFromRankConstrPure(RankConstr constr, BackRel& rel, BackRel& oddRel, map<int, int>& reachRes, int reachMax, bool useInverse);
-  static vector<RankFunc> tightSuccFromRankConstrPure(RankConstr constr, BackRel& rel, BackRel& oddRel, int max, map<int, int>& reachRes, int reachMax, bool useInverse);
+  static vector<RankFunc> tightFromRankConstr(RankConstr constr, const BackRel& rel, const BackRel& oddRel, int max, const map<int, int>& reachRes, int reachMax);
+  static vector<RankFunc> tightFromRankConstrOdd(RankConstr constr, const BackRel& rel, const BackRel& oddRel, const map<int, int>& reachRes, int reachMax);
 
-  static vector<RankFunc> getRORanks(int ranks, std::set<int>& states, std::set<int>& fin, bool useInverse, map<int, int>& rankBound);
-  static vector<RankFunc> getRORanksSD(int ranks, std::set<int>& states, std::set<int>& fin, bool useInverse, map<int, int>& rankBound);
+  static vector<RankFunc> getRORanks(int ranks, const std::set<int>& states, const DenseSet& fin, const map<int, int>& rankBound);
+  static vector<RankFunc> getRORanksSD(int ranks, const std::set<int>& states, const DenseSet& fin, const map<int, int>& rankBound);
 };
 
 #endif
@@ -0,0 +1,140 @@
+#ifndef _RANK_FUNC_ANTICHAIN_H_
+#define _RANK_FUNC_ANTICHAIN_H_
+
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "RankFunc.h"
+#include "../Algorithms/DenseSet.h"
+
+/*
+ * Antichain of ranking functions over the same macrostate wrt the pointwise
+ * ordering. Only functions with the same maximum rank (and the same odd
+ * states if oddCheck is set) are compared, hence the functions are bucketed
+ * by these values. Each bucket keeps pointwise maxima and minima of the
+ * inserted functions, which allow to skip the dominance checks for most of
+ * the candidates. Only maximal functions are stored.
+ */
+class RankFuncAntichain
+{
+private:
+  struct Item
+  {
+    RankFunc func;
+    vector<int> ranks;
+    int sum;
+  };
+
+  struct Bucket
+  {
+    vector<Item> items;
+    // pointwise bounds of all functions inserted into the bucket
+    vector<int> upper;
+    vector<int> lower;
+
+    Bucket() : items(), upper(), lower() { }
+  };
+
+  bool oddCheck;
+  map<std::pair<int, DenseSet>, Bucket> buckets;
+
+  static bool isLeq(const vector<int>& r1, const vector<int>& r2)
+  {
+    if(r1.size() != r2.size())
+      return false;
+    for(unsigned i = 0; i < r1.size(); i++)
+    {
+      if(r1[i] > r2[i])
+        return false;
+    }
+    return true;
+  }
+
+  /*
+   * Is it1 pointwise less or equal to it2 (sums of ranks are compared first
+   * for a fast rejection)
+   */
+  static bool isLeq(const Item& it1, const Item& it2)
+  {
+    return it1.sum <= it2.sum && isLeq(it1.ranks, it2.ranks);
+  }
+
+public:
+  RankFuncAntichain(bool oddCheck = false) : oddCheck(oddCheck), buckets() { }
+
+  /*
+   * Insert a ranking function into the antichain (functions dominated by
+   * the inserted one are removed)
+   * @param func Ranking function
+   * @return Was the function inserted (i.e., it is not dominated)?
+   */
+  bool insert(const RankFunc& func)
+  {
+    Item item = { func, vector<int>(), 0 };
+    item.ranks.reserve(func.size());
+    for(const auto& p : func)
+    {
+      item.ranks.push_back(p.second);
+      item.sum += p.second;
+    }
+
+    Bucket& bucket = this->buckets[{func.getMaxRank(),
+      this->oddCheck ? func.getOddStates() : DenseSet()}];
+    if(bucket.items.empty())
+    {
+      bucket.upper = item.ranks;
+      bucket.lower = item.ranks;
+      bucket.items.push_back(std::move(item));
+      return true;
+    }
+
+    if(isLeq(item.ranks, bucket.upper))
+    {
+      for(const Item& other : bucket.items)
+      {
+        if(isLeq(item, other))
+          return false;
+      }
+    }
+    if(isLeq(bucket.lower, item.ranks))
+    {
+      bucket.items.erase(std::remove_if(bucket.items.begin(), bucket.items.end(),
+        [&item](const Item& other) { return isLeq(other, item); }), bucket.items.end());
+    }
+
+    for(unsigned i = 0; i < item.ranks.size() && i < bucket.upper.size(); i++)
+    {
+      bucket.upper[i] = std::max(bucket.upper[i], item.ranks[i]);
+      bucket.lower[i] = std::min(bucket.lower[i], item.ranks[i]);
+    }
+    bucket.items.push_back(std::move(item));
+    return true;
+  }
+
+  /*
+   * Get all functions of the antichain
+   * @return Functions sorted wrt RankFunc::operator<
+   */
+  vector<RankFunc> getFunctions() const
+  {
+    vector<RankFunc> ret;
+    for(const auto& bucket : this->buckets)
+    {
+      for(const Item& item : bucket.second.items)
+        ret.push_back(item.func);
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+  }
+
+  size_t size() const
+  {
+    size_t ret = 0;
+    for(const auto& bucket : this->buckets)
+      ret += bucket.second.items.size();
+    return ret;
+  }
+};
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef _RANK_FUNC_ENUMERATOR_H_
+#define _RANK_FUNC_ENUMERATOR_H_
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "RankFunc.h"
+
+/*
+ * Enumeration of tight ranking functions given by a rank restriction (the
+ * i-th item of the restriction contains allowed pairs (state, rank) of the
+ * i-th state). Functions are built by a depth-first backtracking over a
+ * single assignment of ranks: a branch is cut as soon as the assigned ranks
+ * violate the reachability restriction or the simulation constraints, or if
+ * the remaining positions cannot make the function tight (with the required
+ * maximum rank). Functions are emitted in the same order as by the
+ * position-wise cartesian product of the restriction.
+ */
+class RankFuncEnumerator
+{
+public:
+  // returns false to stop the enumeration
+  typedef std::function<bool(const RankFunc&)> Callback;
+
+private:
+  struct Level
+  {
+    int maxRank;
+    int reach;
+  };
+
+  const RankConstr& constr;
+  const BackRel& rel;
+  const BackRel& oddRel;
+  int max;
+  const map<int, int>& reachRes;
+  int reachMax;
+
+  // check direct simulation constraints
+  bool dirCheck;
+  // odd variant (states with even ranks are left out and completed after)
+  bool oddOnly;
+  // try greater ranks first (maximal functions are emitted first)
+  bool maximalFirst;
+
+  // number of positions to be assigned
+  unsigned depth;
+  // the enumeration is cut before the last position (see the odd variant)
+  bool partial;
+  bool stopped;
+
+  vector<std::pair<int, int>> assigned;
+  vector<Level> levels;
+  // rank of each state (-1 if not assigned)
+  vector<int> rankOf;
+  // number of assigned states with rank 2k+1 (indexed by k)
+  vector<int> oddCount;
+  int covered;
+
+  Callback callback;
+
+  static int tightSize(int maxRank)
+  {
+    return (maxRank % 2 == 0 ? maxRank + 2 : maxRank + 1) / 2;
+  }
+
+  int remTightCount(int maxRank) const
+  {
+    if(this->assigned.empty())
+      return 0;
+    return tightSize(maxRank) - this->covered;
+  }
+
+  int rankOfState(int state) const
+  {
+    return state < (int)this->rankOf.size() ? this->rankOf[state] : -1;
+  }
+
+  /*
+   * Check if an assigned pair is compatible with the assigned ranks of
+   * (rank) simulation related states
+   * @param act Assigned pair
+   * @param rl Relation
+   * @param oddOnly Compare odd ranks only
+   * @return Compatibility
+   */
+  bool checkBackRel(const std::pair<int, int>& act, const BackRel& rl, bool oddOnly) const
+  {
+    if(act.first >= (int)rl.size())
+      return true;
+    for(const auto& st : rl[act.first])
+    {
+      int rank = rankOfState(st.first);
+      if(rank == -1 || (oddOnly && rank % 2 == 0))
+        continue;
+      if(st.second && rank < act.second)
+        return false;
+      if(!st.second && rank > act.second)
+        return false;
+    }
+    return true;
+  }
+
+  /*
+   * Assign a pair to the position pos and check whether the assignment can
+   * be completed (the assignment has to be undone by unassign)
+   * @param pos Position
+   * @param act Pair to be assigned
+   * @return Can the assignment be completed?
+   */
+  bool assign(unsigned pos, const std::pair<int, int>& act)
+  {
+    const Level& prev = this->levels[pos];
+    Level& cur = this->levels[pos + 1];
+
+    this->assigned.push_back(act);
+    this->rankOf[act.first] = act.second;
+    if(act.second % 2 != 0 && this->oddCount[(act.second - 1) / 2]++ == 0)
+      this->covered++;
+    cur.maxRank = std::max(prev.maxRank, act.second);
+
+    auto it = this->reachRes.find(act.first);
+    int reach = act.second + 2*(this->reachMax - (it != this->reachRes.end() ? it->second : 0));
+    int rem = this->constr.size() - pos - 1;
+    if(pos == 0)
+    {
+      cur.reach = reach;
+      if(rem == 0)
+        return true;
+    }
+    else
+    {
+      if(rem < remTightCount(cur.maxRank))
+        return false;
+      if(this->max != -1 && rem == 0 && cur.maxRank != this->max)
+        return false;
+      cur.reach = std::min(prev.reach, reach);
+      if(cur.reach < cur.maxRank)
+        return false;
+      if(this->dirCheck && !checkBackRel(act, this->rel, false))
+        return false;
+      if(act.second % 2 != 0 && !checkBackRel(act, this->oddRel, true))
+        return false;
+    }
+
+    // the maximum rank and the covered odd ranks only grow, the reachability
+    // restriction only decreases
+    if(this->max != -1)
+    {
+      if(cur.maxRank > this->max || cur.reach < this->max)
+        return false;
+      if(tightSize(this->max) - this->covered > rem)
+        return false;
+    }
+    return true;
+  }
+
+  void unassign(const std::pair<int, int>& act)
+  {
+    if(act.second % 2 != 0 && --this->oddCount[(act.second - 1) / 2] == 0)
+      this->covered--;
+    this->rankOf[act.first] = -1;
+    this->assigned.pop_back();
+  }
+
+  void emit()
+  {
+    RankFunc func;
+    for(const auto& p : this->assigned)
+      func.addPair(p);
+    func.setReachRestr(this->levels[this->depth].reach);
+
+    if(this->oddOnly && !this->partial)
+    {
+      if(func.getMaxRank() % 2 == 0 || func.remTightCount() != 0)
+        return;
+      DenseSet odd = func.getOddStates();
+      for(unsigned i = 0; i < this->depth; i++)
+      {
+        int st = this->constr[i][0].first;
+        if(!odd.contains(st))
+          func.addPair({st, func.getMaxRank() - 1});
+      }
+    }
+    if(!this->callback(func))
+      this->stopped = true;
+  }
+
+  void search(unsigned pos)
+  {
+    if(pos == this->depth)
+    {
+      emit();
+      return;
+    }
+
+    const auto& cands = this->constr[pos];
+    bool skipped = false;
+    for(unsigned k = 0; k < cands.size() && !this->stopped; k++)
+    {
+      const auto& act = cands[this->maximalFirst ? cands.size() - k - 1 : k];
+      if(this->oddOnly && pos > 0 && act.second % 2 == 0)
+      {
+        if(!skipped)
+        {
+          skipped = true;
+          this->levels[pos + 1] = this->levels[pos];
+          search(pos + 1);
+        }
+        continue;
+      }
+      if(assign(pos, act))
+        search(pos + 1);
+      unassign(act);
+    }
+  }
+
+public:
+  RankFuncEnumerator(const RankConstr& constr, const BackRel& rel, const BackRel& oddRel,
+    int max, const map<int, int>& reachRes, int reachMax) : constr(constr),
+    rel(rel), oddRel(oddRel), max(max), reachRes(reachRes), reachMax(reachMax),
+    dirCheck(false), oddOnly(false), maximalFirst(false),
+    depth(0), partial(false), stopped(false), assigned(), levels(), rankOf(),
+    oddCount(), covered(0), callback()
+  { }
+
+  void setDirectCheck(bool val) { this->dirCheck = val; }
+  void setMaximalFirst(bool val) { this->maximalFirst = val; }
+
+  /*
+   * Odd variant: states with even ranks (except the first one) are left out
+   * during the enumeration, tight functions are completed by the rank
+   * max - 1 for these states. If a restriction of some state is empty, the
+   * functions over the previous states are returned as they are.
+   */
+  void setOddOnly(bool val) { this->oddOnly = val; }
+
+  /*
+   * Enumerate all functions
+   * @param cb Function called for each ranking function (returns false to
+   *        stop the enumeration)
+   * @return Was the enumeration completed (not stopped)?
+   */
+  bool enumerate(Callback cb)
+  {
+    if(this->constr.empty())
+      return true;
+
+    this->depth = this->constr.size();
+    this->partial = false;
+    if(this->oddOnly)
+    {
+      for(unsigned i = 1; i < this->constr.size(); i++)
+      {
+        if(this->constr[i].empty())
+        {
+          this->depth = i;
+          this->partial = true;
+          break;
+        }
+      }
+    }
+
+    int maxState = 0;
+    int maxRank = 0;
+    for(const auto& items : this->constr)
+    {
+      for(const auto& p : items)
+      {
+        maxState = std::max(maxState, p.first);
+        maxRank = std::max(maxRank, p.second);
+      }
+    }
+    this->rankOf.assign(maxState + 1, -1);
+    this->oddCount.assign(maxRank / 2 + 1, 0);
+    this->covered = 0;
+    this->assigned.clear();
+    this->levels.assign(this->depth + 1, { 0, INF });
+    this->stopped = false;
+    this->callback = cb;
+
+    search(0);
+    return !this->stopped;
+  }
+
+  /*
+   * Get all functions
+   * @return Vector of ranking functions
+   */
+  vector<RankFunc> getFunctions()
+  {
+    vector<RankFunc> ret;
+    enumerate([&ret](const RankFunc& f) { ret.push_back(f); return true; });
+    return ret;
+  }
+
+  /*
+   * Is there some function satisfying the restriction?
+   */
+  bool exists()
+  {
+    return !enumerate([](const RankFunc&) { return false; });
+  }
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef _RANK_SUCC_CACHE_H_
+#define _RANK_SUCC_CACHE_H_
+
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "RankFunc.h"
+#include "../Algorithms/DenseSet.h"
+
+/*
+ * Cache of tight rank successors bounded by a memory budget. Entries are
+ * indexed by a fingerprint of (macrostate, symbol, max rank); each index
+ * keeps the list of (ranking function, successors) pairs in the order of
+ * insertion. Successors of a ranking function f can be reused for each f'
+ * with f' <= f (pointwise). If the memory budget is exceeded, the least
+ * recently used entries are evicted.
+ */
+class RankSuccCache
+{
+private:
+  struct Key
+  {
+    DenseSet S;
+    int symbol;
+    int maxRank;
+
+    bool operator==(const Key& other) const
+    {
+      return symbol == other.symbol && maxRank == other.maxRank && S == other.S;
+    }
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const
+    {
+      std::size_t h = key.S.hash();
+      h ^= std::hash<int>()(key.symbol) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      h ^= std::hash<int>()(key.maxRank) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  struct Entry
+  {
+    Key key;
+    RankFunc func;
+    vector<RankFunc> succ;
+    std::size_t bytes;
+  };
+
+  typedef std::list<Entry> EntryList;
+
+  // entries ordered from the most recently used
+  EntryList entries;
+  std::unordered_map<Key, vector<EntryList::iterator>, KeyHash> index;
+
+  std::size_t budget;
+  std::size_t memory;
+  std::size_t hits;
+  std::size_t misses;
+  std::size_t evictions;
+
+  static std::size_t entrySize(const Key& key, const RankFunc& func, const vector<RankFunc>& succ)
+  {
+    // list node, index slot, and the data owned by the entry
+    std::size_t ret = sizeof(Entry) + 2*sizeof(void*) + sizeof(EntryList::iterator);
+    ret += key.S.memoryUsage() + func.memoryUsage() - sizeof(DenseSet) - sizeof(RankFunc);
+    for(const RankFunc& f : succ)
+      ret += f.memoryUsage();
+    return ret;
+  }
+
+  void evict()
+  {
+    auto last = std::prev(this->entries.end());
+    auto bucket = this->index.find(last->key);
+    auto& its = bucket->second;
+    its.erase(std::find(its.begin(), its.end(), last));
+    if(its.empty())
+      this->index.erase(bucket);
+
+    this->memory -= last->bytes;
+    this->entries.pop_back();
+    this->evictions++;
+  }
+
+public:
+  /*
+   * @param budget Memory budget in bytes (ComplOptions::CacheMemory)
+   */
+  explicit RankSuccCache(std::size_t budget) : entries(), index(), budget(budget),
+    memory(0), hits(0), misses(0), evictions(0) { }
+
+  /*
+   * Set the memory budget (evicts entries exceeding the new budget)
+   * @param bytes Memory budget in bytes
+   */
+  void setBudget(std::size_t bytes)
+  {
+    this->budget = bytes;
+    while(this->memory > this->budget)
+      evict();
+  }
+
+  /*
+   * Find cached successors of a ranking function
+   * @param out Out parameter to store the successors
+   * @param S Macrostate
+   * @param symbol Symbol
+   * @param func Ranking function
+   * @return Are the successors found in the cache?
+   */
+  bool lookup(vector<RankFunc>& out, const DenseSet& S, int symbol, const RankFunc& func)
+  {
+    auto bucket = this->index.find({S, symbol, func.getMaxRank()});
+    if(bucket != this->index.end())
+    {
+      for(auto it : bucket->second)
+      {
+        if(func.isAllLeq(it->func))
+        {
+          out = it->succ;
+          this->entries.splice(this->entries.begin(), this->entries, it);
+          this->hits++;
+          return true;
+        }
+      }
+    }
+    this->misses++;
+    return false;
+  }
+
+  /*
+   * Store successors of a ranking function (entries larger than the whole
+   * budget are not stored)
+   * @param S Macrostate
+   * @param symbol Symbol
+   * @param func Ranking function
+   * @param succ Successors of the ranking function
+   */
+  void insert(const DenseSet& S, int symbol, const RankFunc& func, const vector<RankFunc>& succ)
+  {
+    Key key = {S, symbol, func.getMaxRank()};
+    std::size_t bytes = entrySize(key, func, succ);
+    if(bytes > this->budget)
+      return;
+
+    this->entries.push_front({key, func, succ, bytes});
+    this->index[key].push_back(this->entries.begin());
+    this->memory += bytes;
+    while(this->memory > this->budget)
+      evict();
+  }
+
+  void clear()
+  {
+    this->entries.clear();
+    this->index.clear();
+    this->memory = 0;
+  }
+
+  std::size_t size() const { return this->entries.size(); }
+  std::size_t getMemory() const { return this->memory; }
+  std::size_t getHits() const { return this->hits; }
+  std::size_t getMisses() const { return this->misses; }
+  std::size_t getEvictions() const { return this->evictions; }
+};
+
+#endif
@@ -1,17 +1,11 @@
 #include "SemiDeterministicCompl.h"
 
-BuchiAutomaton<StateSD, int> SemiDeterministicCompl::complementSD(ComplOptions opt) {
-    if (opt.ncsbLazy)
-        this->ncsbTransform();
-    //std::cerr << this->toString() << std::endl;
-
-    std::set<StateSD> initials;
-    std::set<StateSD> states;
-    std::set<StateSD> finals;
-    std::map<std::pair<StateSD, int>, std::set<StateSD>> transitions;
-    std::set<int> alphabet = this->getAlphabet();
-
-    // initial states
+/*
+ * Initial macrostate of the NCSB construction
+ * @return Initial macrostate
+ */
+StateSD SemiDeterministicCompl::getInitialSD()
+{
     std::set<int> N;
     if (this->getNonDet().size() > 0)
         std::set_intersection(this->getNonDet().begin(), this->getNonDet().end(), this->getInitials().begin(), this->getInitials().end(), std::inserter(N, N.begin()));
@@ -19,99 +13,282 @@ BuchiAutomaton<StateSD, int> SemiDeterministicCompl::complementSD(ComplOptions o
     if (this->getDet().size() > 0)
         std::set_intersection(this->getDet().begin(), this->getDet().end(), this->getInitials().begin(), this->getInitials().end(), std::back_inserter(C_union_S));
 
-    // one initial state
     std::set<int> C_union_S_set(C_union_S.begin(), C_union_S.end());
-    StateSD init = {N, C_union_S_set, std::set<int>(), C_union_S_set};
-    initials.insert(init);
-    states.insert(init);
-
-    std::stack<StateSD> stack;
-    for (const auto& init : initials)
-        stack.push(init);
-    while (stack.size() > 0){
-        StateSD state = stack.top();
-        stack.pop();
-
-        // final states
-        if (isSDStateFinal(state))
-            finals.insert(state);
-
-        for (const auto& symbol : alphabet)
-        {
-            // get successors
-            std::vector<StateSD> successors;
-            if (!opt.ncsbLazy)
-            {
-                //successors = getSuccessorsOriginal(state, symbol);
-                successors = getSuccessorsMaxRank(state, symbol);
-            }
-            else
-            {
-                successors = getSuccessorsLazy(state, symbol);
-            }
+    return {N, C_union_S_set, std::set<int>(), C_union_S_set};
+}
 
-            for (const auto& succ : successors){
-                //std::cerr << succ.toString() << std::endl;
-                if (states.find(succ) == states.end()){
-                    states.insert(succ);
-                    stack.push(succ);
-                }
+
+/*
+ * NCSB complementation
+ * @param opt Complementation options (opt.ncsbLazy selects the variant)
+ * @return Complement automaton
+ */
+BuchiAutomaton<StateSD, int> SemiDeterministicCompl::complementSD(ComplOptions opt) {
+    SDVariant var = opt.ncsbLazy ? SD_LAZY : SD_MAXRANK;
+    return complementSDVariants(!opt.ncsbLazy, opt.ncsbLazy)[var];
+}
+
+
+/*
+ * NCSB complementation constructing the MaxRank and the Lazy variant.
+ * MaxRank is constructed on the automaton as it is, Lazy on the automaton
+ * after ncsbTransform. Macrostates of both variants are stored once (and
+ * referred to by ids) and the part of successors shared by the variants is
+ * computed once for each macrostate and symbol. The transformation only adds
+ * copies of states (with transitions leaving them), successors of the
+ * original states are hence the same before and after it. Each variant is
+ * explored depth-first, macrostates from which no accepting cycle is
+ * reachable are dropped.
+ * @param maxRank Construct the MaxRank variant
+ * @param lazy Construct the Lazy variant
+ * @return Complement automata indexed by SDVariant (the automaton of a
+ *         variant that is not constructed is empty)
+ */
+vector<BuchiAutomaton<StateSD, int>> SemiDeterministicCompl::complementSDVariants(bool maxRank, bool lazy)
+{
+    typedef uint32_t StateId;
+    const unsigned VARIANTS = 2;
+
+    this->transTable = this->getTransitionTable();
+
+    std::set<int> alph = this->getAlphabet();
+    std::vector<int> alphabet(alph.begin(), alph.end());
+    bool build[VARIANTS] = { maxRank, lazy };
+    bool shared = maxRank && lazy;
+    // states of the automaton before ncsbTransform; shared parts of
+    // successors of macrostates containing copies made by the
+    // transformation are not reused
+    DenseSet original(this->getStates());
+
+    std::map<StateSD, StateId> ids;
+    std::vector<StateSD> states;
+    // macrostates reached/expanded in each variant (indexed by ids)
+    std::vector<bool> reached[VARIANTS];
+    std::vector<bool> expanded[VARIANTS];
+    size_t reachCount[VARIANTS] = { 0, 0 };
+    // macrostates dropped in each variant (they are not reported)
+    size_t deadCount[VARIANTS] = { 0, 0 };
+    auto report = [&]()
+    {
+        ComplProgress::report(std::max(reachCount[0] - deadCount[0],
+            reachCount[1] - deadCount[1]));
+    };
+    // successors in each variant (indexed by ids and positions of symbols)
+    std::vector<std::vector<std::vector<StateId>>> succs[VARIANTS];
+    // shared parts of successors waiting for the other variant
+    std::vector<std::vector<SDSuccBase>> bases;
+    // macrostates from which no accepting cycle is reachable are dropped
+    // (together with their successors) as soon as their SCC is completed
+    SccExplorer scc[VARIANTS];
+
+    auto reach = [&](const StateSD& st, unsigned var) -> StateId
+    {
+        auto ins = ids.insert({st, (StateId)states.size()});
+        if (ins.second){
+            states.push_back(st);
+            for (unsigned v = 0; v < VARIANTS; v++){
+                reached[v].push_back(false);
+                expanded[v].push_back(false);
+                succs[v].emplace_back();
             }
+            bases.emplace_back();
+        }
+        StateId id = ins.first->second;
+        if (!reached[var][id]){
+            reached[var][id] = true;
+            reachCount[var]++;
+            report();
+        }
+        return id;
+    };
 
-            // transitions
-            set<StateSD> successorsSet(successors.begin(), successors.end());
-            transitions[{state, symbol}] = successorsSet;
+    auto expand = [&](StateId id, unsigned v) -> std::vector<int>
+    {
+        StateSD state = states[id];
+        std::vector<SDSuccBase> stBases;
+        if (!bases[id].empty())
+            stBases = std::move(bases[id]);
+        else {
+            for (int symbol : alphabet)
+                stBases.push_back(getSuccBase(state, symbol));
+        }
+
+        std::vector<int> ret;
+        expanded[v][id] = true;
+        succs[v][id].resize(alphabet.size());
+        for (unsigned i = 0; i < alphabet.size(); i++){
+            std::vector<StateSD> successors = (v == SD_MAXRANK) ?
+                getSuccessorsMaxRank(state, alphabet[i], stBases[i]) :
+                getSuccessorsLazy(state, alphabet[i], stBases[i]);
+            std::vector<StateId> dst;
+            for (const auto& succ : successors)
+                dst.push_back(reach(succ, v));
+            std::sort(dst.begin(), dst.end());
+            dst.erase(std::unique(dst.begin(), dst.end()), dst.end());
+            ret.insert(ret.end(), dst.begin(), dst.end());
+            succs[v][id][i] = std::move(dst);
+        }
+
+        // the macrostate may be reached later in the other variant
+        bool orig = (state.N | state.C | state.S).isSubsetOf(original);
+        if (shared && orig && !(expanded[SD_MAXRANK][id] && expanded[SD_LAZY][id]))
+            bases[id] = std::move(stBases);
+        return ret;
+    };
+
+    // one initial state
+    StateSD init = getInitialSD();
+    for (unsigned v = 0; v < VARIANTS; v++){
+        if (!build[v])
+            continue;
+        if (v == SD_LAZY){
+            this->ncsbTransform();
+            this->transTable = this->getTransitionTable();
         }
+        scc[v].explore(reach(init, v),
+            [&](int id) { return expand(id, v); },
+            [&](int id) { return isSDStateFinal(states[id]); },
+            [&](const std::vector<int>& comp){
+                for (int id : comp)
+                    std::vector<std::vector<StateId>>().swap(succs[v][id]);
+                deadCount[v] += comp.size();
+                report();
+            });
     }
 
-    auto ret = BuchiAutomaton<StateSD, int>(states, finals, initials, transitions, alphabet, getAPPattern());
-    //std::cerr << "States: " << states.size() << std::endl;
-    //std::cerr << ret.toString() << std::endl;
+    vector<BuchiAutomaton<StateSD, int>> ret(VARIANTS);
+    for (unsigned v = 0; v < VARIANTS; v++){
+        if (!build[v])
+            continue;
+        std::set<StateSD> resStates;
+        std::set<StateSD> finals;
+        std::map<std::pair<StateSD, int>, std::set<StateSD>> transitions;
+        for (StateId id = 0; id < states.size(); id++){
+            if (!reached[v][id] || scc[v].isDead(id))
+                continue;
+            const StateSD& state = states[id];
+            resStates.insert(state);
+            if (isSDStateFinal(state))
+                finals.insert(state);
+            for (unsigned i = 0; i < alphabet.size(); i++){
+                std::set<StateSD>& dst = transitions[{state, alphabet[i]}];
+                for (StateId d : succs[v][id][i]){
+                    if (!scc[v].isDead(d))
+                        dst.insert(states[d]);
+                }
+            }
+        }
+        // the initial macrostate is dropped if the language is empty
+        std::set<StateSD> initials;
+        if (resStates.count(init) > 0)
+            initials.insert(init);
+        ret[v] = BuchiAutomaton<StateSD, int>(resStates, finals, initials,
+            transitions, alph, getAPPattern());
+    }
     return ret;
 }
 
 
-std::vector<StateSD> SemiDeterministicCompl::getSuccessorsMaxRank(StateSD& state, int symbol)
+
+/*
+ * NCSB complementation constructed on demand (the automaton has to outlive
+ * the returned object)
+ * @param opt Complementation options
+ * @return Lazy complement
+ */
+LazyComplement<StateSD> SemiDeterministicCompl::lazyComplementSD(ComplOptions opt)
 {
-    std::vector<StateSD> successors;
-    auto fin = this->getFinals();
+    if (opt.ncsbLazy)
+        this->ncsbTransform();
+    this->transTable = this->getTransitionTable();
 
-    StateSD succ1;
+    auto succ = [this, opt](const StateSD& st, int symbol) -> std::vector<StateSD>
+    {
+        StateSD state = st;
+        if (!opt.ncsbLazy)
+            return getSuccessorsMaxRank(state, symbol);
+        return getSuccessorsLazy(state, symbol);
+    };
+    auto acc = [this](const StateSD& st) -> bool { return isSDStateFinal(st); };
+    return LazyComplement<StateSD>({getInitialSD()}, this->getAlphabet(), succ, acc);
+}
 
-    auto NsuccSet = this->succSet(state.N, symbol);
+/*
+ * Subsets of a set
+ * @param set Set of states
+ * @return All subsets of set
+ */
+vector<DenseSet> SemiDeterministicCompl::getAllSubsets(const DenseSet& set)
+{
+    std::vector<int> elems(set.begin(), set.end());
+    vector<DenseSet> ret;
+    for (uint64_t mask = 0; mask < ((uint64_t)1 << elems.size()); mask++){
+        DenseSet subset;
+        for (unsigned i = 0; i < elems.size(); i++){
+            if (mask & ((uint64_t)1 << i))
+                subset.insert(elems[i]);
+        }
+        ret.push_back(subset);
+    }
+    return ret;
+}
 
-    std::set_intersection(NsuccSet.begin(), NsuccSet.end(), this->getNonDet().begin(), this->getNonDet().end(), std::inserter(succ1.N, succ1.N.begin()));
 
-    std::vector<int> NtoDet;
-    std::set_intersection(NsuccSet.begin(), NsuccSet.end(), this->getDet().begin(), this->getDet().end(), std::back_inserter(NtoDet));
+/*
+ * Compute the part of NCSB successors shared by the MaxRank and the Lazy
+ * variant
+ * @param state Macrostate
+ * @param symbol Symbol
+ * @return Shared part of successors
+ */
+SDSuccBase SemiDeterministicCompl::getSuccBase(const StateSD& state, int symbol)
+{
+    SDSuccBase base;
+    DenseSet NsuccSet = this->succSet(state.N, symbol);
+    base.N = NsuccSet & DenseSet(this->getNonDet());
+    base.NDet = NsuccSet & DenseSet(this->getDet());
+    base.C = this->succSet(state.C, symbol);
+    base.S = this->succSet(state.S, symbol);
+    for (const auto& tr : this->getFinTrans())
+    {
+        if (tr.symbol == symbol and state.S.contains(tr.from))
+            base.SFins.insert(tr.to);
+    }
+    return base;
+}
 
-    succ1.C = this->succSet(state.C, symbol);
-    succ1.C.insert(NtoDet.begin(), NtoDet.end());
 
-    auto SsuccSet = this->succSet(state.S, symbol);
+std::vector<StateSD> SemiDeterministicCompl::getSuccessorsMaxRank(StateSD& state, int symbol)
+{
+    return getSuccessorsMaxRank(state, symbol, getSuccBase(state, symbol));
+}
 
-    set<int> finReachS;
-    for (auto tr : this->getFinTrans())
-    {
-        if (tr.symbol == symbol and state.S.find(tr.from) != state.S.end() and SsuccSet.find(tr.to) != SsuccSet.end())
-        {
-            finReachS.insert(tr.to);
-        }
-    }
-    set<int> allFins;
-    std::set_union(fin.begin(), fin.end(), finReachS.begin(), finReachS.end(), std::inserter(allFins, allFins.begin()));
 
-    set<int> FinS;
-    std::set_intersection(SsuccSet.begin(), SsuccSet.end(), allFins.begin(), allFins.end(), std::inserter(FinS, FinS.begin()));
-    if(FinS.size() > 0)
+/*
+ * Successors of the MaxRank variant of NCSB
+ * @param state Macrostate
+ * @param symbol Symbol
+ * @param base Shared part of successors of state over symbol
+ * @return Successors
+ */
+std::vector<StateSD> SemiDeterministicCompl::getSuccessorsMaxRank(const StateSD& state, int symbol,
+    const SDSuccBase& base)
+{
+    std::vector<StateSD> successors;
+    DenseSet fin(this->getFinals());
+
+    StateSD succ1;
+    succ1.N = base.N;
+    succ1.C = base.C | base.NDet;
+
+    DenseSet allFins = fin | (base.SFins & base.S);
+    if(base.S.intersects(allFins))
     {
       return successors;
     }
 
-    set<int> tmp;
-    std::set_difference(succ1.C.begin(), succ1.C.end(), SsuccSet.begin(), SsuccSet.end(), std::inserter(tmp, tmp.begin()));
-    succ1.C = tmp;
-    succ1.S = SsuccSet;
+    succ1.C -= base.S;
+    succ1.S = base.S;
 
     if(state.B.size() == 0)
     {
@@ -119,23 +296,16 @@ std::vector<StateSD> SemiDeterministicCompl::getSuccessorsMaxRank(StateSD& state
     }
     else
     {
-      auto succB = this->succSet(state.B, symbol);
-      std::set_intersection(succB.begin(), succB.end(), succ1.C.begin(), succ1.C.end(), std::inserter(succ1.B, succ1.B.begin()));
+      succ1.B = this->succSet(state.B, symbol) & succ1.C;
     }
 
     StateSD succ2 = succ1;
-    set<int> rem;
-    succ2.B = set<int>();
-    std::set_difference(succ1.B.begin(), succ1.B.end(), allFins.begin(), allFins.end(), std::inserter(rem, rem.begin()));
-    std::set_intersection(succ1.B.begin(), succ1.B.end(), allFins.begin(), allFins.end(), std::inserter(succ2.B, succ2.B.begin()));
-    succ2.S.insert(rem.begin(), rem.end());
-    set<int> aux;
-    std::set_difference(succ2.C.begin(), succ2.C.end(), rem.begin(), rem.end(), std::inserter(aux, aux.begin()));
-    succ2.C = aux;
-
-    aux = set<int>();
-    std::set_intersection(succ1.B.begin(), succ1.B.end(), allFins.begin(), allFins.end(), std::inserter(aux, aux.begin()));
-    if(aux.size() == 0)
+    DenseSet rem = succ1.B - allFins;
+    succ2.B = succ1.B & allFins;
+    succ2.S |= rem;
+    succ2.C -= rem;
+
+    if(!succ1.B.intersects(allFins))
     {
       successors.push_back(succ2);
     }
@@ -146,6 +316,18 @@ std::vector<StateSD> SemiDeterministicCompl::getSuccessorsMaxRank(StateSD& state
 }
 
 
+/*
+ * Set of all successors (macrostate stored as a dense set).
+ * @param states Set of states to get successors
+ * @param symbol Symbol
+ * @return Set of successors over symbol
+ */
+DenseSet SemiDeterministicCompl::succSet(const DenseSet& states, int symbol)
+{
+  return this->transTable.succSet(states, symbol);
+}
+
+
 std::vector<StateSD> SemiDeterministicCompl::getSuccessorsOriginal(StateSD& state, int symbol){
     std::vector<StateSD> successors;
 
@@ -228,134 +410,58 @@ std::vector<StateSD> SemiDeterministicCompl::getSuccessorsOriginal(StateSD& stat
 }
 
 std::vector<StateSD> SemiDeterministicCompl::getSuccessorsLazy(StateSD& state, int symbol){
-    std::vector<StateSD> successors;
+    return getSuccessorsLazy(state, symbol, getSuccBase(state, symbol));
+}
 
-    // N'
-    std::set<int> N_prime;
-    if (state.N.size() > 0){
-        auto succSet = this->succSet(state.N, symbol);
-        std::set_intersection(succSet.begin(), succSet.end(), this->getNonDet().begin(), this->getNonDet().end(), std::inserter(N_prime, N_prime.begin()));
-    }
 
-    // S'
-    std::set<int> S_prime_base = this->succSet(state.S, symbol);
+/*
+ * Successors of the Lazy variant of NCSB. Accepting states cannot be moved
+ * to S', hence only the other states are distributed among S' and B' (C').
+ * @param state Macrostate
+ * @param symbol Symbol
+ * @param base Shared part of successors of state over symbol
+ * @return Successors
+ */
+std::vector<StateSD> SemiDeterministicCompl::getSuccessorsLazy(const StateSD& state, int symbol,
+    const SDSuccBase& base)
+{
+    std::vector<StateSD> successors;
+    DenseSet fin(this->getFinals());
+    DenseSet allFins = fin | base.SFins;
+    if (base.S.intersects(allFins))
+        return successors;
 
+    StateSD newState;
+    newState.N = base.N;
     if (state.B.size() == 0){
-        // C'
-        std::set<int> C_prime_base;
-
-        std::vector<int> N_to_det;
-        auto succSet = this->succSet(state.N, symbol);
-        std::set_intersection(succSet.begin(), succSet.end(), this->getDet().begin(), this->getDet().end(), std::back_inserter(N_to_det));
-
-        std::set<int> C_reach = this->succSet(state.C, symbol);
-        std::set<int> union_reach;
-        std::set_union(N_to_det.begin(), N_to_det.end(), C_reach.begin(), C_reach.end(), std::inserter(union_reach, union_reach.begin()));
-        std::vector<int> remaining;
-        std::set_difference(union_reach.begin(), union_reach.end(), S_prime_base.begin(), S_prime_base.end(), std::back_inserter(remaining));
-
-        auto subsets = Aux::getAllSubsets(remaining);
-
-        for (const auto& subset : subsets){
-            StateSD newState;
-            newState.N = N_prime;
-
-            std::vector<int> subsetComplement;
-            std::set_difference(remaining.begin(), remaining.end(), subset.begin(), subset.end(), std::back_inserter(subsetComplement));
-
-            std::set_union(C_prime_base.begin(), C_prime_base.end(), subset.begin(), subset.end(), std::inserter(newState.C, newState.C.begin()));
-
-            std::set_union(S_prime_base.begin(), S_prime_base.end(), subsetComplement.begin(), subsetComplement.end(), std::inserter(newState.S, newState.S.begin()));
-
-            set<int> SFinTrans;
-            for (const auto& tr : this->getFinTrans()){
-                if (tr.symbol == symbol and state.S.find(tr.from) != state.S.end()){
-                    SFinTrans.insert(tr.to);
-                }
-            }
-
-            std::set<int> allFins;
-            std::set_union(this->getFinals().begin(), this->getFinals().end(), SFinTrans.begin(), SFinTrans.end(), std::inserter(allFins, allFins.begin()));
-
-            std::set<int> F_in_S;
-            std::set_intersection(newState.S.begin(), newState.S.end(), allFins.begin(), allFins.end(), std::inserter(F_in_S, F_in_S.begin()));
-            if (F_in_S.size() > 0)
-                continue;
+        DenseSet remaining = (base.NDet | base.C) - base.S;
+        DenseSet forced = remaining & allFins;
 
+        for (const auto& subset : getAllSubsets(remaining - allFins)){
+            newState.C = forced | subset;
+            newState.S = base.S | (remaining - newState.C);
             newState.B = newState.C;
-
             successors.push_back(newState);
         }
     }
-
     else {
-        set<int> BFinTrans;
+        DenseSet BFinTrans;
         for (const auto& tr : this->getFinTrans()){
-            if (tr.symbol == symbol and state.B.find(tr.from) != state.B.end()){
+            if (tr.symbol == symbol and state.B.contains(tr.from))
                 BFinTrans.insert(tr.from);
-            }
         }
 
-        set<int> allFins;
-        std::set_union(this->getFinals().begin(), this->getFinals().end(), BFinTrans.begin(), BFinTrans.end(), std::inserter(allFins, allFins.begin()));
-
-        std::set<int> B_not_acc;
-        if (state.B.size() > 0){
-            std::set_difference(state.B.begin(), state.B.end(), allFins.begin(), allFins.end(), std::inserter(B_not_acc, B_not_acc.begin()));
-        }
-        std::set<int> B_prime_base = this->succSet(B_not_acc, symbol);
-
-        std::set<int> B_union_S;
-        std::set_union(state.B.begin(), state.B.end(), state.S.begin(), state.S.end(), std::inserter(B_union_S, B_union_S.begin()));
-        std::set<int> remaining;
-        std::set_difference(B_union_S.begin(), B_union_S.end(), B_not_acc.begin(), B_not_acc.end(), std::inserter(remaining, remaining.begin()));
-        std::set<int> remTmp = this->succSet(remaining, symbol);
-        std::vector<int> remReach(remTmp.begin(), remTmp.end());
-
-        std::vector<int> rem;
-        std::set_difference(remReach.begin(), remReach.end(), B_prime_base.begin(), B_prime_base.end(), std::back_inserter(rem));
-        remReach = rem;
-        std::vector<int> rem2;
-        std::set_difference(remReach.begin(), remReach.end(), S_prime_base.begin(), S_prime_base.end(), std::back_inserter(rem2));
-        remReach = rem2;
-
-        auto subsets = Aux::getAllSubsets(remReach);
-
-        for (const auto& subset : subsets){
-            StateSD newState;
-            newState.N = N_prime;
-
-            std::vector<int> subsetComplement;
-            std::set_difference(remReach.begin(), remReach.end(), subset.begin(), subset.end(), std::back_inserter(subsetComplement));
-
-            std::set_union(B_prime_base.begin(), B_prime_base.end(), subset.begin(), subset.end(), std::inserter(newState.B, newState.B.begin()));
-
-            std::set_union(S_prime_base.begin(), S_prime_base.end(), subsetComplement.begin(), subsetComplement.end(), std::inserter(newState.S, newState.S.begin()));
-
-            set<int> SFinTrans;
-            for (auto tr : this->getFinTrans()){
-                if (tr.symbol == symbol and state.S.find(tr.from) != state.S.end()){
-                    SFinTrans.insert(tr.to);
-                }
-            }
-
-            allFins.clear();
-            std::set_union(this->getFinals().begin(), this->getFinals().end(), SFinTrans.begin(), SFinTrans.end(), std::inserter(allFins, allFins.begin()));
-
-            std::set<int> F_in_S;
-            std::set_intersection(newState.S.begin(), newState.S.end(), allFins.begin(), allFins.end(), std::inserter(F_in_S, F_in_S.begin()));
-            if (F_in_S.size() > 0)
-                continue;
-
-            // C'
-            std::set<int> C_reach = this->succSet(state.C, symbol);
-            std::vector<int> N_to_det;
-            auto succSet = this->succSet(state.N, symbol);
-            std::set_intersection(succSet.begin(), succSet.end(), this->getDet().begin(), this->getDet().end(), std::back_inserter(N_to_det));
-            std::set<int> reachUnion;
-            std::set_union(C_reach.begin(), C_reach.end(), N_to_det.begin(), N_to_det.end(), std::inserter(reachUnion, reachUnion.begin()));
-            std::set_difference(reachUnion.begin(), reachUnion.end(), newState.S.begin(), newState.S.end(), std::inserter(newState.C, newState.C.begin()));
-
+        DenseSet BNotAcc = state.B - (fin | BFinTrans);
+        DenseSet BPrimeBase = this->succSet(BNotAcc, symbol);
+        DenseSet remReach = this->succSet((state.B | state.S) - BNotAcc, symbol);
+        remReach = (remReach - BPrimeBase) - base.S;
+        DenseSet forced = remReach & allFins;
+        DenseSet reachC = base.C | base.NDet;
+
+        for (const auto& subset : getAllSubsets(remReach - allFins)){
+            newState.B = BPrimeBase | forced | subset;
+            newState.S = base.S | (remReach - newState.B);
+            newState.C = reachC - newState.S;
             successors.push_back(newState);
         }
     }
@@ -363,8 +469,12 @@ std::vector<StateSD> SemiDeterministicCompl::getSuccessorsLazy(StateSD& state, i
     return successors;
 }
 
-void SemiDeterministicCompl::ncsbTransform() {
-    // get D start states
+/*
+ * Nonaccepting deterministic states entered from the nondeterministic part
+ * (states duplicated by ncsbTransform)
+ * @return Set of states
+ */
+std::set<int> SemiDeterministicCompl::getNcsbDetStart() {
     std::set<int> detStart;
     auto nonDet = this->getNonDet();
     auto det = this->getDet();
@@ -376,8 +486,11 @@ void SemiDeterministicCompl::ncsbTransform() {
             }
         }
     }
+    return detStart;
+}
 
-    for (auto state : detStart){
+void SemiDeterministicCompl::ncsbTransform() {
+    for (auto state : getNcsbDetStart()){
         // add new accepting state
         int newState = this->getStates().size();
         this->addStates(newState);
@@ -406,14 +519,13 @@ void SemiDeterministicCompl::ncsbTransform() {
     }
 }
 
-set<int> SemiDeterministicCompl::getDirectSet(set<int>& states, Relation<int>& dirSim)
+/*
+ * Remove states simulated by another state of the set
+ * @param states Set of states
+ * @param dirSim Simulation relation
+ * @return Pruned set of states
+ */
+DenseSet SemiDeterministicCompl::getDirectSet(const DenseSet& states, const BitRelation& dirSim)
 {
-  // remove smaller states w.r.t. simulation
-  std::set<int> retStates;
-  for (const auto& state : states){
-    if (not std::any_of(dirSim.begin(), dirSim.end(), [state, states](std::pair<int, int> pr){ return state == pr.first and state != pr.second and states.find(pr.second) != states.end(); }))
-      retStates.insert(state);
-  }
-
-  return retStates;
-}
\ No newline at end of file
+  return dirSim.removeSmaller(states);
+}
@@ -7,21 +7,47 @@
 #include <vector>
 #include <stack>
 #include <chrono>
+#include <memory>
 #include <algorithm>
 
 #include <iostream>
 #include <algorithm>
 
 #include "../Algorithms/AuxFunctions.h"
+#include "../Algorithms/BitRelation.h"
+#include "../Algorithms/SccExplorer.h"
 #include "../Automata/BuchiAutomaton.h"
 #include "StateSD.h"
 #include "Options.h"
+#include "ComplProgress.h"
+#include "LazyComplement.h"
 #include "../Algorithms/Simulations.h"
+#include "AutomatonAnalysis.h"
 
 using std::vector;
 using std::set;
 using std::map;
 
+/*
+ * Variants of the NCSB construction
+ */
+enum SDVariant { SD_MAXRANK = 0, SD_LAZY = 1 };
+
+/*
+ * Part of the NCSB successors of a macrostate over a symbol that is shared
+ * by the MaxRank and the Lazy variant (it depends on N, C, S only)
+ */
+struct SDSuccBase
+{
+    DenseSet N;     // successors of N in the nondeterministic part
+    DenseSet NDet;  // successors of N in the deterministic part
+    DenseSet C;     // successors of C
+    DenseSet S;     // successors of S
+    DenseSet SFins; // targets of accepting transitions leaving S
+
+    SDSuccBase() : N(), NDet(), C(), S(), SFins() { }
+};
+
 /*
  * Semi-deterministic automata complementation
  */
@@ -30,43 +56,57 @@ class SemiDeterministicCompl : public BuchiAutomaton<int, int>
 private:
     std::set<int> det;
     std::set<int> nondet;
-    Relation<int> dirSim;
-    Relation<int> reachDirSim;
+    BitRelation dirSim;
+    BitRelation reachDirSim;
+    TransitionTable transTable;
 
 protected:
-
+  StateSD getInitialSD();
+  static vector<DenseSet> getAllSubsets(const DenseSet& set);
 
 public:
-  SemiDeterministicCompl(BuchiAutomaton<int, int> *t) : BuchiAutomaton<int, int>(*t), det(), nondet()
+  SemiDeterministicCompl(BuchiAutomaton<int, int> *t) : SemiDeterministicCompl(t, std::make_shared<AutomatonAnalysis>(*t)) { }
+
+  /*
+   * @param t Semideterministic automaton
+   * @param analysis Analysis of the automaton t (shared with other phases)
+   */
+  SemiDeterministicCompl(BuchiAutomaton<int, int> *t, std::shared_ptr<AutomatonAnalysis> analysis) :
+    BuchiAutomaton<int, int>(*t), det(), nondet(), dirSim(), reachDirSim(), transTable()
   {
-    SCCs sccs = this->getAutGraphSCCs();
-    for (auto scc : sccs){
-        if (this->isReachDeterministic(scc)){
-            this->det.insert(scc.begin(), scc.end());
+    // states from which only deterministic states are reachable
+    const Condensation& cond = analysis->getCondensation();
+    vector<bool> detComp(cond.size());
+    for (unsigned c = 0; c < cond.size(); c++)
+        detComp[c] = cond.isDeterministic(c);
+    detComp = cond.closeForward(detComp);
+    for (unsigned c = 0; c < cond.size(); c++){
+        if (detComp[c]){
+            this->det.insert(cond.getVertices(c).begin(), cond.getVertices(c).end());
         } else {
-            this->nondet.insert(scc.begin(), scc.end());
+            this->nondet.insert(cond.getVertices(c).begin(), cond.getVertices(c).end());
         }
     }
 
     // direct sim
-    this->dirSim = this->getDirectSim();
+    int n = this->getStates().size();
+    this->dirSim = BitRelation(this->getDirectSim(), n);
     // reachability
-    Relation<int> rel;
-    SCCs reachabilityVector = this->reachableVector();
-    for (auto pr : this->dirSim){
-      // check reachability
-      set<int> intersect;
-      std::set_intersection(reachabilityVector[pr.first].begin(), reachabilityVector[pr.first].end(), reachabilityVector[pr.second].begin(), reachabilityVector[pr.second].end(), std::inserter(intersect, intersect.begin()));
-      if(intersect.size() == 0)
-        rel.insert(pr);
-
-      if (reachabilityVector[pr.first].find(pr.second) != reachabilityVector[pr.first].end() and reachabilityVector[pr.second].find(pr.first) == reachabilityVector[pr.second].end())
-        rel.insert(pr);
+    BitRelation rel(n);
+    const Reachability& reach = analysis->getReachability();
+    for (int p = 0; p < n; p++){
+      for (int q : this->dirSim.row(p)){
+        // check reachability
+        if (not reach.reachCommon(p, q) or (reach.isReachable(p, q) and not reach.isReachable(q, p)))
+          rel.add(p, q);
+      }
     }
     this->reachDirSim = rel;
   }
 
   BuchiAutomaton<StateSD, int> complementSD(ComplOptions opt);
+  vector<BuchiAutomaton<StateSD, int>> complementSDVariants(bool maxRank, bool lazy);
+  LazyComplement<StateSD> lazyComplementSD(ComplOptions opt);
 
   std::set<int>& getDet(){
       return this->det;
@@ -88,11 +128,19 @@ public:
   std::vector<StateSD> getSuccessorsLazy(StateSD& state, int symbol);
   std::vector<StateSD> getSuccessorsMaxRank(StateSD& state, int symbol);
 
+  SDSuccBase getSuccBase(const StateSD& state, int symbol);
+  std::vector<StateSD> getSuccessorsLazy(const StateSD& state, int symbol, const SDSuccBase& base);
+  std::vector<StateSD> getSuccessorsMaxRank(const StateSD& state, int symbol, const SDSuccBase& base);
+
+  using BuchiAutomaton<int, int>::succSet;
+  DenseSet succSet(const DenseSet& states, int symbol);
+
+  std::set<int> getNcsbDetStart();
   void ncsbTransform();
 
-  set<int> getDirectSet(set<int>& states, Relation<int>& dirSim);
+  DenseSet getDirectSet(const DenseSet& states, const BitRelation& dirSim);
 
-  Relation<int>& getWeakDirSim(){
+  BitRelation& getWeakDirSim(){
     return this->reachDirSim;
   }
 };
@@ -6,12 +6,14 @@
 #include <map>
 #include <string>
 
+#include "../Algorithms/DenseSet.h"
+
 /*
  * State of the KV construction
  */
 struct StateGcoBA {
-  std::set<int> S;
-  std::set<int> B;
+  DenseSet S;
+  DenseSet B;
   int i;
 
   bool operator <(const StateGcoBA& rhs) const
@@ -31,6 +33,14 @@ struct StateGcoBA {
     return S == rhs.S && B == rhs.B && i == rhs.i;
   }
 
+  std::size_t hash() const
+  {
+    std::size_t h = S.hash();
+    h ^= B.hash() + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()(i) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+  }
+
   std::string toString()
   {
     std::string ret = "({" + printSet(S) + "},{";
@@ -40,7 +50,7 @@ struct StateGcoBA {
     return ret;
   }
 
-  std::string printSet(std::set<int> st)
+  std::string printSet(const DenseSet& st)
   {
     std::string ret;
     for (auto s : st)
@@ -6,14 +6,16 @@
 #include <map>
 #include <string>
 
+#include "../Algorithms/DenseSet.h"
+
 /*
  * State of the Schewe construction
  */
 struct StateSD {
-  std::set<int> N;
-  std::set<int> C;
-  std::set<int> S;
-  std::set<int> B;
+  DenseSet N;
+  DenseSet C;
+  DenseSet S;
+  DenseSet B;
 
   bool operator <(const StateSD& rhs) const
   {
@@ -40,7 +42,7 @@ struct StateSD {
     return ret;
   }
 
-  static std::string printSet(std::set<int> st)
+  static std::string printSet(const DenseSet& st)
   {
     std::string ret;
     for (auto s : st)
@@ -6,14 +6,16 @@
 #include <map>
 #include <string>
 
+#include "../Algorithms/DenseSet.h"
+
 #include "RankFunc.h"
 
 /*
  * State of the Schewe construction
  */
 struct StateSch {
-  std::set<int> S;
-  std::set<int> O;
+  DenseSet S;
+  DenseSet O;
   RankFunc f;
   int i;
   bool tight;
@@ -55,7 +57,7 @@ struct StateSch {
     return ret;
   }
 
-  static std::string printSet(std::set<int> st)
+  static std::string printSet(const DenseSet& st)
   {
     std::string ret;
     for (auto s : st)
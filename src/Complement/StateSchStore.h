@@ -0,0 +1,232 @@
+#ifndef _STATE_SCH_STORE_H_
+#define _STATE_SCH_STORE_H_
+
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include "StateSch.h"
+
+/*
+ * Store of macrostates of the Schewe construction (hash consing). Each
+ * macrostate is stored only once and it is identified by a 32-bit id
+ * (ids are assigned in the order of insertion). Two macrostates are
+ * considered to be the same iff they are equivalent wrt StateSch::operator<,
+ * i.e., the store identifies the same states as std::set<StateSch>.
+ */
+class StateSchStore
+{
+public:
+  typedef uint32_t StateId;
+  static constexpr StateId NONE = UINT32_MAX;
+
+private:
+  std::vector<StateSch> states;
+  std::vector<std::size_t> fingerprints;
+  // open addressing table of ids (size is a power of two)
+  std::vector<StateId> table;
+
+  static std::size_t combine(std::size_t h, std::size_t v)
+  {
+    return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+  }
+
+  void rehash()
+  {
+    std::vector<StateId> nw(table.size() * 2, NONE);
+    std::size_t mask = nw.size() - 1;
+    for(StateId id = 0; id < states.size(); id++)
+    {
+      std::size_t pos = fingerprints[id] & mask;
+      while(nw[pos] != NONE)
+        pos = (pos + 1) & mask;
+      nw[pos] = id;
+    }
+    table = std::move(nw);
+  }
+
+  /*
+   * Find the position of a state in the table (either position of the
+   * state or the first empty position)
+   */
+  std::size_t position(const StateSch& st, std::size_t fp) const
+  {
+    std::size_t mask = table.size() - 1;
+    std::size_t pos = fp & mask;
+    while(table[pos] != NONE)
+    {
+      StateId id = table[pos];
+      if(fingerprints[id] == fp && equivalent(states[id], st))
+        return pos;
+      pos = (pos + 1) & mask;
+    }
+    return pos;
+  }
+
+public:
+  StateSchStore() : states(), fingerprints(), table(64, NONE) { }
+
+  /*
+   * Fingerprint of a macrostate (consistent with the equivalence)
+   * @param st Macrostate
+   * @return Hash value
+   */
+  static std::size_t fingerprint(const StateSch& st)
+  {
+    if(!st.tight)
+      return combine(st.S.hash(), 0);
+
+    std::size_t h = combine(st.O.hash(), std::hash<int>()(st.i) + 1);
+    for(const auto& p : st.f)
+    {
+      h = combine(h, std::hash<int>()(p.first));
+      h = combine(h, std::hash<int>()(p.second));
+    }
+    return h;
+  }
+
+  static bool equivalent(const StateSch& st1, const StateSch& st2)
+  {
+    return !(st1 < st2) && !(st2 < st1);
+  }
+
+  /*
+   * Insert a macrostate into the store
+   * @param st Macrostate
+   * @return Pair (id of the macrostate, was the macrostate inserted)
+   */
+  std::pair<StateId, bool> insert(const StateSch& st)
+  {
+    return insert(st, fingerprint(st));
+  }
+
+  /*
+   * Insert a macrostate with a precomputed fingerprint into the store
+   * @param st Macrostate
+   * @param fp Fingerprint of the macrostate
+   * @return Pair (id of the macrostate, was the macrostate inserted)
+   */
+  std::pair<StateId, bool> insert(const StateSch& st, std::size_t fp)
+  {
+    std::size_t pos = position(st, fp);
+    if(table[pos] != NONE)
+      return {table[pos], false};
+
+    StateId id = states.size();
+    states.push_back(st);
+    fingerprints.push_back(fp);
+    table[pos] = id;
+    if(2*states.size() > table.size())
+      rehash();
+    return {id, true};
+  }
+
+  /*
+   * Get id of a macrostate
+   * @param st Macrostate
+   * @return Id of the macrostate (NONE if it is not stored)
+   */
+  StateId find(const StateSch& st) const
+  {
+    return table[position(st, fingerprint(st))];
+  }
+
+  const StateSch& operator[](StateId id) const { return states[id]; }
+  std::size_t size() const { return states.size(); }
+
+  /*
+   * Convert a set of ids to the set of macrostates
+   * @param ids Set of ids
+   * @return Set of macrostates
+   */
+  std::set<StateSch> getStates(const std::set<StateId>& ids) const
+  {
+    std::set<StateSch> ret;
+    for(StateId id : ids)
+      ret.insert(states[id]);
+    return ret;
+  }
+
+  std::set<StateSch> getStates() const
+  {
+    return std::set<StateSch>(states.begin(), states.end());
+  }
+};
+
+
+/*
+ * Store of macrostates shared by several threads. Macrostates are split
+ * into stripes by their fingerprints, each stripe is a StateSchStore with
+ * its own lock, hence threads inserting different macrostates contend only
+ * if the macrostates fall into the same stripe. A macrostate is identified
+ * by its stripe and its id in the stripe.
+ */
+class StripedStateSchStore
+{
+public:
+  typedef StateSchStore::StateId StateId;
+  typedef std::pair<unsigned, StateId> Ref;
+
+private:
+  struct Stripe
+  {
+    std::mutex lock;
+    StateSchStore store;
+
+    Stripe() : lock(), store() { }
+  };
+
+  std::vector<std::unique_ptr<Stripe>> stripes;
+  std::atomic<std::size_t> count;
+
+  unsigned stripeOf(std::size_t fp) const
+  {
+    // the low bits of the fingerprint select the position in the table of
+    // the stripe, the stripe is selected by the mixed high bits
+    uint64_t mix = (uint64_t)fp * 0x9e3779b97f4a7c15ULL;
+    return (mix >> 32) % this->stripes.size();
+  }
+
+public:
+  StripedStateSchStore(unsigned stripeCount) : stripes(), count(0)
+  {
+    for(unsigned i = 0; i < std::max(stripeCount, 1U); i++)
+      this->stripes.push_back(std::unique_ptr<Stripe>(new Stripe()));
+  }
+
+  /*
+   * Insert a macrostate into the store (thread-safe)
+   * @param st Macrostate
+   * @return Pair (reference to the macrostate, was the macrostate inserted)
+   */
+  std::pair<Ref, bool> insert(const StateSch& st)
+  {
+    std::size_t fp = StateSchStore::fingerprint(st);
+    unsigned s = stripeOf(fp);
+    Stripe& stripe = *this->stripes[s];
+    std::pair<StateId, bool> ins;
+    {
+      std::lock_guard<std::mutex> guard(stripe.lock);
+      ins = stripe.store.insert(st, fp);
+    }
+    if(ins.second)
+      this->count++;
+    return {{s, ins.first}, ins.second};
+  }
+
+  std::size_t size() const { return this->count; }
+  unsigned getStripeCount() const { return this->stripes.size(); }
+
+  /*
+   * Get macrostates of a stripe (not synchronized, the store must not be
+   * modified concurrently)
+   */
+  const StateSchStore& getStripe(unsigned s) const { return this->stripes[s]->store; }
+};
+
+#endif
@@ -23,7 +23,17 @@ GeneralizedCoBuchiAutomaton<int, APSymbol> parseRenameHOAGCOBA(BuchiAutomataPars
   return hoa;
 }
 
-BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, ComplOptions opt, InFormat fmt)
+/*
+ * Parse and preprocess a Buchi automaton
+ * @param parser Parser of the input
+ * @param opt Complementation options
+ * @param fmt Input format
+ * @param renAnalysis Analysis of the renamed result (orig.renameAut()) if
+ *        it was computed during the preprocessing, nullptr otherwise
+ * @return Preprocessed automaton
+ */
+BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, ComplOptions opt, InFormat fmt,
+  std::shared_ptr<AutomatonAnalysis>& renAnalysis)
 {
   //BuchiAutomataParser parser(os);
 
@@ -59,16 +69,9 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
     i++;
   }
 
-  if(orig.isSemiDeterministic())
-  {
-    //opt.accPropagation = true;
-    //assume states numbered from 0 (no gaps)
-    //orig.complete(orig.getStates().size());
-  }
-
   if(opt.semideterminize)
   {
-    auto sd = orig.semideterminize();
+    auto sd = orig.semideterminize(opt.threads);
     //cout << sd.toGraphwiz() << endl;
     auto rn = sd.renameStates();
     BuchiAutomaton<int, int> tmp = rn.renameAlphabet(apint);
@@ -77,8 +80,16 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
   }
 
 
+  // analysis of orig (with renamed symbols), it is dropped once orig changes
   BuchiAutomaton<int, int> tmp = orig.renameAlphabet(apint);
-  ElevatorAutomaton elev(tmp);
+  auto analysis = std::make_shared<AutomatonAnalysis>(tmp);
+  // states of orig are 0,...,n-1, i.e., renaming keeps them
+  auto keepsStates = [](const BuchiAutomaton<int, APSymbol>& aut) -> bool
+  {
+    const auto& st = aut.getStates();
+    return st.empty() || (*st.begin() == 0 && *st.rbegin() == (int)st.size() - 1);
+  };
+  bool renamed = keepsStates(orig);
 
   if(opt.preprocess != NONE)
   {
@@ -116,9 +127,9 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
 
     if(opt.preprocess == CPHEUR)
     {
-      map<int,int> ranks = elev.elevatorRank(false);
+      map<int,int> ranks = analysis->elevatorRank(false);
       int m = Aux::maxValue(ranks);
-      bool isElev = elev.isElevator() && !elev.isInherentlyWeakBA();
+      bool isElev = analysis->isElevator() && !analysis->isInherentlyWeakBA();
 
       auto predheur = [&isAcc, m, isElev] (SccClassif c) -> bool
       {
@@ -126,12 +137,12 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
           return isAcc(c);
         return false;
       };
-      tmp = elev.copyPreprocessing(predheur);
+      tmp = analysis->copyPreprocessing(predheur);
 
       if(isElev)
       {
-        ElevatorAutomaton elevPost(tmp);
-        tmp = elevPost.nondetInitDeterminize();
+        AutomatonAnalysis post(tmp);
+        tmp = post.nondetInitDeterminize();
 
         Simulations sim;
         auto ranksim = sim.directSimulation<int, int>(tmp, -1);
@@ -149,22 +160,23 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
     }
     else if(opt.preprocess == CPIWA)
     {
-      tmp = elev.copyPreprocessing(prediwa);
+      tmp = analysis->copyPreprocessing(prediwa);
     }
     else if(opt.preprocess == CPDET)
     {
-      tmp = elev.copyPreprocessing(preddet);
+      tmp = analysis->copyPreprocessing(preddet);
     }
     else if(opt.preprocess == CPALL)
     {
-      tmp = elev.copyPreprocessing(predall);
+      tmp = analysis->copyPreprocessing(predall);
     }
     else if(opt.preprocess == CPTRIVIAL)
     {
-      tmp = elev.copyPreprocessing(predtri);
+      tmp = analysis->copyPreprocessing(predtri);
     }
 
     orig = tmp.renameAlphabet(intap);
+    analysis = nullptr;
 
     //cout << orig.toHOA() << endl;
   }
@@ -180,10 +192,14 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
       intap[i] = s;
       i++;
     }
-    BuchiAutomaton<int, int> tmp = orig.renameAlphabet(apint);
-    ElevatorAutomaton elev(tmp);
-    tmp = elev.propagateAccStates();
+    if(!analysis)
+    {
+      BuchiAutomaton<int, int> tmp = orig.renameAlphabet(apint);
+      analysis = std::make_shared<AutomatonAnalysis>(tmp);
+    }
+    BuchiAutomaton<int, int> tmp = analysis->propagateAccStates();
     orig = tmp.renameAlphabet(intap);
+    analysis = nullptr;
     //std::cerr << tmp.toGraphwiz() << std::endl;
   }
 
@@ -196,15 +212,21 @@ BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, Comp
     if (orig.isTBA())
       tba = orig;
     ///
-    auto renTba = tba.renameAut();
-    ElevatorAutomaton el(renTba);
-
-    if(tba.getStates().size() < orig.getStates().size() && (tba.isSemiDeterministic() || el.isInherentlyWeakBA()))
+    if(tba.getStates().size() < orig.getStates().size())
     {
-      orig = tba;
+      auto renTba = tba.renameAut();
+      auto tbaAnalysis = std::make_shared<AutomatonAnalysis>(renTba);
+      if(tbaAnalysis->isSemiDeterministic() || tbaAnalysis->isInherentlyWeakBA())
+      {
+        orig = tba;
+        analysis = tbaAnalysis;
+        renamed = true;
+      }
     }
   }
 
+  renAnalysis = renamed ? analysis : nullptr;
+
   //std::cerr << orig.getFinTrans().size() << std::endl;
   return orig;
 }
@@ -232,9 +254,7 @@ void complementAutWrap(BuchiAutomatonSpec& sp, BuchiAutomaton<int, int>* ren,
     //map<int, int> id;
     //for(auto al : comp.getAlphabet())
     //  id[al] = al;
-    BuchiAutomaton<int, int> renCompl = comp.renameAutDict(id);
-    renCompl.removeUseless();
-    renCompl = renCompl.renameAutDict(id);
+    BuchiAutomaton<int, int> renCompl = comp.removeUselessRename(id);
 
     stats->reachStates = renCompl.getStates().size();
     stats->reachTrans = renCompl.getTransCount();
@@ -246,13 +266,13 @@ void complementAutWrap(BuchiAutomatonSpec& sp, BuchiAutomaton<int, int>* ren,
     *complRes = renCompl;
 }
 
-void complementGcoBAWrap(GeneralizedCoBuchiAutomaton<int, int> *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats)
+void complementGcoBAWrap(GeneralizedCoBuchiAutomaton<int, int> *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats, unsigned threads)
 {
   //ren->removeUseless();
   //std::cerr << ren->toGraphwiz() << std::endl;
   GeneralizedCoBuchiAutomatonCompl sp(ren);
 
-  *complOrig = sp.complementGcoBA();
+  *complOrig = sp.complementGcoBA(threads);
 
   stats->generatedStates = complOrig->getStates().size();
   stats->generatedTrans = complOrig->getTransCount();
@@ -261,9 +281,7 @@ void complementGcoBAWrap(GeneralizedCoBuchiAutomaton<int, int> *ren, BuchiAutoma
   for(auto al : complOrig->getAlphabet())
     id[al] = al;
   //std::cerr << complOrig->toString() << std::endl;
-  BuchiAutomaton<int, int> renCompl = complOrig->renameAutDict(id);
-  renCompl.removeUseless();
-  renCompl = renCompl.renameAutDict(id);
+  BuchiAutomaton<int, int> renCompl = complOrig->removeUselessRename(id);
 
   stats->reachStates = renCompl.getStates().size();
   stats->reachTrans = renCompl.getTransCount();
@@ -275,22 +293,24 @@ void complementGcoBAWrap(GeneralizedCoBuchiAutomaton<int, int> *ren, BuchiAutoma
 
 void complementCoBAWrap(CoBuchiAutomatonCompl *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats, ComplOptions opt)
 {
-  auto pure = ren->complementCoBA();
+  if(opt.portfolio && !opt.iwOrigOnly && !opt.iwPruneOnly && !opt.light)
+  {
+    complementCoBAPortfolio(ren, complOrig, complRes, stats, opt);
+    return;
+  }
+
+  auto pure = ren->complementCoBA(opt.threads);
   auto complSim = ren->complementCoBASim(opt);
 
   map<int, int> id;
   for(auto al : pure.getAlphabet())
     id[al] = al;
 
-  BuchiAutomaton<int, int> renSim = complSim.renameAutDict(id);
-  renSim.removeUseless();
-  renSim = renSim.renameAutDict(id);
+  BuchiAutomaton<int, int> renSim = complSim.removeUselessRename(id);
 
   if(opt.iwOrigOnly)
   {
-    BuchiAutomaton<int, int> renPure = pure.renameAutDict(id);
-    renPure.removeUseless();
-    renPure = renPure.renameAutDict(id);
+    BuchiAutomaton<int, int> renPure = pure.removeUselessRename(id);
     *complOrig = pure;
     *complRes = renPure;
   }
@@ -303,9 +323,7 @@ void complementCoBAWrap(CoBuchiAutomatonCompl *ren, BuchiAutomaton<StateGcoBA, i
   {
     if(!opt.light)
     {
-      BuchiAutomaton<int, int> renPure = pure.renameAutDict(id);
-      renPure.removeUseless();
-      renPure = renPure.renameAutDict(id);
+      BuchiAutomaton<int, int> renPure = pure.removeUselessRename(id);
 
       if(renSim.getStates().size() > renPure.getStates().size())
       {
@@ -335,32 +353,83 @@ void complementCoBAWrap(CoBuchiAutomatonCompl *ren, BuchiAutomaton<StateGcoBA, i
   stats->originalStates = ren->getStates().size();
 }
 
-void complementSDWrap(SemiDeterministicCompl& sp, BuchiAutomaton<int, int>* ren, BuchiAutomaton<int, int>* complRes, Stat* stats, ComplOptions opt)
+/*
+ * Complementation of an inherently weak automaton: the original and the
+ * simulation-pruned constructions run concurrently in a portfolio and the
+ * smaller result is kept (the same choice as in complementCoBAWrap).
+ */
+void complementCoBAPortfolio(CoBuchiAutomatonCompl *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats, ComplOptions opt)
 {
-  BuchiAutomaton<StateSD, int> compOrig;
-  BuchiAutomaton<StateSD, int> compLazy;
+  BuchiAutomaton<StateGcoBA, int> pure;
+  BuchiAutomaton<StateGcoBA, int> complSim;
+  BuchiAutomaton<int, int> renPure;
+  BuchiAutomaton<int, int> renSim;
+
+  map<int, int> id;
+  for(auto al : ren->getAlphabet())
+    id[al] = al;
+
+  // each candidate works on its own copy of the automaton
+  CoBuchiAutomatonCompl renCopy(*ren);
+  ComplPortfolio portfolio;
+  unsigned pureInd = portfolio.add([&]() {
+    pure = renCopy.complementCoBA(opt.threads);
+    renPure = pure.removeUselessRename(id);
+    return renPure.getStates().size();
+  });
+  unsigned simInd = portfolio.add([&]() {
+    complSim = ren->complementCoBASim(opt);
+    renSim = complSim.removeUselessRename(id);
+    return renSim.getStates().size();
+  });
+  portfolio.run();
+
+  if(portfolio.isFinished(simInd) && (!portfolio.isFinished(pureInd) ||
+    portfolio.getSize(simInd) <= portfolio.getSize(pureInd)))
+  {
+    *complOrig = complSim;
+    *complRes = renSim;
+  }
+  else
+  {
+    *complOrig = pure;
+    *complRes = renPure;
+  }
 
-  ComplOptions optP = opt;
-  optP.ncsbLazy = false;
-  compOrig = sp.complementSD(optP);
+  stats->generatedStates = complOrig->getStates().size();
+  stats->generatedTrans = complOrig->getTransCount();
 
+  stats->reachStates = complRes->getStates().size();
+  stats->reachTrans = complRes->getTransCount();
+  stats->engine = "Ranker";
+  stats->transitionsToTight = -1;
+  stats->originalStates = ren->getStates().size();
+}
 
+void complementSDWrap(SemiDeterministicCompl& sp, BuchiAutomaton<int, int>* ren, BuchiAutomaton<int, int>* complRes, Stat* stats, ComplOptions opt)
+{
+  // both variants share macrostates and parts of successors
+  bool lazy = opt.ncsbLazy || opt.sdLazyOnly;
+  auto comps = sp.complementSDVariants(!opt.sdLazyOnly, lazy);
+  BuchiAutomaton<StateSD, int>& compOrig = comps[SD_MAXRANK];
+  BuchiAutomaton<StateSD, int>& compLazy = comps[SD_LAZY];
 
   map<int, int> id;
   for(auto al : ren->getAlphabet())
     id[al] = al;
 
   //Simulations sim;
-  BuchiAutomaton<int, int> renComplOrig = compOrig.renameAutDict(id);
-  renComplOrig = renComplOrig.removeUselessRename();
+  BuchiAutomaton<int, int> renComplOrig;
+  if(!opt.sdLazyOnly)
+  {
+    renComplOrig = compOrig.removeUselessRename(id);
+  }
 
   BuchiAutomaton<int, int> renComplLazy;
-  if(opt.ncsbLazy || opt.sdLazyOnly)
+  if(lazy)
   {
     opt.ncsbLazy = true;
-    compLazy = sp.complementSD(opt);
-    renComplLazy = compLazy.renameAutDict(id);
-    renComplLazy = renComplLazy.removeUselessRename();
+    renComplLazy = compLazy.removeUselessRename(id);
   }
 
   stats->generatedTransitionsToTight = 0;
@@ -446,6 +515,11 @@ void printStat(Stat& st)
   cerr << "States-before-complementation: " << st.originalStates << endl;
   //cerr << "Elevator-states: " << st.elevatorStates << endl;
   cerr << "Engine: " << st.engine << endl;
+  if(st.rankCacheHits + st.rankCacheMisses > 0)
+  {
+    cerr << "Rank-cache-hits: " << st.rankCacheHits << "\nRank-cache-misses: " << st.rankCacheMisses << endl;
+    cerr << "Rank-cache-evictions: " << st.rankCacheEvictions << endl;
+  }
   cerr << std::fixed;
   cerr << std::setprecision(2);
 
@@ -24,6 +24,7 @@
 #include "Complement/GenCoBuchiAutomatonCompl.h"
 #include "Complement/CoBuchiCompl.h"
 #include "Complement/SemiDeterministicCompl.h"
+#include "Complement/ComplPortfolio.h"
 
 using namespace std;
 
@@ -52,14 +53,16 @@ void printStat(Stat& st);
 
 BuchiAutomaton<int, int> createBA(vector<int>& loop);
 
-void complementGcoBAWrap(GeneralizedCoBuchiAutomaton<int, int> *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats);
+void complementGcoBAWrap(GeneralizedCoBuchiAutomaton<int, int> *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats, unsigned threads = 1);
 void complementCoBAWrap(CoBuchiAutomatonCompl *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats, ComplOptions opt);
+void complementCoBAPortfolio(CoBuchiAutomatonCompl *ren, BuchiAutomaton<StateGcoBA, int> *complOrig, BuchiAutomaton<int, int>* complRes, Stat* stats, ComplOptions opt);
 
 void complementSDWrap(SemiDeterministicCompl& sp ,BuchiAutomaton<int, int>* ren, BuchiAutomaton<int, int>* complRes,
     Stat* stats, ComplOptions opt);
 
 GeneralizedCoBuchiAutomaton<int, APSymbol> parseRenameHOAGCOBA(BuchiAutomataParser& parser);
-BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, ComplOptions opt, InFormat fmt);
+BuchiAutomaton<int, APSymbol> parseRenameHOABA(BuchiAutomataParser& parser, ComplOptions opt, InFormat fmt,
+  std::shared_ptr<AutomatonAnalysis>& renAnalysis);
 
 
 #endif
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <limits>
 #include <stdio.h>
 #include "External/args.hxx" // argument parsing
 
@@ -28,6 +29,20 @@ const string tmpFile = "__tmp__ranker_639652108";
 
 using namespace std;
 
+/*
+ * Parse a nonnegative integer argument
+ * @param v Argument
+ * @param out Out parameter for the value
+ * @return Is the argument a (not too large) number
+ */
+static bool parseUnsigned(const string& v, unsigned& out)
+{
+  if(v.empty() || v.size() > 9 || !std::all_of(v.begin(), v.end(), ::isdigit))
+    return false;
+  out = std::stoul(v);
+  return true;
+}
+
 int main(int argc, char *argv[])
 {
   Params params = { .output = "", .input = "", .tmpFile = false, .stats = false, .checkWord = ""};
@@ -41,7 +56,7 @@ int main(int argc, char *argv[])
 
   args::Positional<std::string> inputFile(parser, "INPUT", "The name of a file in the HOA (Hanoi Omega Automata) or the BA format. If the file is not provided, the automaton is taken from the standard input.\n");
   args::Flag statsFlag(parser, "", "Print summary statistics", {"stats"});
-  args::ValueFlag<std::string> delayFlag(parser, "version", "Use delay optimization, versions: old, new, random, subset, stirling", {"delay"});
+  args::ValueFlag<std::string> delayFlag(parser, "version", "Use delay optimization, versions: old, new, random, subset, stirling, fvs (fvs does not enumerate cycles, it approximates the cycles through a state by its in/out-degree)", {"delay"});
   args::ValueFlag<std::string> checkFlag(parser, "word", "Product of the result with a given word", {"check"});
   args::ValueFlag<std::string> dataFlowFlag(parser, "dataflow", "Data flow analysis [light/inner]", {"flow"});
   args::ValueFlag<double> weightFlag(parser, "value", "Weight parameter for delay - value in <0,1>", {'w', "weight"});
@@ -61,15 +76,20 @@ int main(int argc, char *argv[])
   args::Flag tbaFlag(parser, "no-tba", "Do NOT use TBA preprocessing", {"no-tba"});
   args::Flag bestFlag(parser, "best", "Use the settings leading to smallest possible automata", {"best"});
   args::Flag slFlag(parser, "sl", "Use self-loop waiting optimization", {"sl"});
+  args::Flag postredFlag(parser, "postred", "Reduce the result by bisimulation and direct simulation", {"postred"});
+  args::ValueFlag<std::string> postredSimMaxFlag(parser, "value", "Maximum number of states of the bisimulation quotient reduced by direct simulation with --postred (default 2000)", {"postred-sim-max"});
 
   args::Flag iwOrigOnlyFlag(parser, "iw-orig-only", "Use original IW procedure only", {"iw-orig-only"});
   args::Flag iwPruneOnlyFlag(parser, "iw-prune-only", "Use pruning optimization in IW complementation", {"iw-prune-only"});
 
   args::Flag sdLazyOnlyFlag(parser, "sd-ncsb-lazy-only", "Use NCSB-Lazy procedure only", {"sd-ncsb-lazy-only"});
   args::Flag sdMaxrankOnlyFlag(parser, "sd-ncsb-maxrank-only", "Use NCSB-MaxRank procedure only", {"sd-ncsb-maxrank-only"});
+  args::Flag portfolioFlag(parser, "portfolio", "Run alternative procedures concurrently, stop those exceeding the best result (faster, the result may be larger)", {"portfolio"});
+  args::ValueFlag<std::string> threadsFlag(parser, "value", "Number of threads for the macrostate constructions (waiting and tight part, IW, GcoBA, semideterminization)", {"threads"});
+  args::ValueFlag<std::string> rankSimMaxFlag(parser, "value", "Maximum size of macrostates whose rank bound is refined by the odd rank simulation (exponential in the size, default 12 for automata with at least 20 states, unlimited otherwise)", {"ranksim-max"});
 
   ComplOptions opt = { .cutPoint = true, .succEmptyCheck = false, .ROMinState = 8,
-      .ROMinRank = 6, .CacheMaxState = 6, .CacheMaxRank = 8, .semidetOpt = false,
+      .ROMinRank = 6, .semidetOpt = false,
       .dataFlow = INNER, .delay = false, .delayVersion = oldVersion, .delayW = 0.5,
       .debug = false, .elevator = { .elevatorRank = true, .detBeginning = false },
       .dirsim = true, .ranksim = true, .sl = true, .reach = true, .flowDirSim = false, .preprocess = CPHEUR, .accPropagation = false,
@@ -218,6 +238,45 @@ int main(int argc, char *argv[])
     opt.sdLazyOnly = true;
   }
 
+  if(portfolioFlag)
+  {
+    opt.portfolio = true;
+  }
+
+  if(postredFlag)
+  {
+    opt.postred = true;
+  }
+
+  if(postredSimMaxFlag)
+  {
+    if(!parseUnsigned(args::get(postredSimMaxFlag), opt.postredSimMaxStates))
+    {
+      std::cerr << "Wrong maximum number of states for post-reduction" << std::endl;
+      return 1;
+    }
+  }
+
+  if(threadsFlag)
+  {
+    unsigned t = 0;
+    if(!parseUnsigned(args::get(threadsFlag), t) || t == 0)
+    {
+      std::cerr << "Wrong number of threads" << std::endl;
+      return 1;
+    }
+    opt.threads = t;
+  }
+
+  if(rankSimMaxFlag)
+  {
+    if(!parseUnsigned(args::get(rankSimMaxFlag), opt.rankSimMaxMacro))
+    {
+      std::cerr << "Wrong maximum size of macrostates" << std::endl;
+      return 1;
+    }
+  }
+
   // delay version
   if (delayFlag){
     opt.delay = true;
@@ -232,6 +291,8 @@ int main(int argc, char *argv[])
       opt.delayVersion = subsetVersion;
     else if (v == "stirling")
       opt.delayVersion = stirlingVersion;
+    else if (v == "fvs")
+      opt.delayVersion = fvsVersion;
     else {
       std::cerr << "Wrong delay version" << std::endl;
       return 1;
@@ -318,21 +379,14 @@ int main(int argc, char *argv[])
     {
       if(autType == AUTBA)
       {
-        BuchiAutomaton<int, APSymbol> orig = parseRenameHOABA(parser, opt, fmt);
+        std::shared_ptr<AutomatonAnalysis> analysis;
+        BuchiAutomaton<int, APSymbol> orig = parseRenameHOABA(parser, opt, fmt, analysis);
 
         if(orig.isTBA())
         {
           opt.ranksim = false;
         }
 
-        if(orig.getStates().size() >= 20)
-        {
-          opt.reach = false;
-          opt.dirsim = false;
-          opt.ranksim = false;
-          opt.sl = false;
-        }
-
         if(slFlag || fmt == BA)
         {
           opt.sl = true;
@@ -364,19 +418,28 @@ int main(int argc, char *argv[])
 
         renBuchi = orig.renameAut();
 
-        ElevatorAutomaton el(renBuchi);
+        // small automata have the rank bound refined in all macrostates
+        if(!rankSimMaxFlag && renBuchi.getStates().size() < opt.rankSimMaxStates)
+        {
+          opt.rankSimMaxMacro = std::numeric_limits<unsigned>::max();
+        }
+
+        // structural facts shared by all phases below (the analysis of the
+        // preprocessing is reused if it describes the same automaton)
+        if(!analysis)
+          analysis = std::make_shared<AutomatonAnalysis>(renBuchi);
         if (elevatorTest){
-          cout << "Elevator automaton: " << (el.isElevator() ? "Yes" : "No") << endl;
-          cout << "Elevator states: " << el.elevatorStates() << endl;
+          cout << "Elevator automaton: " << (analysis->isElevator() ? "Yes" : "No") << endl;
+          cout << "Elevator states: " << analysis->elevatorStates() << endl;
           os.close();
           if (params.tmpFile) std::remove(params.input.c_str());
           return 0;
         }
 
-        map<int,int> ranks = el.elevatorRank(false);
+        map<int,int> ranks = analysis->elevatorRank(false);
         int m = Aux::maxValue(ranks);
 
-        if(renBuchi.isDeterministic())
+        if(analysis->isDeterministic())
         {
           opt.reach = false;
           opt.sl = false;
@@ -392,15 +455,15 @@ int main(int argc, char *argv[])
           opt.sl = false;
         }
 
-        if(renBuchi.isComplete())
+        if(analysis->isComplete())
         {
           opt.complete = true;
         }
 
-        BuchiAutomatonSpec sp(&renBuchi);
+        BuchiAutomatonSpec sp(&renBuchi, analysis);
         sp.setComplOptions(opt);
 
-        if(opt.backoff && !el.isInherentlyWeakBA())
+        if(opt.backoff && !analysis->isInherentlyWeakBA())
         {
           BuchiAutomaton<StateSch, int> comp = sp.complementSchNFA(sp.getInitials());
           sp.computeRankBound(comp, &stats);
@@ -450,19 +513,48 @@ int main(int argc, char *argv[])
 
         sp.setComplOptions(opt);
 
-        if(el.isInherentlyWeakBA())
+        if(analysis->isInherentlyWeakBA())
         {
-          CoBuchiAutomatonCompl iw(el);
+          BuchiAutomaton<int, int> weak(renBuchi);
+          CoBuchiAutomatonCompl iw(weak, analysis);
           complementCoBAWrap(&iw, &compGcoBA, &renCompl, &stats, opt);
         }
-        else if (el.isSemiDeterministic())
+        else if (analysis->isSemiDeterministic())
         {
-          SemiDeterministicCompl sd(&renBuchi);
+          SemiDeterministicCompl sd(&renBuchi, analysis);
           BuchiAutomaton<int, int> renComplSD;
-          complementSDWrap(sd, &renBuchi, &renComplSD, &stats, opt);
 
-          if(!opt.light && !opt.sdLazyOnly && !opt.sdMaxrankOnly)
+          if(opt.portfolio && !opt.light && !opt.sdLazyOnly && !opt.sdMaxrankOnly)
           {
+            // both procedures run concurrently, the smaller result is kept
+            Stat sdStats = stats;
+            Stat autStats = stats;
+            ComplPortfolio portfolio;
+            unsigned sdInd = portfolio.add([&]() {
+              complementSDWrap(sd, &renBuchi, &renComplSD, &sdStats, opt);
+              return renComplSD.getStates().size();
+            });
+            unsigned autInd = portfolio.add([&]() {
+              complementAutWrap(sp, &renBuchi, &compBA, &renCompl, &autStats, !opt.backoff);
+              return renCompl.getStates().size();
+            });
+            portfolio.run();
+
+            if(portfolio.isFinished(sdInd) && (!portfolio.isFinished(autInd) ||
+              portfolio.getSize(sdInd) <= portfolio.getSize(autInd)))
+            {
+              stats = sdStats;
+              renCompl = renComplSD;
+            }
+            else
+            {
+              stats = autStats;
+            }
+          }
+          else if(!opt.light && !opt.sdLazyOnly && !opt.sdMaxrankOnly)
+          {
+            complementSDWrap(sd, &renBuchi, &renComplSD, &stats, opt);
+
             Stat s1 = stats;
 
             complementAutWrap(sp, &renBuchi, &compBA, &renCompl, &stats, !opt.backoff);
@@ -475,6 +567,7 @@ int main(int argc, char *argv[])
           }
           else
           {
+            complementSDWrap(sd, &renBuchi, &renComplSD, &stats, opt);
             renCompl = renComplSD;
           }
         }
@@ -490,7 +583,7 @@ int main(int argc, char *argv[])
       {
         GeneralizedCoBuchiAutomaton<int, APSymbol> orig = parseRenameHOAGCOBA(parser);
         renGcoBA = orig.renameAut();
-        complementGcoBAWrap(&renGcoBA, &compGcoBA, &renCompl, &stats);
+        complementGcoBAWrap(&renGcoBA, &compGcoBA, &renCompl, &stats, opt.threads);
         symDict = Aux::reverseMap(orig.getRenameSymbolMap());
       }
       if (autType != AUTBA and autType != AUTGCOBA){
@@ -546,9 +639,14 @@ int main(int argc, char *argv[])
     if(opt.postred)
     {
       Simulations sim;
-      auto dirsim = sim.directSimulation<int, int>(renCompl, -1);
-      renCompl.setDirectSim(dirsim);
-      renCompl = renCompl.reduce();
+      // bisimulation first, the direct simulation only on small quotients
+      renCompl = renCompl.quotient(sim.bisimulationClasses(renCompl));
+      if(renCompl.getStates().size() <= opt.postredSimMaxStates)
+      {
+        auto dirsim = sim.directSimulation<int, int>(renCompl, -1);
+        renCompl.setDirectSim(dirsim);
+        renCompl = renCompl.reduce();
+      }
     }
 
     BuchiAutomaton<int, APSymbol> outOrig = renCompl.renameAlphabet<APSymbol>(symDict);
@@ -0,0 +1,21 @@
+# Compare the complements produced by the sequential and the parallel
+# construction of the tight part (they have to be identical)
+#
+#   cmake -DRANKER=<ranker> -DINPUT=<automaton> [-DFLAGS=<flags>] -P compare-threads.cmake
+
+separate_arguments(FLAGS)
+
+foreach(threads 1 4)
+  execute_process(
+    COMMAND ${RANKER} ${FLAGS} --threads=${threads} ${INPUT}
+    OUTPUT_VARIABLE out_${threads}
+    RESULT_VARIABLE res_${threads}
+  )
+  if(NOT res_${threads} EQUAL 0)
+    message(FATAL_ERROR "ranker --threads=${threads} failed on ${INPUT}")
+  endif()
+endforeach()
+
+if(NOT out_1 STREQUAL out_4)
+  message(FATAL_ERROR "Outputs for --threads=1 and --threads=4 differ on ${INPUT}:\n${out_1}\n----\n${out_4}")
+endif()
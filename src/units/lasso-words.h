@@ -0,0 +1,90 @@
+#ifndef _LASSO_WORDS_H_
+#define _LASSO_WORDS_H_
+
+#include <set>
+#include <vector>
+#include <tuple>
+
+#include "../Automata/BuchiAutomaton.h"
+
+/*
+ * Does the automaton accept the word prefix.loop^omega (a reachable
+ * transition of the product with the lasso lies on a cycle and leaves an
+ * accepting state or is accepting)
+ */
+inline bool acceptsLasso(BuchiAutomaton<int, int>& aut, const std::vector<int>& prefix, const std::vector<int>& loop)
+{
+  typedef std::pair<int, int> ProdState;
+  std::vector<int> word(prefix);
+  word.insert(word.end(), loop.begin(), loop.end());
+  int len = word.size();
+  auto next = [&](int i) { return i + 1 < len ? i + 1 : (int)prefix.size(); };
+  auto tr = aut.getTransitions();
+  std::set<int> fin = aut.getFinals();
+  std::set<std::tuple<int, int, int>> accTrans;
+  for(const auto& t : aut.getFinTrans())
+    accTrans.insert({t.from, t.symbol, t.to});
+
+  auto post = [&](const ProdState& st)
+  {
+    std::set<ProdState> ret;
+    for(int d : tr[{st.first, word[st.second]}])
+      ret.insert({d, next(st.second)});
+    return ret;
+  };
+  auto reach = [&](const std::set<ProdState>& from)
+  {
+    std::set<ProdState> visited;
+    std::vector<ProdState> stack(from.begin(), from.end());
+    while(!stack.empty())
+    {
+      ProdState st = stack.back();
+      stack.pop_back();
+      if(!visited.insert(st).second)
+        continue;
+      for(const auto& d : post(st))
+        stack.push_back(d);
+    }
+    return visited;
+  };
+
+  std::set<ProdState> ini;
+  for(int q : aut.getInitials())
+    ini.insert({q, 0});
+  for(const ProdState& st : reach(ini))
+  {
+    bool accState = fin.find(st.first) != fin.end();
+    for(const ProdState& d : post(st))
+    {
+      if(!accState && accTrans.find({st.first, word[st.second], d.first}) == accTrans.end())
+        continue;
+      if(reach({d}).count(st) > 0)
+        return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * All words over the alphabet of the given length
+ */
+inline std::vector<std::vector<int>> allWords(const std::set<int>& alph, unsigned len)
+{
+  std::vector<std::vector<int>> ret = {{}};
+  for(unsigned i = 0; i < len; i++)
+  {
+    std::vector<std::vector<int>> ext;
+    for(const auto& w : ret)
+    {
+      for(int a : alph)
+      {
+        ext.push_back(w);
+        ext.back().push_back(a);
+      }
+    }
+    ret = ext;
+  }
+  return ret;
+}
+
+#endif
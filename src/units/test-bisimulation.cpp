@@ -0,0 +1,175 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <vector>
+#include <tuple>
+#include <fstream>
+#include <random>
+
+#include "../Automata/BuchiAutomaton.h"
+#include "../Algorithms/Simulations.h"
+#include "../Automata/BuchiAutomataParser.h"
+#include "lasso-words.h"
+#include "test-utils.h"
+
+using namespace std;
+
+/*
+ * Bisimulation classes by a naive fixpoint (all signatures are recomputed in
+ * each round), numbered by the least states
+ */
+map<int, int> naiveClasses(BuchiAutomaton<int, int>& ba)
+{
+  set<tuple<int, int, int>> acc;
+  for(const auto& tr : ba.getFinTrans())
+    acc.insert({tr.from, tr.symbol, tr.to});
+  auto trans = ba.getTransitions();
+
+  map<int, int> block;
+  for(int st : ba.getStates())
+    block[st] = ba.getFinals().count(st) > 0 ? 1 : 0;
+  unsigned blocks = 0;
+  while(true)
+  {
+    map<pair<int, set<tuple<int, bool, int>>>, int> ids;
+    map<int, int> next;
+    for(int st : ba.getStates())
+    {
+      set<tuple<int, bool, int>> sig;
+      for(int sym : ba.getAlphabet())
+      {
+        for(int d : trans[{st, sym}])
+          sig.insert({sym, acc.count({st, sym, d}) > 0, block[d]});
+      }
+      next[st] = ids.insert({{block[st], sig}, (int)ids.size()}).first->second;
+    }
+    block = next;
+    if(ids.size() == blocks)
+      break;
+    blocks = ids.size();
+  }
+
+  map<int, int> ret;
+  map<int, int> clsId;
+  for(int st : ba.getStates())
+    ret[st] = clsId.insert({block[st], clsId.size()}).first->second;
+  return ret;
+}
+
+/*
+ * Automaton made of copies of a base automaton (copies of a state go to
+ * copies of its successors); some transitions of copies are dropped, hence
+ * only some copies are bisimilar
+ */
+BuchiAutomaton<int, int> randomCopies(std::mt19937& gen, BuchiAutomaton<int, int>& base, unsigned copies)
+{
+  std::uniform_real_distribution<double> prob(0.0, 1.0);
+  std::uniform_int_distribution<unsigned> copy(0, copies - 1);
+  set<int> states, fins, ini = {0};
+  BuchiAutomaton<int, int>::Transitions trans;
+  BuchiAutomaton<int, int>::VecTransG accTrans;
+  set<tuple<int, int, int>> baseAcc;
+  for(const auto& tr : base.getFinTrans())
+    baseAcc.insert({tr.from, tr.symbol, tr.to});
+
+  for(int i : base.getStates())
+  {
+    for(unsigned c = 0; c < copies; c++)
+    {
+      states.insert(i*copies + c);
+      if(base.getFinals().count(i) > 0)
+        fins.insert(i*copies + c);
+    }
+  }
+  for(const auto& tr : base.getTransitions())
+  {
+    int i = tr.first.first;
+    int a = tr.first.second;
+    for(int j : tr.second)
+    {
+      bool acc = baseAcc.count({i, a, j}) > 0;
+      for(unsigned c = 0; c < copies; c++)
+      {
+        if(prob(gen) < 0.1)
+          continue;
+        set<int> dst = {(int)(j*copies + copy(gen))};
+        if(prob(gen) < 0.5)
+          dst.insert(j*copies + copy(gen));
+        for(int d : dst)
+        {
+          int src = i*copies + c;
+          trans[{src, a}].insert(d);
+          if(acc)
+            accTrans.push_back({.from = src, .to = d, .symbol = a});
+        }
+      }
+    }
+  }
+  return BuchiAutomaton<int, int>(states, fins, ini, trans, accTrans, base.getAlphabet());
+}
+
+/*
+ * Check the classes against the naive bisimulation and the language of the
+ * quotient on lasso words
+ */
+bool checkAut(BuchiAutomaton<int, int>& ba)
+{
+  Simulations sim;
+  map<int, int> cls = sim.bisimulationClasses(ba);
+  if(cls != naiveClasses(ba))
+    return false;
+
+  BuchiAutomaton<int, int> quot = ba.quotient(cls);
+  set<int> alph = ba.getAlphabet();
+  for(unsigned i = 0; i <= 2; i++)
+  {
+    for(const auto& prefix : allWords(alph, i))
+    {
+      for(unsigned j = 1; j <= 3; j++)
+      {
+        for(const auto& loop : allWords(alph, j))
+        {
+          if(acceptsLasso(ba, prefix, loop) != acceptsLasso(quot, prefix, loop))
+            return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  bool res = true;
+  cout << std::boolalpha;
+  for(int i = 1; i < argc; i++)
+  {
+    ifstream os(argv[i]);
+    if(!os)
+    {
+      cerr << "Opening file error" << endl;
+      return 1;
+    }
+    BuchiAutomataParser parser(os);
+    BuchiAutomaton<string, string> ba = parser.parseBaFormat();
+    BuchiAutomaton<int, int> ren = ba.renameAut();
+    bool ok = checkAut(ren);
+    cout << argv[i] << ": " << ok << endl;
+    res &= ok;
+  }
+
+  unsigned reduced = 0;
+  bool ok = checkRandom(300, [&reduced](std::mt19937& gen, unsigned i)
+  {
+    auto base = randomAut<BuchiAutomaton<int, int>>(gen, 1 + i % 6, 2, {0.35, 0.3, 0.2});
+    BuchiAutomaton<int, int> ba = randomCopies(gen, base, 1 + i % 4);
+    Simulations sim;
+    map<int, int> cls = sim.bisimulationClasses(ba);
+    if(Aux::maxValue(cls) + 1 < (int)ba.getStates().size())
+      reduced++;
+    return checkAut(ba);
+  });
+  cout << "Random automata (" << reduced << " reduced): " << ok << endl;
+  res &= ok;
+  return res ? 0 : 1;
+}
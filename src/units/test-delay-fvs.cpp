@@ -0,0 +1,106 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <vector>
+#include <fstream>
+#include <memory>
+
+#include "../Automata/BuchiAutomaton.h"
+#include "../Algorithms/Simulations.h"
+#include "../Complement/BuchiAutomatonSpec.h"
+#include "../Complement/AutomatonAnalysis.h"
+#include "../Automata/BuchiAutomataParser.h"
+#include "../Complement/Options.h"
+#include "lasso-words.h"
+
+using namespace std;
+
+/*
+ * Complement the automaton by the Schewe construction with the given delay
+ * settings
+ */
+BuchiAutomaton<int, int> complement(BuchiAutomaton<int, int>& ren, bool delay, DelayVersion version)
+{
+  ComplOptions opt;
+  opt.cutPoint = true;
+  opt.ROMinState = 8;
+  opt.ROMinRank = 6;
+  if(delay)
+  {
+    opt.delay = true;
+    opt.delayVersion = version;
+    opt.sl = false;
+    opt.reach = false;
+    opt.elevator.elevatorRank = true;
+    opt.dataFlow = LIGHT;
+  }
+
+  auto analysis = std::make_shared<AutomatonAnalysis>(ren);
+  BuchiAutomatonSpec sp(&ren, analysis);
+  sp.setComplOptions(opt);
+  Stat stats;
+  BuchiAutomaton<StateSch, int> comp = sp.complementSchReduced(&stats);
+
+  map<int, int> id;
+  for(int al : ren.getAlphabet())
+    id[al] = al;
+  return comp.removeUselessRename(id);
+}
+
+int main(int argc, char *argv[])
+{
+  ifstream os;
+
+  if(argc != 2)
+  {
+    cerr << "Bad arguments" << endl;
+    return 1;
+  }
+  os.open(argv[1]);
+  if(!os)
+  {
+    cerr << "Opening file error" << endl;
+    return 1;
+  }
+  cout << argv[1] << endl;
+
+  BuchiAutomataParser parser(os);
+  BuchiAutomaton<string, string> ba = parser.parseBaFormat();
+  os.close();
+  BuchiAutomaton<int, int> ren = ba.renameAut();
+
+  Simulations sim;
+  ren.setDirectSim(sim.directSimulation<int, int>(ren, -1));
+  set<int> cl;
+  ren.computeRankSim(cl);
+
+  BuchiAutomaton<int, int> fvs = complement(ren, true, fvsVersion);
+  BuchiAutomaton<int, int> ref = complement(ren, true, newVersion);
+
+  // lassos with a prefix of length at most 2 and a loop of length at most 3
+  bool res = true;
+  unsigned words = 0;
+  set<int> alph = ren.getAlphabet();
+  for(unsigned i = 0; i <= 2; i++)
+  {
+    for(const auto& prefix : allWords(alph, i))
+    {
+      for(unsigned j = 1; j <= 3; j++)
+      {
+        for(const auto& loop : allWords(alph, j))
+        {
+          bool orig = acceptsLasso(ren, prefix, loop);
+          bool inCompl = acceptsLasso(fvs, prefix, loop);
+          if(orig == inCompl || inCompl != acceptsLasso(ref, prefix, loop))
+            res = false;
+          words++;
+        }
+      }
+    }
+  }
+
+  cout << "States: " << fvs.getStates().size() << " (new: " << ref.getStates().size() << ")" << endl;
+  cout << std::boolalpha;
+  cout << "Check (" << words << " words): " << res << endl;
+  return res ? 0 : 1;
+}
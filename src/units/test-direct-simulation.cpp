@@ -0,0 +1,148 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <vector>
+#include <tuple>
+#include <fstream>
+#include <random>
+
+#include "../Automata/BuchiAutomaton.h"
+#include "../Algorithms/Simulations.h"
+#include "../Automata/BuchiAutomataParser.h"
+#include "test-utils.h"
+
+using namespace std;
+
+/*
+ * Direct simulation by a naive fixpoint on the automaton completed by the
+ * sink (pairs with the sink are omitted)
+ */
+Relation<int> naiveSimulation(BuchiAutomaton<int, int>& ba, int sink)
+{
+  BuchiAutomaton<int, int> tmp(ba);
+  tmp.complete(sink);
+  set<tuple<int, int, int>> acc;
+  for(const auto& tr : tmp.getFinTrans())
+    acc.insert({tr.from, tr.symbol, tr.to});
+  auto trans = tmp.getTransitions();
+  set<int> fin = tmp.getFinals();
+
+  Relation<int> rel;
+  for(int p : tmp.getStates())
+  {
+    for(int q : tmp.getStates())
+    {
+      if(fin.count(p) == 0 || fin.count(q) > 0)
+        rel.insert({p, q});
+    }
+  }
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(auto it = rel.begin(); it != rel.end(); )
+    {
+      int p = it->first;
+      int q = it->second;
+      bool ok = true;
+      for(int a : tmp.getAlphabet())
+      {
+        for(int pd : trans[{p, a}])
+        {
+          bool pAcc = acc.count({p, a, pd}) > 0;
+          bool found = false;
+          for(int qd : trans[{q, a}])
+          {
+            if(rel.count({pd, qd}) > 0 && (!pAcc || acc.count({q, a, qd}) > 0))
+              found = true;
+          }
+          ok &= found;
+        }
+      }
+      if(!ok)
+      {
+        it = rel.erase(it);
+        changed = true;
+      }
+      else
+        ++it;
+    }
+  }
+
+  Relation<int> ret;
+  for(const auto& pr : rel)
+  {
+    if(pr.first != sink && pr.second != sink)
+      ret.insert(pr);
+  }
+  return ret;
+}
+
+/*
+ * Two copies of a path over a large alphabet (each transition has its own
+ * symbol), the copies simulate each other
+ */
+static bool largeAlphabet()
+{
+  const int len = 1000;
+  const int syms = 1024;
+  set<int> states, fins, ini = {0}, alph;
+  BuchiAutomaton<int, int>::Transitions trans;
+  for(int a = 0; a < syms; a++)
+    alph.insert(a);
+  for(int c = 0; c < 2; c++)
+  {
+    for(int i = 0; i < len; i++)
+    {
+      int st = c*len + i;
+      states.insert(st);
+      if(i + 1 < len)
+        trans[{st, i}] = {st + 1};
+      else
+        trans[{st, 0}] = {st};
+    }
+    fins.insert(c*len + len - 1);
+  }
+  BuchiAutomaton<int, int> ba(states, fins, ini, trans, {}, alph);
+
+  Simulations sim;
+  Relation<int> rel = sim.directSimulation<int, int>(ba, -1);
+  bool copies = true;
+  for(int i = 0; i < len; i++)
+    copies &= rel.count({i, len + i}) > 0 && rel.count({len + i, i}) > 0;
+  bool res = true;
+  res &= check("large alphabet copies", copies);
+  res &= check("large alphabet no other pairs", rel.size() == 4*(size_t)len);
+
+  Relation<int> small = sim.directSimulation<int, int>(ba, -1, 1024);
+  res &= check("over budget identity", small == sim.identity(ba));
+  return res;
+}
+
+int main(int argc, char *argv[])
+{
+  bool res = true;
+  Simulations sim;
+  for(int i = 1; i < argc; i++)
+  {
+    ifstream os(argv[i]);
+    if(!os)
+    {
+      cerr << "Opening file error" << endl;
+      return 1;
+    }
+    BuchiAutomataParser parser(os);
+    BuchiAutomaton<string, string> ba = parser.parseBaFormat();
+    BuchiAutomaton<int, int> ren = ba.renameAut();
+    res &= check(argv[i], sim.directSimulation<int, int>(ren, -1) == naiveSimulation(ren, -1));
+  }
+
+  bool ok = checkRandom(200, [&sim](std::mt19937& gen, unsigned i)
+  {
+    auto ba = randomAut<BuchiAutomaton<int, int>>(gen, 1 + i % 8, 1 + i % 3, {0.3, 0.3, 0.2});
+    return sim.directSimulation<int, int>(ba, -1) == naiveSimulation(ba, -1);
+  });
+  res &= check("random automata", ok);
+  res &= largeAlphabet();
+  return res ? 0 : 1;
+}
@@ -0,0 +1,270 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <vector>
+#include <tuple>
+#include <fstream>
+#include <memory>
+#include <random>
+
+#include "../Automata/BuchiAutomaton.h"
+#include "../Algorithms/Simulations.h"
+#include "../Complement/BuchiAutomatonSpec.h"
+#include "../Complement/SemiDeterministicCompl.h"
+#include "../Complement/CoBuchiCompl.h"
+#include "../Complement/AutomatonAnalysis.h"
+#include "../Automata/BuchiAutomataParser.h"
+#include "../Complement/Options.h"
+#include "lasso-words.h"
+#include "test-utils.h"
+
+using namespace std;
+
+// print results of all checks (otherwise only failures are printed)
+static bool print = true;
+
+/*
+ * Explore the whole lazy complement (from its initial state)
+ * @return Explored automaton; successors are queried twice to check that
+ *         they are memoized
+ */
+template <typename State>
+BuchiAutomaton<State, int> explore(LazyComplement<State>& lazy, bool& memo)
+{
+  typedef typename LazyComplement<State>::StateId StateId;
+  set<State> states, finals;
+  set<State> initials = {lazy.getState(lazy.initial())};
+  typename BuchiAutomaton<State, int>::Transitions trans;
+
+  set<StateId> visited = {lazy.initial()};
+  vector<StateId> stack = {lazy.initial()};
+  memo = true;
+  while(!stack.empty())
+  {
+    StateId id = stack.back();
+    stack.pop_back();
+    State st = lazy.getState(id);
+    states.insert(st);
+    if(lazy.isAccepting(id))
+      finals.insert(st);
+    for(int sym : lazy.getAlphabet())
+    {
+      vector<StateId> dst = lazy.successors(id, sym);
+      size_t size = lazy.size();
+      memo &= (lazy.successors(id, sym) == dst && lazy.size() == size);
+      for(StateId d : dst)
+      {
+        trans[{st, sym}].insert(lazy.getState(d));
+        if(visited.insert(d).second)
+          stack.push_back(d);
+      }
+    }
+  }
+  memo &= (lazy.size() == states.size());
+  return BuchiAutomaton<State, int>(states, finals, initials, trans, lazy.getAlphabet());
+}
+
+/*
+ * Automaton without useless states renamed to integers
+ */
+template <typename State>
+BuchiAutomaton<int, int> useful(BuchiAutomaton<State, int>& aut)
+{
+  map<int, int> id;
+  for(int al : aut.getAlphabet())
+    id[al] = al;
+  return aut.removeUselessRename(id);
+}
+
+static set<tuple<int, int, int>> transSet(BuchiAutomaton<int, int>& aut)
+{
+  set<tuple<int, int, int>> ret;
+  for(const auto& tr : aut.getTransitions())
+  {
+    for(int d : tr.second)
+      ret.insert({tr.first.first, tr.first.second, d});
+  }
+  return ret;
+}
+
+/*
+ * The explored lazy complement is the eager complement after useless states
+ * are removed, and it accepts exactly the lassos rejected by the original
+ * automaton (if checkLang is set)
+ */
+template <typename State>
+bool compare(const string& name, BuchiAutomaton<State, int>& eager,
+  LazyComplement<State>& lazy, BuchiAutomaton<int, int>& orig, bool checkLang = true)
+{
+  bool memo;
+  BuchiAutomaton<State, int> expl = explore(lazy, memo);
+  BuchiAutomaton<int, int> e = useful(eager);
+  BuchiAutomaton<int, int> l = useful(expl);
+
+  bool same = e.getStates() == l.getStates() && e.getInitials() == l.getInitials() &&
+    e.getFinals() == l.getFinals() && transSet(e) == transSet(l);
+  bool lang = true;
+  set<int> alph = orig.getAlphabet();
+  for(unsigned i = 0; i <= 2 && checkLang; i++)
+  {
+    for(const auto& prefix : allWords(alph, i))
+    {
+      for(unsigned j = 1; j <= 3; j++)
+      {
+        for(const auto& loop : allWords(alph, j))
+          lang &= acceptsLasso(l, prefix, loop) != acceptsLasso(orig, prefix, loop);
+      }
+    }
+  }
+  bool res = memo && same && lang;
+  if(print || !res)
+  {
+    cout << name << ": " << (res ? "ok" : "FAILED") << " (" << lazy.size() << " explored, "
+      << l.getStates().size() << " useful";
+    cout << (memo ? "" : ", not memoized") << (same ? "" : ", differs from eager")
+      << (lang ? "" : ", wrong language") << ")" << endl;
+  }
+  return res;
+}
+
+/*
+ * Schewe construction (with and without the delay optimization); the lazy
+ * and the eager construction share the prepared automaton
+ */
+static bool checkSch(const string& name, BuchiAutomaton<int, int>& ren, bool delay)
+{
+  ComplOptions opt;
+  opt.cutPoint = true;
+  opt.ROMinState = 8;
+  opt.ROMinRank = 6;
+  if(delay)
+  {
+    opt.delay = true;
+    opt.delayVersion = newVersion;
+  }
+
+  BuchiAutomaton<int, int> aut(ren);
+  Simulations sim;
+  aut.setDirectSim(sim.directSimulation<int, int>(aut, -1));
+  set<int> cl;
+  aut.computeRankSim(cl);
+
+  BuchiAutomatonSpec sp(&aut);
+  sp.setComplOptions(opt);
+  Stat stats;
+  std::shared_ptr<const SchPrepared> prep = sp.prepareSchReduced(&stats);
+  BuchiAutomaton<StateSch, int> eager = sp.complementSchReduced(*prep, &stats);
+  LazyComplement<StateSch> lazy = sp.lazyComplementSchReduced(prep);
+  return compare(name + (delay ? " schewe delay" : " schewe"), eager, lazy, ren);
+}
+
+/*
+ * NCSB construction (MaxRank and Lazy); the lazy variant transforms the
+ * automaton, hence each construction has its own copy. NCSB-Lazy keeps
+ * nonaccepting states of B in B', so it is exact only if the initial
+ * states are in the nondeterministic part (the language is not checked
+ * otherwise).
+ */
+static bool checkSD(const string& name, BuchiAutomaton<int, int>& ren, bool ncsbLazy)
+{
+  ComplOptions opt;
+  opt.ncsbLazy = ncsbLazy;
+  auto analysis = std::make_shared<AutomatonAnalysis>(ren);
+  SemiDeterministicCompl sdEager(&ren, analysis);
+  SemiDeterministicCompl sdLazy(&ren, analysis);
+  bool checkLang = true;
+  for(int st : ren.getInitials())
+    checkLang &= !ncsbLazy || sdEager.getDet().count(st) == 0;
+  BuchiAutomaton<StateSD, int> eager = sdEager.complementSD(opt);
+  LazyComplement<StateSD> lazy = sdLazy.lazyComplementSD(opt);
+  return compare(name + (ncsbLazy ? " ncsb lazy" : " ncsb maxrank"), eager, lazy, ren, checkLang);
+}
+
+/*
+ * Co-Buchi construction (without simulation, with pruning and saturation)
+ */
+static bool checkCoBA(const string& name, BuchiAutomaton<int, int>& ren)
+{
+  auto analysis = std::make_shared<AutomatonAnalysis>(ren);
+  BuchiAutomaton<int, int> weak(ren);
+  CoBuchiAutomatonCompl iw(weak, analysis);
+  bool res = true;
+
+  BuchiAutomaton<StateGcoBA, int> eager = iw.complementCoBA();
+  LazyComplement<StateGcoBA> lazy = iw.lazyComplementCoBA();
+  res &= compare(name + " cobuchi", eager, lazy, ren);
+
+  for(bool prune : {true, false})
+  {
+    ComplOptions opt;
+    opt.iwSim = prune;
+    opt.iwSat = !prune;
+    BuchiAutomaton<StateGcoBA, int> eagerSim = iw.complementCoBASim(opt);
+    LazyComplement<StateGcoBA> lazySim = iw.lazyComplementCoBASim(opt);
+    res &= compare(name + (prune ? " cobuchi prune" : " cobuchi saturate"), eagerSim, lazySim, ren);
+  }
+  return res;
+}
+
+static unsigned sdCount = 0;
+static unsigned iwCount = 0;
+
+/*
+ * All lazy constructions applicable to the automaton
+ */
+static bool checkAut(const string& name, BuchiAutomaton<int, int>& ren)
+{
+  bool res = true;
+  res &= checkSch(name, ren, false);
+  res &= checkSch(name, ren, true);
+
+  AutomatonAnalysis analysis(ren);
+  if(analysis.isSemiDeterministic())
+  {
+    sdCount++;
+    res &= checkSD(name, ren, false);
+    res &= checkSD(name, ren, true);
+  }
+  if(analysis.isInherentlyWeakBA())
+  {
+    iwCount++;
+    res &= checkCoBA(name, ren);
+  }
+  return res;
+}
+
+int main(int argc, char *argv[])
+{
+  bool res = true;
+  for(int i = 1; i < argc; i++)
+  {
+    ifstream os(argv[i]);
+    if(!os)
+    {
+      cerr << "Opening file error" << endl;
+      return 1;
+    }
+    BuchiAutomataParser parser(os);
+    BuchiAutomaton<string, string> ba = parser.parseBaFormat();
+    BuchiAutomaton<int, int> ren = ba.renameAut();
+    res &= checkAut(argv[i], ren);
+  }
+
+  print = false;
+  sdCount = iwCount = 0;
+  // random semi-deterministic automata
+  bool ok = checkRandom(200, [](std::mt19937& gen, unsigned i)
+  {
+    unsigned n = 2 + i % 5;
+    auto ba = randomAut<BuchiAutomaton<int, int>>(gen, n, 2, {0.5, 0.5, 0.0, 1 + i % (n - 1)});
+    // the constructions expect automata without useless states (as in ranker)
+    BuchiAutomaton<int, int> red = ba.removeUselessRename();
+    if(red.getStates().empty())
+      return true;
+    return checkAut("random " + to_string(i), red);
+  });
+  cout << "random automata (" << sdCount << " semi-deterministic, " << iwCount
+    << " inherently weak): " << (ok ? "ok" : "FAILED") << endl;
+  res &= ok;
+  return res ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "../Algorithms/LogCombinatorics.h"
+#include "../Complement/BuchiDelay.h"
+#include "test-utils.h"
+
+using namespace std;
+
+/*
+ * Are the logarithm and the exact value equal (up to a relative error)
+ */
+static bool logEquals(double lg, double exact)
+{
+  if(exact < 0.5)
+    return std::isinf(lg) && lg < 0;
+  return std::abs(lg - std::log(exact)) < 1e-9;
+}
+
+/*
+ * Stirling numbers of the second kind and surjections against exact counts
+ * in integers
+ */
+static bool exactCounts()
+{
+  const unsigned maxN = 20;
+  // S(n,k) by the recurrence in integers
+  vector<vector<unsigned long long>> stir(maxN + 1, vector<unsigned long long>(maxN + 1, 0));
+  stir[0][0] = 1;
+  for(unsigned n = 1; n <= maxN; n++)
+  {
+    for(unsigned k = 1; k <= n; k++)
+      stir[n][k] = k*stir[n-1][k] + stir[n-1][k-1];
+  }
+
+  LogCombinatorics comb;
+  bool stirOk = true;
+  bool surjOk = true;
+  for(unsigned n = 0; n <= maxN; n++)
+  {
+    unsigned long long fact = 1;
+    for(unsigned k = 0; k <= n + 1; k++)
+    {
+      if(k > 0)
+        fact *= k;
+      double exact = (k <= n) ? (double)stir[n][k] : 0.0;
+      stirOk &= logEquals(comb.stirling2(n, k), exact);
+      // k!*S(n,k) is exact in doubles for small n only
+      if(n <= 12)
+        surjOk &= logEquals(comb.surjections(n, k), (double)fact * exact);
+    }
+  }
+  bool res = true;
+  res &= check("stirling2", stirOk);
+  res &= check("surjections", surjOk);
+  res &= check("stirling2 large", std::isfinite(comb.stirling2(2000, 1000)) && comb.stirling2(2000, 1000) > 0);
+  return res;
+}
+
+/*
+ * The logarithmic count of rankings against the version with Stirling
+ * numbers in unsigned integers
+ */
+static bool rankingCounts()
+{
+  BuchiAutomaton<StateSch, int> empty;
+  BuchiAutomatonDelay<int> delay(empty);
+  LogCombinatorics comb;
+
+  bool res = true;
+  // the unsigned count sums partial results of the inclusion-exclusion, it
+  // is exact only if they do not go below zero (at most 3 odd ranks and at
+  // least as many nonaccepting states)
+  for(unsigned maxRank = 1; maxRank <= 5; maxRank += 2)
+  {
+    for(unsigned nonAcc = (maxRank + 1)/2; nonAcc <= 8; nonAcc++)
+    {
+      for(unsigned acc = 0; acc <= 3; acc++)
+      {
+        unsigned cnt = delay.getAllPossibleRankings(maxRank, acc, nonAcc, stirlingVersion);
+        res &= logEquals(delay.getLogRankings(maxRank, acc, nonAcc, comb), cnt);
+      }
+    }
+  }
+  return check("rankings", res);
+}
+
+int main()
+{
+  bool res = true;
+  res &= exactCounts();
+  res &= rankingCounts();
+  return res ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <set>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <ctime>
+#include <stdexcept>
+
+#include "../Algorithms/ParallelExplorer.h"
+#include "test-utils.h"
+
+using namespace std;
+
+/*
+ * Explore vertices 0..n-1 of a graph with edges i -> 2i+1, 2i+2 and
+ * i -> i/2 (hence with cycles) from a single vertex; the visited set is kept
+ * by the processing function
+ * @return Number of times each vertex was processed
+ */
+static vector<unsigned> explore(unsigned threads, unsigned n, vector<unsigned>& perWorker)
+{
+  vector<unsigned> processed(n, 0);
+  vector<bool> visited(n, false);
+  std::mutex lock;
+  visited[0] = true;
+
+  ParallelExplorer<unsigned> ex(threads);
+  perWorker.assign(ex.getThreadCount(), 0);
+  ex.push(0);
+  ex.run([&](unsigned id, const unsigned& v, vector<unsigned>& buffer)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    processed[v]++;
+    perWorker[id]++;
+    for(unsigned d : {2*v + 1, 2*v + 2, v/2})
+    {
+      if(d < n && !visited[d])
+      {
+        visited[d] = true;
+        buffer.push_back(d);
+      }
+    }
+  });
+  return processed;
+}
+
+/*
+ * Each vertex is processed exactly once and the exploration terminates
+ */
+static bool allOnce(unsigned threads)
+{
+  const unsigned n = 200000;
+  vector<unsigned> perWorker;
+  vector<unsigned> processed = explore(threads, n, perWorker);
+  bool once = true;
+  for(unsigned c : processed)
+    once &= (c == 1);
+
+  unsigned working = 0;
+  for(unsigned c : perWorker)
+    working += (c > 0) ? 1 : 0;
+  cout << "workers with items (" << threads << " threads): " << working << endl;
+  return check("each vertex once (" + to_string(threads) + " threads)", once);
+}
+
+/*
+ * An exception of the processing function stops all workers and is
+ * rethrown by run
+ */
+static bool exceptions()
+{
+  ParallelExplorer<unsigned> ex(4);
+  std::atomic<unsigned> count(0);
+  ex.push(0);
+  bool thrown = false;
+  try
+  {
+    ex.run([&](unsigned, const unsigned& v, vector<unsigned>& buffer)
+    {
+      count++;
+      if(v == 1000)
+        throw std::runtime_error("stop");
+      buffer.push_back(v + 1);
+    });
+  }
+  catch(const std::runtime_error&)
+  {
+    thrown = true;
+  }
+  return check("exception rethrown", thrown && count == 1001);
+}
+
+/*
+ * Workers without items wait instead of spinning: a chain of slow items
+ * (only one item is available at a time) takes almost no processor time
+ */
+static bool idleWait()
+{
+  ParallelExplorer<unsigned> ex(4);
+  ex.push(0);
+  std::clock_t start = std::clock();
+  ex.run([&](unsigned, const unsigned& v, vector<unsigned>& buffer)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if(v < 40)
+      buffer.push_back(v + 1);
+  });
+  // the chain takes more than 200 ms of wall time
+  double cpu = 1000.0 * (std::clock() - start) / CLOCKS_PER_SEC;
+  return check("idle workers wait", cpu < 100.0);
+}
+
+/*
+ * Exploration without any item terminates immediately
+ */
+static bool empty()
+{
+  ParallelExplorer<unsigned> ex(4);
+  unsigned count = 0;
+  ex.run([&](unsigned, const unsigned&, vector<unsigned>&) { count++; });
+  return check("no items", count == 0);
+}
+
+int main()
+{
+  bool res = true;
+  res &= allOnce(1);
+  res &= allOnce(4);
+  res &= exceptions();
+  res &= idleWait();
+  res &= empty();
+  return res ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include <thread>
+#include <cstdint>
+#include <iostream>
+
+#include "../Complement/ComplPortfolio.h"
+#include "test-utils.h"
+
+using namespace std;
+
+/*
+ * Engine reporting the numbers 1,...,generated and returning the given
+ * trimmed size
+ */
+static size_t generate(size_t generated, size_t size)
+{
+  for(size_t i = 1; i <= generated; i++)
+    ComplProgress::report(i);
+  return size;
+}
+
+/*
+ * Wait until another candidate has finished and set the limit of the
+ * current one
+ */
+static void waitForLimit()
+{
+  while(ComplProgress::getActive()->getLimit() == SIZE_MAX)
+    this_thread::yield();
+}
+
+/*
+ * The first candidate generates 100 states and keeps all of them. The
+ * second one generates more states (80 + 70) but it drops 60 dead states
+ * in between, so it never reports more than the first one did; it is not
+ * cancelled and wins after trimming.
+ */
+static bool winsAfterTrimming()
+{
+  ComplPortfolio portfolio;
+  unsigned first = portfolio.add([]() { return generate(100, 50); });
+  unsigned second = portfolio.add([]() {
+    waitForLimit();
+    generate(80, 0);
+    ComplProgress::report(20);
+    for(size_t i = 21; i <= 90; i++)
+      ComplProgress::report(i);
+    return (size_t)10;
+  });
+  portfolio.run();
+
+  bool res = true;
+  res &= check("first candidate finished", portfolio.isFinished(first));
+  res &= check("candidate under the limit not cancelled", portfolio.isFinished(second));
+  res &= check("smaller trimmed result", portfolio.getSize(second) == 10);
+  return res;
+}
+
+/*
+ * The limit is the number reported at the end of the best finished
+ * candidate (not the maximum, its states might have been dropped)
+ */
+static bool finalLimit()
+{
+  ComplPortfolio portfolio;
+  unsigned first = portfolio.add([]() {
+    generate(100, 0);
+    ComplProgress::report(60);
+    return (size_t)50;
+  });
+  unsigned second = portfolio.add([]() {
+    waitForLimit();
+    return generate(60, 40);
+  });
+  unsigned third = portfolio.add([]() {
+    waitForLimit();
+    return generate(61, 30);
+  });
+  portfolio.run();
+
+  bool res = true;
+  res &= check("first candidate finished", portfolio.isFinished(first));
+  res &= check("candidate within the limit not cancelled", portfolio.isFinished(second));
+  res &= check("candidate over the limit cancelled", !portfolio.isFinished(third));
+  return res;
+}
+
+int main()
+{
+  bool res = true;
+  res &= winsAfterTrimming();
+  res &= finalLimit();
+  return res ? 0 : 1;
+}
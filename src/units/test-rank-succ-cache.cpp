@@ -0,0 +1,107 @@
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "../Complement/RankSuccCache.h"
+#include "test-utils.h"
+
+using namespace std;
+
+static RankFunc func(const map<int, int>& mp)
+{
+  return RankFunc(mp);
+}
+
+/*
+ * Size of a single entry (all entries below have the same shape)
+ */
+static size_t entrySize()
+{
+  RankSuccCache cache(1 << 20);
+  cache.insert({0, 1}, 0, func({{0, 3}, {1, 2}}), {func({{0, 1}, {1, 0}})});
+  return cache.getMemory();
+}
+
+/*
+ * A budget for two entries: inserting the third one evicts the least
+ * recently used entry
+ */
+static bool lruEviction()
+{
+  bool res = true;
+  size_t size = entrySize();
+  RankSuccCache cache(2*size + size/2);
+  RankFunc f = func({{0, 3}, {1, 2}});
+  vector<RankFunc> succ = {func({{0, 1}, {1, 0}})};
+  vector<RankFunc> out;
+
+  cache.insert({0, 1}, 0, f, succ);
+  cache.insert({0, 1}, 1, f, succ);
+  res &= check("two entries fit", cache.size() == 2 && cache.getMemory() == 2*size);
+  // the entry of symbol 0 becomes the most recently used
+  res &= check("lookup of the older entry", cache.lookup(out, {0, 1}, 0, f) && out == succ);
+  cache.insert({0, 1}, 2, f, succ);
+  res &= check("third entry evicts one", cache.size() == 2 && cache.getEvictions() == 1);
+  res &= check("least recently used evicted", !cache.lookup(out, {0, 1}, 1, f));
+  res &= check("recently used kept", cache.lookup(out, {0, 1}, 0, f));
+  res &= check("new entry kept", cache.lookup(out, {0, 1}, 2, f));
+  res &= check("memory within budget", cache.getMemory() <= 2*size + size/2);
+  return res;
+}
+
+/*
+ * Successors of f are reused for functions pointwise smaller than f (with
+ * the same macrostate, symbol, and max rank)
+ */
+static bool dominance()
+{
+  bool res = true;
+  RankSuccCache cache(1 << 20);
+  vector<RankFunc> succ = {func({{0, 1}, {1, 0}}), func({{0, 1}, {1, 1}})};
+  vector<RankFunc> out;
+
+  cache.insert({0, 1}, 0, func({{0, 3}, {1, 2}}), succ);
+  res &= check("smaller function hits", cache.lookup(out, {0, 1}, 0, func({{0, 3}, {1, 0}})) && out == succ);
+  res &= check("greater function misses", !cache.lookup(out, {0, 1}, 0, func({{0, 3}, {1, 3}})));
+  res &= check("other max rank misses", !cache.lookup(out, {0, 1}, 0, func({{0, 1}, {1, 0}})));
+  res &= check("other macrostate misses", !cache.lookup(out, {0, 2}, 0, func({{0, 3}, {2, 2}})));
+  res &= check("other symbol misses", !cache.lookup(out, {0, 1}, 1, func({{0, 3}, {1, 2}})));
+  res &= check("hit/miss counters", cache.getHits() == 1 && cache.getMisses() == 4);
+  res &= check("no evictions", cache.getEvictions() == 0);
+  return res;
+}
+
+/*
+ * Entries larger than the budget are not stored, a smaller budget evicts
+ * entries
+ */
+static bool budget()
+{
+  bool res = true;
+  size_t size = entrySize();
+  RankFunc f = func({{0, 3}, {1, 2}});
+  vector<RankFunc> succ = {func({{0, 1}, {1, 0}})};
+  vector<RankFunc> out;
+
+  RankSuccCache tiny(size - 1);
+  tiny.insert({0, 1}, 0, f, succ);
+  res &= check("entry over budget not stored", tiny.size() == 0 && tiny.getMemory() == 0);
+  res &= check("miss counted", !tiny.lookup(out, {0, 1}, 0, f) && tiny.getMisses() == 1);
+
+  RankSuccCache cache(4*size);
+  for(int a = 0; a < 4; a++)
+    cache.insert({0, 1}, a, f, succ);
+  cache.setBudget(size);
+  res &= check("smaller budget evicts", cache.size() == 1 && cache.getEvictions() == 3);
+  res &= check("most recent entry kept", cache.lookup(out, {0, 1}, 3, f) && cache.getHits() == 1);
+  return res;
+}
+
+int main()
+{
+  bool res = true;
+  res &= lruEviction();
+  res &= dominance();
+  res &= budget();
+  return res ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <vector>
+
+#include "../Algorithms/SccExplorer.h"
+#include "test-utils.h"
+
+using namespace std;
+
+/*
+ * Graph given by an adjacency list with a set of accepting vertices; counts
+ * requests of successors and collects reported dead SCCs
+ */
+struct TestGraph
+{
+  map<int, vector<int>> succ;
+  set<int> acc;
+  map<int, int> requests;
+  set<set<int>> deadSccs;
+
+  TestGraph() : succ(), acc(), requests(), deadSccs() { }
+
+  SccExplorer::SuccFunc succFunc()
+  {
+    return [this](int v) { this->requests[v]++; return this->succ[v]; };
+  }
+
+  SccExplorer::AccFunc accFunc()
+  {
+    return [this](int v) { return this->acc.count(v) > 0; };
+  }
+
+  SccExplorer::DeadFunc deadFunc()
+  {
+    return [this](const vector<int>& comp) { this->deadSccs.insert(set<int>(comp.begin(), comp.end())); };
+  }
+
+  void explore(SccExplorer& ex, int root)
+  {
+    ex.explore(root, succFunc(), accFunc(), deadFunc());
+  }
+
+  bool requestedOnce() const
+  {
+    for(const auto& pr : this->requests)
+    {
+      if(pr.second != 1)
+        return false;
+    }
+    return true;
+  }
+};
+
+/*
+ * Accepting vertices are live only on a cycle (a self-loop is enough)
+ */
+static bool trivialSelfLoops()
+{
+  TestGraph g;
+  // 1 accepting with a self-loop, 2 accepting without a cycle, 3 with a
+  // self-loop but not accepting
+  g.succ = {{0, {1, 2, 3}}, {1, {1}}, {2, {}}, {3, {3}}};
+  g.acc = {1, 2};
+  SccExplorer ex;
+  g.explore(ex, 0);
+
+  bool res = true;
+  res &= check("self-loop accepting live", !ex.isDead(1));
+  res &= check("trivial accepting dead", ex.isDead(2));
+  res &= check("self-loop nonaccepting dead", ex.isDead(3));
+  res &= check("root reaching live", !ex.isDead(0));
+  res &= check("dead sccs reported", g.deadSccs == set<set<int>>({{2}, {3}}));
+  res &= check("successors requested once", g.requestedOnce() && g.requests.size() == 4);
+  return res;
+}
+
+/*
+ * Liveness propagates from SCCs completed earlier in the same exploration
+ */
+static bool liveThroughCompleted()
+{
+  TestGraph g;
+  // 3 is a live SCC completed from 1, then reached again from 2 and from
+  // the nontrivial SCC {4, 5}; 6 -> 7 is a dead chain completed from 1 and
+  // reached again from 8
+  g.succ = {{0, {1, 2, 4, 8}}, {1, {3, 6}}, {2, {3}}, {3, {3}},
+    {4, {5}}, {5, {4, 3}}, {6, {7}}, {7, {}}, {8, {6}}};
+  g.acc = {3};
+  SccExplorer ex;
+  g.explore(ex, 0);
+
+  bool res = true;
+  res &= check("live via completed scc", !ex.isDead(2));
+  res &= check("cycle live via completed scc", !ex.isDead(4) && !ex.isDead(5));
+  res &= check("dead via completed dead scc", ex.isDead(8) && ex.isDead(6) && ex.isDead(7));
+  res &= check("root live", !ex.isDead(0) && !ex.isDead(1));
+  res &= check("dead sccs reported", g.deadSccs == set<set<int>>({{6}, {7}, {8}}));
+  res &= check("successors requested once", g.requestedOnce() && g.requests.size() == 9);
+  return res;
+}
+
+/*
+ * Several roots share the explorer, visited vertices are not explored again
+ */
+static bool sharedRoots()
+{
+  TestGraph g;
+  g.succ = {{0, {1}}, {1, {0, 2}}, {2, {}}, {3, {1}}, {4, {2}}, {5, {5, 0}}};
+  g.acc = {0};
+  SccExplorer ex;
+  g.explore(ex, 0);
+
+  bool res = true;
+  res &= check("first root live", !ex.isDead(0) && !ex.isDead(1));
+  res &= check("first root dead part", ex.isDead(2));
+  res &= check("unvisited not dead", !ex.isVisited(3) && !ex.isDead(3));
+
+  g.explore(ex, 3);
+  g.explore(ex, 4);
+  g.explore(ex, 5);
+  // exploring a visited root does nothing
+  g.explore(ex, 1);
+
+  res &= check("second root live", !ex.isDead(3));
+  res &= check("third root dead", ex.isDead(4));
+  res &= check("self-loop to live", !ex.isDead(5));
+  res &= check("dead sccs reported", g.deadSccs == set<set<int>>({{2}, {4}}));
+  res &= check("successors requested once", g.requestedOnce() && g.requests.size() == 6);
+  return res;
+}
+
+int main()
+{
+  bool res = true;
+  res &= trivialSelfLoops();
+  res &= liveThroughCompleted();
+  res &= sharedRoots();
+  return res ? 0 : 1;
+}
@@ -71,7 +71,7 @@ int main(int argc, char *argv[])
     ba.computeRankSim(cl);
     BuchiAutomaton<int, int> ren = ba.renameAut();
     BuchiAutomatonSpec sp(ren);
-    ComplOptions opt = { .cutPoint = true, .succEmptyCheck = true, .ROMinState = 8, .ROMinRank = 6, .CacheMaxState = 6, .CacheMaxRank = 8 };
+    ComplOptions opt = { .cutPoint = true, .succEmptyCheck = true, .ROMinState = 8, .ROMinRank = 6 };
     sp.setComplOptions(opt);
     BuchiAutomaton<StateSch, int> comp;
     try
@@ -0,0 +1,94 @@
+#ifndef _TEST_UTILS_H_
+#define _TEST_UTILS_H_
+
+#include <set>
+#include <limits>
+#include <random>
+#include <string>
+#include <iostream>
+
+/*
+ * Print the result of a named check
+ * @return The result
+ */
+inline bool check(const std::string& name, bool res)
+{
+  std::cout << name << ": " << (res ? "ok" : "FAILED") << std::endl;
+  return res;
+}
+
+/*
+ * Parameters of random automata. Each transition is present with
+ * probability trans and it is accepting with probability accTrans, each
+ * state is accepting with probability fin. States from detFrom on (if any)
+ * form a deterministic part: there is at most one transition from each of
+ * them over a symbol, it leads to the part, and only states of the part
+ * are accepting.
+ */
+struct RandomAutParams
+{
+  double trans;
+  double fin;
+  double accTrans;
+  unsigned detFrom = std::numeric_limits<unsigned>::max();
+};
+
+/*
+ * Random automaton over states 0,...,n-1 (0 is initial) and symbols
+ * 0,...,syms-1 (Automaton is BuchiAutomaton<int, int>; the header does not
+ * depend on it, hence tests without automata may include it)
+ */
+template <typename Automaton>
+Automaton randomAut(std::mt19937& gen, unsigned n, unsigned syms, const RandomAutParams& par)
+{
+  std::uniform_real_distribution<double> prob(0.0, 1.0);
+  std::set<int> states, fins, ini = {0}, alph;
+  typename Automaton::Transitions trans;
+  typename Automaton::VecTransG accTrans;
+
+  bool detPart = par.detFrom < n;
+  for(unsigned a = 0; a < syms; a++)
+    alph.insert(a);
+  for(unsigned i = 0; i < n; i++)
+  {
+    states.insert(i);
+    if((!detPart || i >= par.detFrom) && prob(gen) < par.fin)
+      fins.insert(i);
+  }
+  for(unsigned i = 0; i < n; i++)
+  {
+    bool det = detPart && i >= par.detFrom;
+    for(unsigned a = 0; a < syms; a++)
+    {
+      for(unsigned j = (det ? par.detFrom : 0); j < n; j++)
+      {
+        if(prob(gen) > par.trans)
+          continue;
+        trans[{(int)i, (int)a}].insert(j);
+        if(par.accTrans > 0 && prob(gen) < par.accTrans)
+          accTrans.push_back({.from = (int)i, .to = (int)j, .symbol = (int)a});
+        if(det)
+          break;
+      }
+    }
+  }
+  return Automaton(states, fins, ini, trans, accTrans, alph);
+}
+
+/*
+ * Run a test on a sequence of random instances generated from a fixed seed
+ * @param count Number of instances
+ * @param test Function test(generator, index of the instance)
+ * @return Did all instances pass
+ */
+template <typename Test>
+bool checkRandom(unsigned count, Test test)
+{
+  std::mt19937 gen(1);
+  bool ok = true;
+  for(unsigned i = 0; i < count; i++)
+    ok &= test(gen, i);
+  return ok;
+}
+
+#endif